@@ -98,6 +98,7 @@ add_library(core
   fboss/agent/ApplyThriftConfig.cpp
   fboss/agent/ArpCache.cpp
   fboss/agent/ArpHandler.cpp
+  fboss/agent/AsyncRouteUpdater.cpp
   fboss/agent/DHCPv4Handler.cpp
   fboss/agent/DHCPv6Handler.cpp
   fboss/agent/HwSwitch.cpp
@@ -122,12 +123,14 @@ add_library(core
   fboss/agent/NeighborUpdater.cpp
   fboss/agent/NeighborUpdaterImpl.cpp
   fboss/agent/PortUpdateHandler.cpp
+  fboss/agent/PrefixWatcher.cpp
   fboss/agent/ResolvedNexthopMonitor.cpp
   fboss/agent/ResolvedNexthopProbe.cpp
   fboss/agent/ResolvedNexthopProbeScheduler.cpp
   fboss/agent/RestartTimeTracker.cpp
   fboss/agent/RouteUpdateLogger.cpp
   fboss/agent/RouteUpdateLoggingPrefixTracker.cpp
+  fboss/agent/RxPacketPipeline.cpp
   fboss/agent/StandaloneRibConversions.cpp
   fboss/agent/StaticL2ForNeighborObserver.cpp
   fboss/agent/StaticL2ForNeighborUpdater.cpp
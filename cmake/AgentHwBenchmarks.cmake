@@ -30,6 +30,7 @@ add_library(hw_stats_collection_speed
 )
 
 target_link_libraries(hw_stats_collection_speed
+  route_distribution_gen
   config_factory
   hw_packet_utils
   ecmp_helper
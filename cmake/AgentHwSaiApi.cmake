@@ -82,6 +82,7 @@ set(SAI_API_DEPS
   function_call_time_reporter
   switch_config_cpp2
   Folly::folly
+  fb303::fb303
 )
 
 add_library(sai_api
@@ -15,6 +15,7 @@ add_library(packet
   fboss/agent/packet/MPLSHdr.cpp
   fboss/agent/packet/NDP.cpp
   fboss/agent/packet/NDPRouterAdvertisement.cpp
+  fboss/agent/packet/PktHeaderView.cpp
   fboss/agent/packet/PktUtil.cpp
   fboss/agent/packet/TCPHeader.cpp
   fboss/agent/packet/UDPHeader.cpp
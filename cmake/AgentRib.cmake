@@ -5,6 +5,7 @@
 
 add_library(standalone_rib
   fboss/agent/rib/ConfigApplier.cpp
+  fboss/agent/rib/NextHopDependencyIndex.cpp
   fboss/agent/rib/Route.cpp
   fboss/agent/rib/RouteNextHop.cpp
   fboss/agent/rib/RouteNextHopEntry.cpp
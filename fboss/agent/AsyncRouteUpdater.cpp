@@ -0,0 +1,218 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/AsyncRouteUpdater.h"
+
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/Utils.h"
+#include "fboss/agent/rib/ForwardingInformationBaseUpdater.h"
+
+#include <folly/logging/xlog.h>
+
+#include <algorithm>
+
+namespace {
+
+constexpr auto kFlushRetryInitialBackoff = std::chrono::milliseconds(100);
+constexpr auto kFlushRetryMaxBackoff = std::chrono::seconds(10);
+
+void asyncFibUpdate(
+    facebook::fboss::RouterID vrf,
+    const facebook::fboss::rib::IPv4NetworkToRouteMap& v4NetworkToRoute,
+    const facebook::fboss::rib::IPv6NetworkToRouteMap& v6NetworkToRoute,
+    const facebook::fboss::rib::ResolutionDelta& delta,
+    void* cookie) {
+  facebook::fboss::rib::ForwardingInformationBaseUpdater fibUpdater(
+      vrf, v4NetworkToRoute, v6NetworkToRoute, delta);
+
+  auto sw = static_cast<facebook::fboss::SwSwitch*>(cookie);
+  sw->updateStateBlocking("coalesced route update", std::move(fibUpdater));
+}
+
+} // namespace
+
+namespace facebook::fboss {
+
+AsyncRouteUpdater::AsyncRouteUpdater(SwSwitch* sw) : sw_(sw) {}
+
+AsyncRouteUpdater::~AsyncRouteUpdater() {
+  stop();
+}
+
+uint64_t AsyncRouteUpdater::update(
+    RouterID routerID,
+    ClientID clientID,
+    AdminDistance adminDistanceFromClientID,
+    const std::vector<UnicastRoute>& toAdd,
+    const std::vector<IpPrefix>& toDelete,
+    bool resetClientsRoutes,
+    folly::StringPiece updateType,
+    rib::RoutingInformationBase::UpdateStatistics* stats) {
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (stopped_) {
+      throw FbossError("route updates are no longer accepted");
+    }
+  }
+
+  auto updateStats = sw_->getRib()->updateRibOnly(
+      routerID,
+      clientID,
+      adminDistanceFromClientID,
+      toAdd,
+      toDelete,
+      resetClientsRoutes,
+      updateType);
+  if (stats) {
+    *stats = updateStats;
+  }
+
+  // The generation is only assigned once the RIB holds the update, so any
+  // flush that sees this generation also sees the update.
+  std::lock_guard<std::mutex> guard(lock_);
+  if (!flushThread_ && !stopped_) {
+    flushThread_ =
+        std::make_unique<std::thread>([this]() { flushThreadLoop(); });
+  }
+  auto generation = ++lastGeneration_;
+  // A VRF already waiting to be flushed keeps its older first generation
+  vrfsToFlush_.emplace(routerID, PendingVrf{generation});
+  flushCv_.notify_one();
+  return generation;
+}
+
+uint64_t AsyncRouteUpdater::getProgrammedGeneration() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return programmedGeneration_;
+}
+
+bool AsyncRouteUpdater::waitForGeneration(
+    uint64_t generation,
+    std::chrono::milliseconds timeout) {
+  std::unique_lock<std::mutex> guard(lock_);
+  return programmedCv_.wait_for(guard, timeout, [this, generation]() {
+    return programmedGeneration_ >= generation;
+  });
+}
+
+void AsyncRouteUpdater::stop() {
+  std::unique_ptr<std::thread> flushThread;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (stopped_) {
+      return;
+    }
+    stopped_ = true;
+    flushThread = std::move(flushThread_);
+    flushCv_.notify_one();
+  }
+  if (flushThread) {
+    flushThread->join();
+  }
+
+  std::lock_guard<std::mutex> guard(lock_);
+  for (const auto& vrfAndPending : vrfsToFlush_) {
+    XLOG(WARN) << "Dropping unprogrammed route updates for VRF "
+               << vrfAndPending.first << " from generation "
+               << vrfAndPending.second.firstGeneration
+               << ", they stay pending in the RIB";
+  }
+}
+
+void AsyncRouteUpdater::flushThreadLoop() {
+  initThread("fbossRouteFlush");
+  while (true) {
+    std::map<RouterID, PendingVrf> vrfs;
+    uint64_t generation;
+    {
+      std::unique_lock<std::mutex> guard(lock_);
+      while (true) {
+        if (stopped_) {
+          return;
+        }
+        // Take every VRF which is not backing off from a failed flush
+        auto now = std::chrono::steady_clock::now();
+        auto nextRetry = std::chrono::steady_clock::time_point::max();
+        for (auto it = vrfsToFlush_.begin(); it != vrfsToFlush_.end();) {
+          if (it->second.retryAt <= now) {
+            vrfs.insert(*it);
+            it = vrfsToFlush_.erase(it);
+          } else {
+            nextRetry = std::min(nextRetry, it->second.retryAt);
+            ++it;
+          }
+        }
+        if (!vrfs.empty()) {
+          break;
+        }
+        if (nextRetry == std::chrono::steady_clock::time_point::max()) {
+          flushCv_.wait(guard);
+        } else {
+          flushCv_.wait_until(guard, nextRetry);
+        }
+      }
+      generation = lastGeneration_;
+    }
+
+    // Updates arriving from here on wait for the next pass, and are then
+    // flushed together
+    for (const auto& vrfAndPending : vrfs) {
+      auto vrf = vrfAndPending.first;
+      try {
+        sw_->getRib()->syncFib(vrf, &asyncFibUpdate, static_cast<void*>(sw_));
+      } catch (const std::exception& ex) {
+        // The RIB keeps the delta pending, so the retry programs it along
+        // with any update to this VRF arriving in the meantime
+        XLOG(ERR) << "Failed to program route updates for VRF " << vrf
+                  << ": " << folly::exceptionStr(ex);
+        markFlushFailed(vrf, vrfAndPending.second);
+      }
+    }
+
+    std::lock_guard<std::mutex> guard(lock_);
+    auto programmed = programmableGenerationLocked(generation);
+    if (programmed > programmedGeneration_) {
+      programmedGeneration_ = programmed;
+      programmedCv_.notify_all();
+    }
+  }
+}
+
+void AsyncRouteUpdater::markFlushFailed(RouterID vrf, PendingVrf pending) {
+  ++pending.failures;
+  auto backoff = kFlushRetryInitialBackoff;
+  for (uint32_t i = 1; i < pending.failures && backoff < kFlushRetryMaxBackoff;
+       ++i) {
+    backoff *= 2;
+  }
+  backoff = std::min<std::chrono::milliseconds>(backoff, kFlushRetryMaxBackoff);
+  pending.retryAt = std::chrono::steady_clock::now() + backoff;
+
+  // Any update queued for this VRF since is newer, so the failed pass keeps
+  // the first generation
+  std::lock_guard<std::mutex> guard(lock_);
+  vrfsToFlush_[vrf] = pending;
+}
+
+uint64_t AsyncRouteUpdater::programmableGenerationLocked(
+    uint64_t generation) const {
+  // Generations from the first unprogrammed update of a VRF on are not
+  // programmed yet
+  auto programmed = generation;
+  for (const auto& vrfAndPending : vrfsToFlush_) {
+    auto firstGeneration = vrfAndPending.second.firstGeneration;
+    if (firstGeneration <= generation) {
+      programmed = std::min(programmed, firstGeneration - 1);
+    }
+  }
+  return programmed;
+}
+
+} // namespace facebook::fboss
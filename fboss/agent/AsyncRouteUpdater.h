@@ -0,0 +1,114 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/if/gen-cpp2/ctrl_types.h"
+#include "fboss/agent/rib/RoutingInformationBase.h"
+#include "fboss/agent/types.h"
+
+#include <folly/Range.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace facebook::fboss {
+
+class SwSwitch;
+
+/*
+ * AsyncRouteUpdater applies route updates to the standalone RIB without
+ * waiting for them to be programmed.
+ *
+ * update() returns as soon as the RIB is updated. The changed prefixes are
+ * left pending in the RIB, and a flush thread pushes them to the FIB and
+ * hardware. All updates which arrive while the flush thread is programming
+ * the previous ones are coalesced into a single FIB update per VRF.
+ *
+ * Each update is assigned a generation number, in increasing order. Once
+ * getProgrammedGeneration() reaches it, the update and all updates before it
+ * are programmed. If programming a VRF fails, the VRF is retried with an
+ * exponential backoff, and the programmed generation stays below its first
+ * unprogrammed update until the retry succeeds.
+ */
+class AsyncRouteUpdater {
+ public:
+  explicit AsyncRouteUpdater(SwSwitch* sw);
+  ~AsyncRouteUpdater();
+
+  /*
+   * Updates the RIB, with the same arguments as
+   * RoutingInformationBase::update(), and returns the generation of the
+   * update.
+   */
+  uint64_t update(
+      RouterID routerID,
+      ClientID clientID,
+      AdminDistance adminDistanceFromClientID,
+      const std::vector<UnicastRoute>& toAdd,
+      const std::vector<IpPrefix>& toDelete,
+      bool resetClientsRoutes,
+      folly::StringPiece updateType,
+      rib::RoutingInformationBase::UpdateStatistics* stats = nullptr);
+
+  uint64_t getProgrammedGeneration() const;
+
+  /*
+   * Waits for the update of the given generation to be programmed. Returns
+   * false if that did not happen within timeout.
+   */
+  bool waitForGeneration(
+      uint64_t generation,
+      std::chrono::milliseconds timeout);
+
+  /*
+   * Stops the flush thread. Updates not programmed by then stay pending in
+   * the RIB, and the VRFs holding them are logged. Further calls to update()
+   * throw.
+   */
+  void stop();
+
+ private:
+  // Forbidden copy constructor and assignment operator
+  AsyncRouteUpdater(AsyncRouteUpdater const&) = delete;
+  AsyncRouteUpdater& operator=(AsyncRouteUpdater const&) = delete;
+
+  struct PendingVrf {
+    // Generation of the oldest update to this VRF which is not programmed
+    uint64_t firstGeneration{0};
+    // Failed attempts to program this VRF in a row
+    uint32_t failures{0};
+    std::chrono::steady_clock::time_point retryAt;
+  };
+
+  void flushThreadLoop();
+  void markFlushFailed(RouterID vrf, PendingVrf pending);
+  uint64_t programmableGenerationLocked(uint64_t generation) const;
+
+  SwSwitch* sw_;
+
+  mutable std::mutex lock_;
+  // Signalled when VRFs need flushing, or on stop()
+  std::condition_variable flushCv_;
+  // Signalled when programmedGeneration_ advances
+  std::condition_variable programmedCv_;
+  std::map<RouterID, PendingVrf> vrfsToFlush_;
+  uint64_t lastGeneration_{0};
+  uint64_t programmedGeneration_{0};
+  bool stopped_{false};
+  // Started on the first update
+  std::unique_ptr<std::thread> flushThread_;
+};
+
+} // namespace facebook::fboss
@@ -135,10 +135,11 @@ void IPv4Handler::handlePacket(
              << " --> " << v4Hdr.dstAddr.str() << " proto: 0x" << std::hex
              << static_cast<int>(v4Hdr.protocol);
 
-  // Additional data (such as FCS) may be appended after the IP payload
-  auto payload =
-      folly::IOBuf::wrapBuffer(cursor.data(), v4Hdr.length - v4Hdr.size());
-  cursor.reset(payload.get());
+  // Additional data (such as FCS) may be appended after the IP payload.
+  // Wrap the payload in an IOBuf on the stack, to not allocate per packet.
+  folly::IOBuf payload(
+      folly::IOBuf::WRAP_BUFFER, cursor.data(), v4Hdr.length - v4Hdr.size());
+  cursor.reset(&payload);
 
   // retrieve the current switch state
   auto state = sw_->getState();
@@ -141,9 +141,11 @@ void IPv6Handler::handlePacket(
              << " dst: " << ipv6.dstAddr.str() << " (" << dst << ")"
              << " nextHeader: " << static_cast<int>(ipv6.nextHeader);
 
-  // Additional data (such as FCS) may be appended after the IP payload
-  auto payload = folly::IOBuf::wrapBuffer(cursor.data(), ipv6.payloadLength);
-  cursor.reset(payload.get());
+  // Additional data (such as FCS) may be appended after the IP payload.
+  // Wrap the payload in an IOBuf on the stack, to not allocate per packet.
+  folly::IOBuf payload(
+      folly::IOBuf::WRAP_BUFFER, cursor.data(), ipv6.payloadLength);
+  cursor.reset(&payload);
 
   // retrieve the current switch state
   auto state = sw_->getState();
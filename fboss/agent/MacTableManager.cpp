@@ -12,23 +12,90 @@
 #include "fboss/agent/L2Entry.h"
 #include "fboss/agent/MacTableUtils.h"
 #include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/state/SwitchState.h"
 
+#include <gflags/gflags.h>
+
+DEFINE_int32(
+    mac_learning_batch_window_ms,
+    0,
+    "Time to buffer L2 learn/age events before applying them as a single "
+    "MAC table update. With 0, events are applied as soon as the update "
+    "thread gets to them, batching whatever queued up in the meantime");
+DEFINE_int32(
+    mac_learning_max_batch_size,
+    1000,
+    "Number of buffered L2 learn/age events that triggers a MAC table "
+    "update before the batch window elapses");
+
 namespace facebook::fboss {
 
-MacTableManager::MacTableManager(SwSwitch* sw) : sw_(sw) {}
+MacTableManager::MacTableManager(SwSwitch* sw)
+    : sw_(sw), pending_(std::make_shared<SyncedPendingL2Updates>()) {}
 
 void MacTableManager::handleL2LearningUpdate(
     L2Entry l2Entry,
     L2EntryUpdateType l2EntryUpdateType) {
-  auto updateMacTableFn =
-      [l2Entry, l2EntryUpdateType](const std::shared_ptr<SwitchState>& state) {
-        return MacTableUtils::updateMacTable(state, l2Entry, l2EntryUpdateType);
-      };
-
-  sw_->updateState(
-      folly::to<std::string>("Programming : ", l2Entry.str()),
-      std::move(updateMacTableFn));
+  bool firstInBatch = false;
+  bool batchFull = false;
+  {
+    auto pending = pending_->wlock();
+    if (pending->updates.empty()) {
+      firstInBatch = true;
+      pending->firstQueued = std::chrono::steady_clock::now();
+    }
+    pending->updates.emplace_back(std::move(l2Entry), l2EntryUpdateType);
+    batchFull = pending->updates.size() >=
+        static_cast<size_t>(FLAGS_mac_learning_max_batch_size);
+  }
+
+  if (batchFull || (firstInBatch && FLAGS_mac_learning_batch_window_ms <= 0)) {
+    scheduleFlush(sw_, pending_);
+  } else if (firstInBatch) {
+    auto* evb = sw_->getBackgroundEvb();
+    evb->runInEventBaseThread([sw = sw_, pending = pending_, evb]() {
+      evb->runAfterDelay(
+          [sw, pending]() { scheduleFlush(sw, pending); },
+          FLAGS_mac_learning_batch_window_ms);
+    });
+  }
+}
+
+void MacTableManager::scheduleFlush(
+    SwSwitch* sw,
+    const std::shared_ptr<SyncedPendingL2Updates>& pending) {
+  {
+    auto locked = pending->wlock();
+    if (locked->flushScheduled || locked->updates.empty()) {
+      return;
+    }
+    locked->flushScheduled = true;
+  }
+
+  auto updateMacTableFn = [sw,
+                           pending](const std::shared_ptr<SwitchState>& state) {
+    PendingL2Updates batch;
+    {
+      auto locked = pending->wlock();
+      batch.updates.swap(locked->updates);
+      batch.firstQueued = locked->firstQueued;
+      locked->flushScheduled = false;
+    }
+    sw->stats()->macLearningBatch(
+        batch.updates.size(),
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - batch.firstQueued));
+
+    auto newState = state;
+    for (const auto& [l2Entry, l2EntryUpdateType] : batch.updates) {
+      newState =
+          MacTableUtils::updateMacTable(newState, l2Entry, l2EntryUpdateType);
+    }
+    return newState;
+  };
+
+  sw->updateState("Programming L2 entries", std::move(updateMacTableFn));
 }
 
 } // namespace facebook::fboss
@@ -11,6 +11,13 @@
 
 #include "fboss/agent/L2Entry.h"
 
+#include <folly/Synchronized.h>
+
+#include <chrono>
+#include <memory>
+#include <utility>
+#include <vector>
+
 namespace facebook::fboss {
 
 class SwSwitch;
@@ -19,6 +26,13 @@ class MacTableManager {
  public:
   explicit MacTableManager(SwSwitch* sw);
 
+  /*
+   * L2 learn/age events are not applied one state update at a time. They
+   * are buffered and applied as a single MAC table update once the batch
+   * window (--mac_learning_batch_window_ms) elapses or the batch reaches
+   * --mac_learning_max_batch_size entries, whichever happens first. Events
+   * are applied in the order they were received.
+   */
   void handleL2LearningUpdate(
       L2Entry l2Entry,
       L2EntryUpdateType l2EntryUpdateType);
@@ -28,7 +42,24 @@ class MacTableManager {
   MacTableManager(MacTableManager const&) = delete;
   MacTableManager& operator=(MacTableManager const&) = delete;
 
+  struct PendingL2Updates {
+    std::vector<std::pair<L2Entry, L2EntryUpdateType>> updates;
+    std::chrono::steady_clock::time_point firstQueued;
+    // An updateState() draining this batch is already queued
+    bool flushScheduled{false};
+  };
+  using SyncedPendingL2Updates = folly::Synchronized<PendingL2Updates>;
+
+  /*
+   * Shared with the state update and timer callbacks, so that callbacks
+   * still queued when the MacTableManager is destroyed stay valid.
+   */
+  static void scheduleFlush(
+      SwSwitch* sw,
+      const std::shared_ptr<SyncedPendingL2Updates>& pending);
+
   SwSwitch* sw_{nullptr};
+  std::shared_ptr<SyncedPendingL2Updates> pending_;
 };
 
 } // namespace facebook::fboss
@@ -19,7 +19,13 @@ using std::optional;
 namespace facebook::fboss {
 
 void MirrorManager::stateUpdated(const StateDelta& delta) {
-  if (!hasMirrorChanges(delta)) {
+  // Route changes only matter when they change the route to some mirror
+  // destination. The watched routes are updated on every delta, so that they
+  // stay current.
+  bool destinationRoutesChanged =
+      !destinationWatcher_.updateWatches(delta).empty();
+  updateWatchedDestinations(delta);
+  if (!destinationRoutesChanged && !hasMirrorChanges(delta)) {
     return;
   }
 
@@ -60,7 +66,6 @@ std::shared_ptr<SwitchState> MirrorManager::resolveMirrors(
 bool MirrorManager::hasMirrorChanges(const StateDelta& delta) {
   return (sw_->getState()->getMirrors()->size() > 0) &&
       (!isEmpty(delta.getMirrorsDelta()) ||
-       !isEmpty(delta.getRouteTablesDelta()) ||
        std::any_of(
            std::begin(delta.getVlansDelta()),
            std::end(delta.getVlansDelta()),
@@ -70,4 +75,37 @@ bool MirrorManager::hasMirrorChanges(const StateDelta& delta) {
            }));
 }
 
+void MirrorManager::updateWatchedDestinations(const StateDelta& delta) {
+  auto destination = [](const std::shared_ptr<Mirror>& mirror) {
+    const auto& ip = mirror->getDestinationIp().value();
+    return folly::CIDRNetwork(ip, ip.bitCount());
+  };
+  DeltaFunctions::forEachChanged(
+      delta.getMirrorsDelta(),
+      [&](const std::shared_ptr<Mirror>& oldMirror,
+          const std::shared_ptr<Mirror>& newMirror) {
+        if (oldMirror->getDestinationIp() == newMirror->getDestinationIp()) {
+          return;
+        }
+        if (oldMirror->getDestinationIp()) {
+          destinationWatcher_.unwatch(RouterID(0), destination(oldMirror));
+        }
+        if (newMirror->getDestinationIp()) {
+          destinationWatcher_.watch(
+              RouterID(0), destination(newMirror), delta.newState());
+        }
+      },
+      [&](const std::shared_ptr<Mirror>& addedMirror) {
+        if (addedMirror->getDestinationIp()) {
+          destinationWatcher_.watch(
+              RouterID(0), destination(addedMirror), delta.newState());
+        }
+      },
+      [&](const std::shared_ptr<Mirror>& removedMirror) {
+        if (removedMirror->getDestinationIp()) {
+          destinationWatcher_.unwatch(RouterID(0), destination(removedMirror));
+        }
+      });
+}
+
 } // namespace facebook::fboss
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "fboss/agent/MirrorManagerImpl.h"
+#include "fboss/agent/PrefixWatcher.h"
 #include "fboss/agent/StateObserver.h"
 #include "fboss/agent/state/RouteNextHop.h"
 #include "fboss/agent/state/StateDelta.h"
@@ -15,7 +16,8 @@ class MirrorManager : public AutoRegisterStateObserver {
       : AutoRegisterStateObserver(sw, "MirrorManager"),
         sw_(sw),
         v4Manager_(std::make_unique<MirrorManagerV4>(sw)),
-        v6Manager_(std::make_unique<MirrorManagerV6>(sw)) {}
+        v6Manager_(std::make_unique<MirrorManagerV6>(sw)),
+        destinationWatcher_(sw) {}
   ~MirrorManager() override {}
 
   void stateUpdated(const StateDelta& delta) override;
@@ -24,8 +26,11 @@ class MirrorManager : public AutoRegisterStateObserver {
   SwSwitch* sw_;
   std::unique_ptr<MirrorManagerV4> v4Manager_;
   std::unique_ptr<MirrorManagerV6> v6Manager_;
+  // Routes to the destinations of the ERSPAN/sFlow mirrors
+  PrefixWatcher destinationWatcher_;
 
   bool hasMirrorChanges(const StateDelta& delta);
+  void updateWatchedDestinations(const StateDelta& delta);
 
   std::shared_ptr<SwitchState> resolveMirrors(
       const std::shared_ptr<SwitchState>& state);
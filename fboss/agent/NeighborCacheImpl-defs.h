@@ -61,87 +61,164 @@ bool checkVlanAndIntf(
 } // namespace ncachehelpers
 
 template <typename NTable>
-void NeighborCacheImpl<NTable>::programEntry(Entry* entry) {
-  CHECK(!entry->isPending());
+void NeighborCacheImpl<NTable>::queueUpdate(NeighborTableUpdate update) {
+  auto allowsCoalescing =
+      update.type != NeighborTableUpdate::Type::PROGRAM_PENDING;
+  bool newBatch{false};
+  {
+    auto batches = pendingUpdates_->wlock();
+    if (batches->empty() || batches->back().sealed ||
+        batches->back().updates.size() >= kMaxNeighborUpdateBatchSize ||
+        batches->back().ips.count(update.fields.ip) ||
+        (batches->back().allowsCoalescing && !allowsCoalescing)) {
+      batches->emplace_back(allowsCoalescing);
+      newBatch = true;
+    }
+    auto& batch = batches->back();
+    batch.ips.insert(update.fields.ip);
+    batch.updates.push_back(std::move(update));
+  }
+  if (!newBatch) {
+    // The state update for the batch is already scheduled
+    return;
+  }
 
-  auto fields = entry->getFields();
-  auto vlanID = vlanID_;
-  auto updateFn = [fields, vlanID](const std::shared_ptr<SwitchState>& state)
-      -> std::shared_ptr<SwitchState> {
-    if (!ncachehelpers::checkVlanAndIntf<NTable>(state, fields, vlanID)) {
-      // Either the vlan or intf is no longer valid.
+  auto updateFn = [batches = pendingUpdates_, vlanID = vlanID_](
+                      const std::shared_ptr<SwitchState>& state) {
+    return applyUpdateBatch(state, batches, vlanID);
+  };
+  auto name = folly::to<std::string>("program neighbors on vlan ", vlanID_);
+  if (allowsCoalescing) {
+    sw_->updateState(name, std::move(updateFn));
+  } else {
+    sw_->updateStateNoCoalescing(name, std::move(updateFn));
+  }
+}
+
+template <typename NTable>
+void NeighborCacheImpl<NTable>::sealPendingUpdates() {
+  auto batches = pendingUpdates_->wlock();
+  if (!batches->empty()) {
+    batches->back().sealed = true;
+  }
+}
+
+template <typename NTable>
+std::shared_ptr<SwitchState> NeighborCacheImpl<NTable>::applyUpdateBatch(
+    const std::shared_ptr<SwitchState>& state,
+    const std::shared_ptr<SyncedUpdateBatches>& batches,
+    VlanID vlanID) {
+  // Every batch schedules exactly one state update, and state updates run
+  // in the order they were scheduled, so ours is the oldest batch.
+  std::vector<NeighborTableUpdate> updates;
+  {
+    auto locked = batches->wlock();
+    if (locked->empty()) {
       return nullptr;
     }
+    updates = std::move(locked->front().updates);
+    locked->pop_front();
+  }
 
-    auto vlan = state->getVlans()->getVlanIf(vlanID).get();
-    std::shared_ptr<SwitchState> newState{state};
-    auto* table = vlan->template getNeighborTable<NTable>().get();
-    auto node = table->getNodeIf(fields.ip);
-
-    if (!node) {
-      table = table->modify(&vlan, &newState);
-      table->addEntry(fields);
-      XLOG(DBG2) << "Adding entry for " << fields.ip << " --> " << fields.mac
-                 << " on interface " << fields.interfaceID << " for vlan "
-                 << vlanID;
-    } else {
-      if (node->getMac() == fields.mac && node->getPort() == fields.port &&
-          node->getIntfID() == fields.interfaceID &&
-          node->getState() == fields.state && !node->isPending()) {
-        // This entry was already updated while we were waiting on the lock.
-        return nullptr;
-      }
-      table = table->modify(&vlan, &newState);
-      table->updateEntry(fields);
-      XLOG(DBG2) << "Converting pending entry for " << fields.ip << " --> "
-                 << fields.mac << " on interface " << fields.interfaceID
-                 << " for vlan " << vlanID;
+  std::shared_ptr<SwitchState> newState{state};
+  bool changed{false};
+  for (const auto& update : updates) {
+    switch (update.type) {
+      case NeighborTableUpdate::Type::PROGRAM:
+        changed |= programEntryInSwitchState(&newState, update.fields, vlanID);
+        break;
+      case NeighborTableUpdate::Type::PROGRAM_PENDING:
+        changed |= programPendingEntryInSwitchState(
+            &newState, update.fields, vlanID, update.force);
+        break;
+      case NeighborTableUpdate::Type::FLUSH:
+        changed |=
+            flushEntryFromSwitchState(&newState, update.fields.ip, vlanID);
+        break;
     }
-    return newState;
-  };
+  }
+  return changed ? newState : nullptr;
+}
+
+template <typename NTable>
+void NeighborCacheImpl<NTable>::programEntry(Entry* entry) {
+  CHECK(!entry->isPending());
+  queueUpdate(NeighborTableUpdate(
+      NeighborTableUpdate::Type::PROGRAM, entry->getFields()));
+}
+
+template <typename NTable>
+bool NeighborCacheImpl<NTable>::programEntryInSwitchState(
+    std::shared_ptr<SwitchState>* state,
+    const EntryFields& fields,
+    VlanID vlanID) {
+  if (!ncachehelpers::checkVlanAndIntf<NTable>(*state, fields, vlanID)) {
+    // Either the vlan or intf is no longer valid.
+    return false;
+  }
 
-  sw_->updateState(
-      folly::to<std::string>("add neighbor ", fields.ip), std::move(updateFn));
+  auto vlan = (*state)->getVlans()->getVlanIf(vlanID).get();
+  auto* table = vlan->template getNeighborTable<NTable>().get();
+  auto node = table->getNodeIf(fields.ip);
+
+  if (!node) {
+    table = table->modify(&vlan, state);
+    table->addEntry(fields);
+    XLOG(DBG2) << "Adding entry for " << fields.ip << " --> " << fields.mac
+               << " on interface " << fields.interfaceID << " for vlan "
+               << vlanID;
+  } else {
+    if (node->getMac() == fields.mac && node->getPort() == fields.port &&
+        node->getIntfID() == fields.interfaceID &&
+        node->getState() == fields.state && !node->isPending()) {
+      // This entry was already updated while we were waiting on the lock.
+      return false;
+    }
+    table = table->modify(&vlan, state);
+    table->updateEntry(fields);
+    XLOG(DBG2) << "Converting pending entry for " << fields.ip << " --> "
+               << fields.mac << " on interface " << fields.interfaceID
+               << " for vlan " << vlanID;
+  }
+  return true;
 }
 
 template <typename NTable>
 void NeighborCacheImpl<NTable>::programPendingEntry(Entry* entry, bool force) {
   CHECK(entry->isPending());
+  queueUpdate(NeighborTableUpdate(
+      NeighborTableUpdate::Type::PROGRAM_PENDING, entry->getFields(), force));
+}
 
-  auto fields = entry->getFields();
-  auto vlanID = vlanID_;
-  auto updateFn =
-      [fields, vlanID, force](const std::shared_ptr<SwitchState>& state)
-      -> std::shared_ptr<SwitchState> {
-    if (!ncachehelpers::checkVlanAndIntf<NTable>(state, fields, vlanID)) {
-      // Either the vlan or intf is no longer valid.
-      return nullptr;
-    }
+template <typename NTable>
+bool NeighborCacheImpl<NTable>::programPendingEntryInSwitchState(
+    std::shared_ptr<SwitchState>* state,
+    const EntryFields& fields,
+    VlanID vlanID,
+    bool force) {
+  if (!ncachehelpers::checkVlanAndIntf<NTable>(*state, fields, vlanID)) {
+    // Either the vlan or intf is no longer valid.
+    return false;
+  }
 
-    auto vlan = state->getVlans()->getVlanIf(vlanID).get();
-    std::shared_ptr<SwitchState> newState{state};
-    auto* table = vlan->template getNeighborTable<NTable>().get();
-    auto node = table->getNodeIf(fields.ip);
-    table = table->modify(&vlan, &newState);
-
-    if (node) {
-      if (!force) {
-        // don't replace an existing entry with a pending one unless
-        // explicitly allowed
-        return nullptr;
-      }
-      table->removeEntry(fields.ip);
-    }
-    table->addPendingEntry(fields.ip, fields.interfaceID);
+  auto vlan = (*state)->getVlans()->getVlanIf(vlanID).get();
+  auto* table = vlan->template getNeighborTable<NTable>().get();
+  auto node = table->getNodeIf(fields.ip);
 
-    XLOG(DBG4) << "Adding pending entry for " << fields.ip << " on interface "
-               << fields.interfaceID << " for vlan " << vlanID;
-    return newState;
-  };
+  if (node && !force) {
+    // don't replace an existing entry with a pending one unless
+    // explicitly allowed
+    return false;
+  }
+  table = table->modify(&vlan, state);
+  if (node) {
+    table->removeEntry(fields.ip);
+  }
+  table->addPendingEntry(fields.ip, fields.interfaceID);
 
-  sw_->updateStateNoCoalescing(
-      folly::to<std::string>("add pending entry ", fields.ip),
-      std::move(updateFn));
+  XLOG(DBG4) << "Adding pending entry for " << fields.ip << " on interface "
+             << fields.interfaceID << " for vlan " << vlanID;
+  return true;
 }
 
 template <typename NTable>
@@ -227,6 +304,7 @@ void NeighborCacheImpl<NTable>::updateEntryClassID(
     auto classIDStr = classID.has_value()
         ? folly::to<std::string>(static_cast<int>(classID.value()))
         : "None";
+    sealPendingUpdates();
     sw_->updateState(
         folly::to<std::string>(
             "NeighborCache configure lookup classID: ", classIDStr),
@@ -314,8 +392,12 @@ bool NeighborCacheImpl<NTable>::removeEntry(AddressType ip) {
 template <typename NTable>
 bool NeighborCacheImpl<NTable>::flushEntryFromSwitchState(
     std::shared_ptr<SwitchState>* state,
-    AddressType ip) {
-  auto* vlan = (*state)->getVlans()->getVlan(vlanID_).get();
+    AddressType ip,
+    VlanID vlanID) {
+  auto* vlan = (*state)->getVlans()->getVlanIf(vlanID).get();
+  if (!vlan) {
+    return false;
+  }
   auto* table = vlan->template getNeighborTable<NTable>().get();
   const auto& entry = table->getNodeIf(ip);
   if (!entry) {
@@ -344,26 +426,28 @@ void NeighborCacheImpl<NTable>::flushEntry(AddressType ip, bool* flushed) {
     return;
   }
 
-  // flush from SwitchState
-  auto updateFn = [this, ip, flushed](const std::shared_ptr<SwitchState>& state)
+  if (!flushed) {
+    // flush from SwitchState along with the other queued neighbor changes
+    queueUpdate(NeighborTableUpdate(
+        NeighborTableUpdate::Type::FLUSH,
+        EntryFields(ip, intfID_, NeighborState::PENDING)));
+    return;
+  }
+
+  // need a blocking state update if the caller wants to know if an entry
+  // was actually flushed
+  auto updateFn = [vlanID = vlanID_, ip, flushed](
+                      const std::shared_ptr<SwitchState>& state)
       -> std::shared_ptr<SwitchState> {
     std::shared_ptr<SwitchState> newState{state};
-    if (flushEntryFromSwitchState(&newState, ip)) {
-      if (flushed) {
-        *flushed = true;
-      }
+    if (flushEntryFromSwitchState(&newState, ip, vlanID)) {
+      *flushed = true;
       return newState;
     }
     return nullptr;
   };
-
-  if (flushed) {
-    // need a blocking state update if the caller wants to know if an entry
-    // was actually flushed
-    sw_->updateStateBlocking("flush neighbor entry", std::move(updateFn));
-  } else {
-    sw_->updateState("remove neighbor entry", std::move(updateFn));
-  }
+  sealPendingUpdates();
+  sw_->updateStateBlocking("flush neighbor entry", std::move(updateFn));
 }
 
 template <typename NTable>
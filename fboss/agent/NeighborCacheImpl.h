@@ -18,9 +18,13 @@
 
 #include <folly/IPAddress.h>
 #include <folly/Random.h>
+#include <folly/Synchronized.h>
+#include <deque>
 #include <list>
 #include <optional>
 #include <string>
+#include <unordered_set>
+#include <vector>
 
 namespace facebook::fboss {
 
@@ -64,7 +68,8 @@ class NeighborCacheImpl {
         vlanID_(vlanID),
         vlanName_(vlanName),
         intfID_(intfID),
-        evb_(sw->getNeighborCacheEvb()) {}
+        evb_(sw->getNeighborCacheEvb()),
+        pendingUpdates_(std::make_shared<SyncedUpdateBatches>()) {}
 
   // Methods useful for subclasses
   void setPendingEntry(AddressType ip, bool force = false);
@@ -125,9 +130,62 @@ class NeighborCacheImpl {
   std::optional<NeighborEntryThrift> getCacheData(AddressType ip) const;
 
  private:
+  /*
+   * Changes to the neighbor table are not programmed with one state update
+   * each. They are queued in batches, and every batch is applied to the
+   * VLAN's neighbor table by a single state update, which is scheduled as
+   * soon as the batch is started. Changes keep joining the latest batch
+   * until that update runs, so a burst of resolutions costs one clone of
+   * the neighbor table rather than one per neighbor.
+   *
+   * A batch holds at most one change per IP and at most
+   * kMaxNeighborUpdateBatchSize changes. Pending entries have to be seen by
+   * the HwSwitch, so they only go into batches whose update does not allow
+   * coalescing.
+   */
+  struct NeighborTableUpdate {
+    enum class Type { PROGRAM, PROGRAM_PENDING, FLUSH };
+    NeighborTableUpdate(Type type, EntryFields fields, bool force = false)
+        : type(type), fields(std::move(fields)), force(force) {}
+
+    Type type;
+    EntryFields fields;
+    bool force;
+  };
+  struct UpdateBatch {
+    explicit UpdateBatch(bool allowsCoalescing)
+        : allowsCoalescing(allowsCoalescing) {}
+
+    std::vector<NeighborTableUpdate> updates;
+    std::unordered_set<AddressType> ips;
+    bool allowsCoalescing;
+    // No more changes may join this batch
+    bool sealed{false};
+  };
+  using SyncedUpdateBatches = folly::Synchronized<std::deque<UpdateBatch>>;
+  static constexpr size_t kMaxNeighborUpdateBatchSize = 1024;
+
+  void queueUpdate(NeighborTableUpdate update);
+  // Must be called before scheduling any other state update from the cache,
+  // so that it is not overtaken by changes queued after it.
+  void sealPendingUpdates();
+  static std::shared_ptr<SwitchState> applyUpdateBatch(
+      const std::shared_ptr<SwitchState>& state,
+      const std::shared_ptr<SyncedUpdateBatches>& batches,
+      VlanID vlanID);
+
   // These are used to program entries into the SwitchState
   void programEntry(Entry* entry);
   void programPendingEntry(Entry* entry, bool force = false);
+  static bool programEntryInSwitchState(
+      std::shared_ptr<SwitchState>* state,
+      const EntryFields& fields,
+      VlanID vlanID);
+  static bool programPendingEntryInSwitchState(
+      std::shared_ptr<SwitchState>* state,
+      const EntryFields& fields,
+      VlanID vlanID,
+      bool force);
 
   void processEntry(AddressType ip);
 
@@ -135,9 +193,10 @@ class NeighborCacheImpl {
   // was actually flushed from the switch state
   void flushEntry(AddressType ip, bool* flushed = nullptr);
 
-  bool flushEntryFromSwitchState(
+  static bool flushEntryFromSwitchState(
       std::shared_ptr<SwitchState>* state,
-      AddressType ip);
+      AddressType ip,
+      VlanID vlanID);
 
   Entry* getCacheEntry(AddressType ip) const;
   void setCacheEntry(std::shared_ptr<Entry> entry);
@@ -161,6 +220,9 @@ class NeighborCacheImpl {
 
   // Map of all entries
   std::unordered_map<AddressType, std::shared_ptr<Entry>> entries_;
+
+  // Shared with the scheduled state updates, which may outlive the cache
+  std::shared_ptr<SyncedUpdateBatches> pendingUpdates_;
 };
 
 } // namespace facebook::fboss
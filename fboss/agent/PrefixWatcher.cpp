@@ -0,0 +1,235 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/PrefixWatcher.h"
+
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/state/ForwardingInformationBaseContainer.h"
+#include "fboss/agent/state/ForwardingInformationBaseMap.h"
+#include "fboss/agent/state/RouteTable.h"
+#include "fboss/agent/state/RouteTableMap.h"
+#include "fboss/agent/state/RouteTableRib.h"
+#include "fboss/agent/state/StateDelta.h"
+#include "fboss/agent/state/SwitchState.h"
+
+#include <set>
+
+using folly::CIDRNetwork;
+using folly::IPAddress;
+using folly::IPAddressV4;
+using folly::IPAddressV6;
+
+namespace {
+
+/*
+ * Whether traffic to the watched prefix is forwarded the same way by both
+ * routes. A route which was replaced by an identical copy (e.g. when another
+ * client's next hops for the same prefix changed) is not a change.
+ */
+template <typename AddrT>
+bool isSameBestRoute(
+    const std::shared_ptr<facebook::fboss::Route<AddrT>>& oldRoute,
+    const std::shared_ptr<facebook::fboss::Route<AddrT>>& newRoute) {
+  if (oldRoute == newRoute) {
+    return true;
+  }
+  if (!oldRoute || !newRoute) {
+    return false;
+  }
+  if (oldRoute->prefix() != newRoute->prefix() ||
+      oldRoute->isResolved() != newRoute->isResolved()) {
+    return false;
+  }
+  return !newRoute->isResolved() ||
+      oldRoute->getForwardInfo() == newRoute->getForwardInfo();
+}
+
+template <typename AddrT>
+std::pair<AddrT, uint8_t> toWatchKey(const AddrT& network, uint8_t mask) {
+  if (mask > AddrT::bitCount()) {
+    throw facebook::fboss::FbossError(
+        "Invalid mask ", static_cast<int>(mask), " for ", network.str());
+  }
+  return std::make_pair(network.mask(mask), mask);
+}
+
+} // namespace
+
+namespace facebook::fboss {
+
+void PrefixWatcher::watch(
+    RouterID vrf,
+    const CIDRNetwork& prefix,
+    const std::shared_ptr<SwitchState>& state) {
+  if (prefix.first.isV4()) {
+    watchImpl(vrf, toWatchKey(prefix.first.asV4(), prefix.second), state);
+  } else {
+    watchImpl(vrf, toWatchKey(prefix.first.asV6(), prefix.second), state);
+  }
+}
+
+void PrefixWatcher::unwatch(RouterID vrf, const CIDRNetwork& prefix) {
+  if (prefix.first.isV4()) {
+    unwatchImpl(vrf, toWatchKey(prefix.first.asV4(), prefix.second));
+  } else {
+    unwatchImpl(vrf, toWatchKey(prefix.first.asV6(), prefix.second));
+  }
+}
+
+bool PrefixWatcher::isWatched(RouterID vrf, const CIDRNetwork& prefix) const {
+  if (prefix.first.isV4()) {
+    return isWatchedImpl(vrf, toWatchKey(prefix.first.asV4(), prefix.second));
+  }
+  return isWatchedImpl(vrf, toWatchKey(prefix.first.asV6(), prefix.second));
+}
+
+std::vector<PrefixWatcher::WatchedPrefix> PrefixWatcher::updateWatches(
+    const StateDelta& delta) {
+  std::vector<WatchedPrefix> changed;
+  if (size_ == 0) {
+    return changed;
+  }
+
+  const auto& state = delta.newState();
+  if (sw_->isStandaloneRibEnabled()) {
+    for (const auto& fibDelta : delta.getFibsDelta()) {
+      auto vrf = fibDelta.getOld() ? fibDelta.getOld()->getID()
+                                   : fibDelta.getNew()->getID();
+      processRoutesDelta<IPAddressV4>(
+          vrf, fibDelta.getV4FibDelta(), state, &changed);
+      processRoutesDelta<IPAddressV6>(
+          vrf, fibDelta.getV6FibDelta(), state, &changed);
+    }
+  } else {
+    for (const auto& rtDelta : delta.getRouteTablesDelta()) {
+      auto vrf = rtDelta.getOld() ? rtDelta.getOld()->getID()
+                                  : rtDelta.getNew()->getID();
+      processRoutesDelta<IPAddressV4>(
+          vrf, rtDelta.getRoutesV4Delta(), state, &changed);
+      processRoutesDelta<IPAddressV6>(
+          vrf, rtDelta.getRoutesV6Delta(), state, &changed);
+    }
+  }
+  return changed;
+}
+
+template <typename AddrT>
+void PrefixWatcher::watchImpl(
+    RouterID vrf,
+    const WatchKey<AddrT>& key,
+    const std::shared_ptr<SwitchState>& state) {
+  auto& watch = std::get<VrfWatchMap<AddrT>>(watches_)[vrf][key];
+  if (watch.refCount++ == 0) {
+    watch.bestRoute = getBestRoute(state, vrf, key);
+    ++size_;
+  }
+}
+
+template <typename AddrT>
+void PrefixWatcher::unwatchImpl(RouterID vrf, const WatchKey<AddrT>& key) {
+  auto& vrfWatches = std::get<VrfWatchMap<AddrT>>(watches_);
+  auto vrfIt = vrfWatches.find(vrf);
+  if (vrfIt == vrfWatches.end() ||
+      vrfIt->second.find(key) == vrfIt->second.end()) {
+    throw FbossError(
+        "Prefix ",
+        key.first.str(),
+        "/",
+        static_cast<int>(key.second),
+        " is not watched in VRF ",
+        vrf);
+  }
+  auto& watches = vrfIt->second;
+  auto it = watches.find(key);
+  if (--it->second.refCount == 0) {
+    watches.erase(it);
+    --size_;
+    if (watches.empty()) {
+      vrfWatches.erase(vrfIt);
+    }
+  }
+}
+
+template <typename AddrT>
+bool PrefixWatcher::isWatchedImpl(RouterID vrf, const WatchKey<AddrT>& key)
+    const {
+  const auto& vrfWatches = std::get<VrfWatchMap<AddrT>>(watches_);
+  auto vrfIt = vrfWatches.find(vrf);
+  return vrfIt != vrfWatches.end() &&
+      vrfIt->second.find(key) != vrfIt->second.end();
+}
+
+template <typename AddrT, typename RoutesDelta>
+void PrefixWatcher::processRoutesDelta(
+    RouterID vrf,
+    const RoutesDelta& routesDelta,
+    const std::shared_ptr<SwitchState>& state,
+    std::vector<WatchedPrefix>* changed) {
+  auto& vrfWatches = std::get<VrfWatchMap<AddrT>>(watches_);
+  auto vrfIt = vrfWatches.find(vrf);
+  if (vrfIt == vrfWatches.end()) {
+    return;
+  }
+  auto& watches = vrfIt->second;
+
+  // A changed route can only change the best route of the watched prefixes
+  // it contains, and only if it is at least as long as their current best
+  // route. If the current best route itself went away, it is in the delta as
+  // well.
+  std::set<WatchKey<AddrT>> affected;
+  for (const auto& routeDelta : routesDelta) {
+    const auto& route =
+        routeDelta.getOld() ? routeDelta.getOld() : routeDelta.getNew();
+    const auto& prefix = route->prefix();
+    for (auto it = watches.lower_bound(WatchKey<AddrT>(prefix.network, 0));
+         it != watches.end() &&
+         it->first.first.inSubnet(prefix.network, prefix.mask);
+         ++it) {
+      const auto& bestRoute = it->second.bestRoute;
+      if (it->first.second >= prefix.mask &&
+          (!bestRoute || bestRoute->prefix().mask <= prefix.mask)) {
+        affected.insert(it->first);
+      }
+    }
+  }
+
+  for (const auto& key : affected) {
+    auto& watch = watches[key];
+    auto bestRoute = getBestRoute(state, vrf, key);
+    if (!isSameBestRoute(watch.bestRoute, bestRoute)) {
+      changed->emplace_back(
+          vrf, CIDRNetwork(IPAddress(key.first), key.second));
+    }
+    watch.bestRoute = std::move(bestRoute);
+  }
+}
+
+template <typename AddrT>
+std::shared_ptr<Route<AddrT>> PrefixWatcher::getBestRoute(
+    const std::shared_ptr<SwitchState>& state,
+    RouterID vrf,
+    const WatchKey<AddrT>& key) const {
+  if (sw_->isStandaloneRibEnabled()) {
+    auto fibContainer = state->getFibs()->getFibContainerIf(vrf);
+    if (!fibContainer) {
+      return nullptr;
+    }
+    return fibContainer->template getFib<AddrT>()->longestMatch(
+        key.first, key.second);
+  }
+  auto routeTable = state->getRouteTables()->getRouteTableIf(vrf);
+  if (!routeTable) {
+    return nullptr;
+  }
+  return routeTable->template getRib<AddrT>()->longestMatch(
+      key.first, key.second);
+}
+
+} // namespace facebook::fboss
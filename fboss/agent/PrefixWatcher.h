@@ -0,0 +1,130 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/state/Route.h"
+#include "fboss/agent/types.h"
+
+#include <folly/IPAddress.h>
+#include <folly/IPAddressV4.h>
+#include <folly/IPAddressV6.h>
+
+#include <map>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace facebook::fboss {
+
+class StateDelta;
+class SwitchState;
+class SwSwitch;
+
+/*
+ * PrefixWatcher tracks the best route for a set of watched prefixes, for
+ * consumers which only care about the route to a few destinations (e.g.
+ * mirror destinations) rather than about the whole route table.
+ *
+ * The best route for a prefix is the longest route containing all of it, so
+ * watching a host prefix tracks the route an address is forwarded by.
+ *
+ * updateWatches() is fed every StateDelta, and returns the watched prefixes
+ * whose best route, or that route's resolved next hops, changed. Only the
+ * routes changed by the delta are looked at, so route churn elsewhere in the
+ * table costs a lookup in the watch list per changed route, rather than a
+ * lookup in the route table per watched prefix.
+ *
+ * This is not thread safe, and is meant to be used from the state observer
+ * of the consumer, on the update thread.
+ */
+class PrefixWatcher {
+ public:
+  using WatchedPrefix = std::pair<RouterID, folly::CIDRNetwork>;
+
+  explicit PrefixWatcher(SwSwitch* sw) : sw_(sw) {}
+
+  /*
+   * Starts watching prefix in vrf, with its best route looked up in state.
+   * Watches are reference counted, and each watch() must be matched by an
+   * unwatch().
+   */
+  void watch(
+      RouterID vrf,
+      const folly::CIDRNetwork& prefix,
+      const std::shared_ptr<SwitchState>& state);
+  void unwatch(RouterID vrf, const folly::CIDRNetwork& prefix);
+
+  bool isWatched(RouterID vrf, const folly::CIDRNetwork& prefix) const;
+
+  /*
+   * Number of distinct prefixes watched.
+   */
+  size_t size() const {
+    return size_;
+  }
+
+  /*
+   * Updates the best routes of the watched prefixes to delta.newState(), and
+   * returns those which changed.
+   */
+  std::vector<WatchedPrefix> updateWatches(const StateDelta& delta);
+
+ private:
+  // Forbidden copy constructor and assignment operator
+  PrefixWatcher(PrefixWatcher const&) = delete;
+  PrefixWatcher& operator=(PrefixWatcher const&) = delete;
+
+  template <typename AddrT>
+  struct Watch {
+    std::shared_ptr<Route<AddrT>> bestRoute;
+    uint32_t refCount{0};
+  };
+  // Keyed by network, then mask, so that the watched prefixes within any
+  // route are adjacent
+  template <typename AddrT>
+  using WatchKey = std::pair<AddrT, uint8_t>;
+  template <typename AddrT>
+  using WatchMap = std::map<WatchKey<AddrT>, Watch<AddrT>>;
+  template <typename AddrT>
+  using VrfWatchMap = std::map<RouterID, WatchMap<AddrT>>;
+
+  template <typename AddrT>
+  void watchImpl(
+      RouterID vrf,
+      const WatchKey<AddrT>& key,
+      const std::shared_ptr<SwitchState>& state);
+  template <typename AddrT>
+  void unwatchImpl(RouterID vrf, const WatchKey<AddrT>& key);
+  template <typename AddrT>
+  bool isWatchedImpl(RouterID vrf, const WatchKey<AddrT>& key) const;
+
+  template <typename AddrT, typename RoutesDelta>
+  void processRoutesDelta(
+      RouterID vrf,
+      const RoutesDelta& routesDelta,
+      const std::shared_ptr<SwitchState>& state,
+      std::vector<WatchedPrefix>* changed);
+
+  template <typename AddrT>
+  std::shared_ptr<Route<AddrT>> getBestRoute(
+      const std::shared_ptr<SwitchState>& state,
+      RouterID vrf,
+      const WatchKey<AddrT>& key) const;
+
+  SwSwitch* sw_;
+  std::tuple<
+      VrfWatchMap<folly::IPAddressV4>,
+      VrfWatchMap<folly::IPAddressV6>>
+      watches_;
+  size_t size_{0};
+};
+
+} // namespace facebook::fboss
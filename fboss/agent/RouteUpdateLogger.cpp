@@ -64,11 +64,20 @@ RouteUpdateLogger::RouteUpdateLogger(
     std::unique_ptr<RouteLogger<folly::IPAddressV4>> routeLoggerV4,
     std::unique_ptr<RouteLogger<folly::IPAddressV6>> routeLoggerV6,
     std::unique_ptr<MplsRouteLogger> mplsRouteLogger)
-    : AutoRegisterStateObserver(sw, "RouteUpdateLogger"),
+    : AutoRegisterStateObserver(
+          sw,
+          "RouteUpdateLogger",
+          StateObserverDispatch::ASYNC),
       routeLoggerV4_(std::move(routeLoggerV4)),
       routeLoggerV6_(std::move(routeLoggerV6)),
       mplsRouteLogger_(std::move(mplsRouteLogger)) {}
 
+RouteUpdateLogger::~RouteUpdateLogger() {
+  // Route updates are logged asynchronously, wait for the last ones to be
+  // logged before the loggers go away.
+  unregisterStateObserver();
+}
+
 void RouteUpdateLogger::stateUpdated(const StateDelta& delta) {
   for (const auto& rtDelta : delta.getRouteTablesDelta()) {
     DeltaFunctions::forEachChanged(
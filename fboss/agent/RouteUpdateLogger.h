@@ -162,7 +162,7 @@ class RouteUpdateLogger : public AutoRegisterStateObserver {
       std::unique_ptr<RouteLogger<folly::IPAddressV6>> routeLoggerV6,
       std::unique_ptr<MplsRouteLogger> mplsRouteLogger);
 
-  ~RouteUpdateLogger() override = default;
+  ~RouteUpdateLogger() override;
 
   void stateUpdated(const StateDelta& delta) override;
   void startLoggingForPrefix(const RouteUpdateLoggingInstance& req);
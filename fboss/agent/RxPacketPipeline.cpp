@@ -0,0 +1,143 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/RxPacketPipeline.h"
+
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/RxPacket.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/SwitchStats.h"
+#include "fboss/agent/Utils.h"
+#include "fboss/agent/packet/Ethertype.h"
+#include "fboss/agent/packet/ICMPHdr.h"
+
+#include <folly/Conv.h>
+
+#include <vector>
+
+namespace facebook::fboss {
+
+namespace {
+constexpr uint32_t kMinEthFrameLen = 64;
+} // namespace
+
+RxPacketPipeline::RxPacketPipeline(
+    SwSwitch* sw,
+    PacketHandler handler,
+    uint32_t queueSize,
+    uint32_t batchSize)
+    : sw_(sw), handler_(std::move(handler)), batchSize_(batchSize) {
+  for (size_t i = 0; i < kNumQueues; ++i) {
+    auto queue = static_cast<Queue>(i);
+    queues_[i] = folly::MPMCQueue<QueuedPacket>(queueSize);
+    workers_[i] = std::make_unique<std::thread>([this, queue]() {
+      initThread(folly::to<std::string>("fbossRx", queueName(queue)));
+      workerLoop(queue);
+    });
+  }
+}
+
+RxPacketPipeline::~RxPacketPipeline() {
+  stop();
+}
+
+void RxPacketPipeline::stop() {
+  for (size_t i = 0; i < kNumQueues; ++i) {
+    if (!workers_[i]) {
+      continue;
+    }
+    queues_[i].blockingWrite(QueuedPacket{});
+    workers_[i]->join();
+    workers_[i].reset();
+  }
+}
+
+RxPacketPipeline::Queue RxPacketPipeline::classify(
+    const RxPacket* pkt,
+    const std::optional<PktHeaderView>& headers) {
+  // Runt frames are counted and dropped by the data queue handler
+  if (pkt->getLength() < kMinEthFrameLen || !headers) {
+    return Queue::DATA;
+  }
+  switch (static_cast<ETHERTYPE>(headers->etherType)) {
+    case ETHERTYPE::ETHERTYPE_SLOW_PROTOCOLS:
+    case ETHERTYPE::ETHERTYPE_LLDP:
+    case ETHERTYPE::ETHERRTPE_EAPOL:
+      return Queue::CONTROL;
+    case ETHERTYPE::ETHERTYPE_ARP:
+      return Queue::NEIGHBOR;
+    case ETHERTYPE::ETHERTYPE_IPV6:
+      if (headers->icmpType) {
+        auto icmpType = static_cast<ICMPv6Type>(*headers->icmpType);
+        if (icmpType >= ICMPv6Type::ICMPV6_TYPE_NDP_ROUTER_SOLICITATION &&
+            icmpType <= ICMPv6Type::ICMPV6_TYPE_NDP_REDIRECT_MESSAGE) {
+          return Queue::NEIGHBOR;
+        }
+      }
+      return Queue::DATA;
+    default:
+      return Queue::DATA;
+  }
+}
+
+std::string RxPacketPipeline::queueName(Queue queue) {
+  switch (queue) {
+    case Queue::CONTROL:
+      return "Control";
+    case Queue::NEIGHBOR:
+      return "Neighbor";
+    case Queue::DATA:
+      return "Data";
+  }
+  throw FbossError("Unknown RX queue ", static_cast<int>(queue));
+}
+
+bool RxPacketPipeline::enqueue(std::unique_ptr<RxPacket> pkt) noexcept {
+  auto headers = PktHeaderView::parse(pkt->buf());
+  auto queue = classify(pkt.get(), headers);
+  if (!queues_[static_cast<size_t>(queue)].write(
+          QueuedPacket{std::move(pkt), std::move(headers)})) {
+    sw_->stats()->rxQueueDrop(queueName(queue));
+    return false;
+  }
+  return true;
+}
+
+void RxPacketPipeline::workerLoop(Queue queue) {
+  auto& rxQueue = queues_[static_cast<size_t>(queue)];
+  auto name = queueName(queue);
+  std::vector<QueuedPacket> batch;
+  batch.reserve(batchSize_);
+  while (true) {
+    // Block for the first packet, then take whatever else is already queued
+    // so that a burst is handled with a single wakeup.
+    QueuedPacket queuedPkt;
+    rxQueue.blockingRead(queuedPkt);
+    auto depth = getQueueDepth(queue);
+    bool stop{false};
+    do {
+      if (!queuedPkt.pkt) {
+        stop = true;
+        break;
+      }
+      batch.push_back(std::move(queuedPkt));
+    } while (batch.size() < batchSize_ && rxQueue.read(queuedPkt));
+
+    sw_->stats()->rxQueueBatch(name, batch.size(), depth);
+    for (auto& rxPkt : batch) {
+      handler_(std::move(rxPkt.pkt), std::move(rxPkt.headers));
+    }
+    batch.clear();
+    if (stop) {
+      return;
+    }
+  }
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,107 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/MPMCQueue.h>
+#include "fboss/agent/packet/PktHeaderView.h"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+
+namespace facebook::fboss {
+
+class RxPacket;
+class SwSwitch;
+
+/*
+ * RxPacketPipeline moves packet processing off the HwSwitch RX callback
+ * thread.
+ *
+ * The RX callback only classifies a packet by protocol and enqueues it on
+ * the matching bounded queue. Each queue is drained in batches by its own
+ * worker thread, which runs the usual SwSwitch packet handling. Control
+ * protocols (LACP, LLDP, EAPOL) and neighbor discovery (ARP, NDP) thus have
+ * queues and workers of their own, and a burst of DHCP or TTL expired
+ * traffic can no longer delay them: it only fills up, and then drops from,
+ * the data queue.
+ *
+ * Packets of one queue are handled in the order they were received, which
+ * keeps the per port ordering the protocol handlers expect.
+ */
+class RxPacketPipeline {
+ public:
+  using PacketHandler = std::function<
+      void(std::unique_ptr<RxPacket>, std::optional<PktHeaderView>)>;
+
+  // In decreasing order of priority
+  enum class Queue : uint8_t {
+    CONTROL,
+    NEIGHBOR,
+    DATA,
+  };
+  static constexpr size_t kNumQueues = 3;
+
+  RxPacketPipeline(
+      SwSwitch* sw,
+      PacketHandler handler,
+      uint32_t queueSize,
+      uint32_t batchSize);
+  ~RxPacketPipeline();
+
+  /*
+   * Classify the packet and queue it for its worker thread.  Returns false
+   * and drops the packet if its queue is full.
+   *
+   * The headers parsed for classification are passed on to the handler along
+   * with the packet.
+   */
+  bool enqueue(std::unique_ptr<RxPacket> pkt) noexcept;
+
+  /*
+   * Stop the worker threads, once they have handled the packets already
+   * queued.
+   */
+  void stop();
+
+  static Queue classify(
+      const RxPacket* pkt,
+      const std::optional<PktHeaderView>& headers);
+  static std::string queueName(Queue queue);
+
+  size_t getQueueDepth(Queue queue) const {
+    return std::max<ssize_t>(queues_[static_cast<size_t>(queue)].size(), 0);
+  }
+
+ private:
+  // Forbidden copy constructor and assignment operator
+  RxPacketPipeline(RxPacketPipeline const&) = delete;
+  RxPacketPipeline& operator=(RxPacketPipeline const&) = delete;
+
+  struct QueuedPacket {
+    std::unique_ptr<RxPacket> pkt;
+    std::optional<PktHeaderView> headers;
+  };
+
+  void workerLoop(Queue queue);
+
+  SwSwitch* sw_;
+  PacketHandler handler_;
+  uint32_t batchSize_;
+  // A null packet tells the worker of a queue to exit
+  std::array<folly::MPMCQueue<QueuedPacket>, kNumQueues> queues_;
+  std::array<std::unique_ptr<std::thread>, kNumQueues> workers_;
+};
+
+} // namespace facebook::fboss
@@ -40,7 +40,9 @@ static void dynamicFibUpdate(
     facebook::fboss::RouterID vrf,
     const facebook::fboss::rib::IPv4NetworkToRouteMap& v4NetworkToRoute,
     const facebook::fboss::rib::IPv6NetworkToRouteMap& v6NetworkToRoute,
+    const facebook::fboss::rib::ResolutionDelta& /* delta */,
     void* cookie) {
+  // The FIB is not known to reflect the RIB yet, so always rebuild it fully
   rib::ForwardingInformationBaseUpdater fibUpdater(
       vrf, v4NetworkToRoute, v6NetworkToRoute);
 
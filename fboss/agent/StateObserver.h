@@ -24,11 +24,15 @@ class StateObserver : public boost::noncopyable {
 
 class AutoRegisterStateObserver : public StateObserver {
  public:
-  AutoRegisterStateObserver(SwSwitch* sw, const std::string& name) : sw_(sw) {
-    sw_->registerStateObserver(this, name);
+  AutoRegisterStateObserver(
+      SwSwitch* sw,
+      const std::string& name,
+      StateObserverDispatch dispatch = StateObserverDispatch::INLINE)
+      : sw_(sw) {
+    sw_->registerStateObserver(this, name, dispatch);
   }
   ~AutoRegisterStateObserver() override {
-    sw_->unregisterStateObserver(this);
+    unregisterStateObserver();
   }
 
   // This empty implementation should be overridden by subclasses, but it is
@@ -38,6 +42,17 @@ class AutoRegisterStateObserver : public StateObserver {
   // during that time if this didn't exist.
   void stateUpdated(const StateDelta& /*delta*/) override {}
 
+ protected:
+  // ASYNC observers may still be handling a delta on another thread when
+  // destruction starts. They should call this from their own destructor,
+  // which waits for that to finish, before tearing down any of their state.
+  void unregisterStateObserver() {
+    if (sw_) {
+      sw_->unregisterStateObserver(this);
+      sw_ = nullptr;
+    }
+  }
+
  private:
   SwSwitch* sw_{nullptr};
 };
@@ -13,6 +13,7 @@
 #include "fboss/agent/AlpmUtils.h"
 #include "fboss/agent/ApplyThriftConfig.h"
 #include "fboss/agent/ArpHandler.h"
+#include "fboss/agent/AsyncRouteUpdater.h"
 #include "fboss/agent/Constants.h"
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/HwSwitch.h"
@@ -38,6 +39,7 @@
 #include "fboss/agent/RestartTimeTracker.h"
 #include "fboss/agent/RouteUpdateLogger.h"
 #include "fboss/agent/RxPacket.h"
+#include "fboss/agent/RxPacketPipeline.h"
 #include "fboss/agent/StaticL2ForNeighborObserver.h"
 #include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/ThriftHandler.h"
@@ -65,6 +67,8 @@
 #include <folly/MapUtil.h>
 #include <folly/SocketAddress.h>
 #include <folly/String.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
 #include <folly/logging/xlog.h>
 #include <folly/system/ThreadName.h>
 #include <glog/logging.h>
@@ -106,6 +110,25 @@ DEFINE_int32(
     1000,
     "Timeout for sending to distribution_service (ms)");
 
+DEFINE_int32(
+    state_observer_threads,
+    4,
+    "Number of threads to notify asynchronous state observers on");
+
+DEFINE_bool(
+    rx_pipeline,
+    false,
+    "Handle trapped packets on per protocol worker threads instead of on "
+    "the HwSwitch RX callback thread");
+DEFINE_int32(
+    rx_queue_size,
+    8192,
+    "Number of packets each RX pipeline queue holds before dropping packets");
+DEFINE_int32(
+    rx_batch_size,
+    64,
+    "Max number of packets an RX pipeline worker handles per wakeup");
+
 DEFINE_bool(
     log_all_fib_updates,
     false,
@@ -159,6 +182,9 @@ namespace facebook::fboss {
 SwSwitch::SwSwitch(std::unique_ptr<Platform> platform)
     : hw_(platform->getHwSwitch()),
       platform_(std::move(platform)),
+      stateObserverExecutor_(std::make_unique<folly::CPUThreadPoolExecutor>(
+          FLAGS_state_observer_threads,
+          std::make_shared<folly::NamedThreadFactory>("StateObserver"))),
       arp_(new ArpHandler(this)),
       ipv4_(new IPv4Handler(this)),
       ipv6_(new IPv6Handler(this)),
@@ -169,6 +195,7 @@ SwSwitch::SwSwitch(std::unique_ptr<Platform> platform)
       resolvedNexthopMonitor_(new ResolvedNexthopMonitor(this)),
       resolvedNexthopProbeScheduler_(new ResolvedNexthopProbeScheduler(this)),
       rib_(new rib::RoutingInformationBase()),
+      asyncRouteUpdater_(new AsyncRouteUpdater(this)),
       portUpdateHandler_(new PortUpdateHandler(this)),
       lookupClassUpdater_(new LookupClassUpdater(this)),
       lookupClassRouteUpdater_(new LookupClassRouteUpdater(this)),
@@ -195,6 +222,12 @@ void SwSwitch::stop() {
   // while we are destroying ourselves
   hw_->unregisterCallbacks();
 
+  // Wait for the RX workers to be done with the packets already received,
+  // before tearing down the packet handlers.
+  if (rxPipeline_) {
+    rxPipeline_->stop();
+  }
+
   // Stop tunMgr so we don't get any packets to process
   // in software that were sent to the switch ip or were
   // routed from kernel to the front panel tunnel interface.
@@ -235,6 +268,8 @@ void SwSwitch::stop() {
   packetTxThreadHeartbeat_.reset();
   lacpThreadHeartbeat_.reset();
   neighborCacheThreadHeartbeat_.reset();
+  // Stop programming route updates while the update thread is still around
+  asyncRouteUpdater_.reset();
   rib_.reset();
 
   lookupClassUpdater_.reset();
@@ -418,6 +453,19 @@ void SwSwitch::publishTxPacket(TxPacket* pkt, uint16_t ethertype) {
 void SwSwitch::init(std::unique_ptr<TunManager> tunMgr, SwitchFlags flags) {
   auto begin = steady_clock::now();
   flags_ = flags;
+  if (FLAGS_rx_pipeline) {
+    // Set up before the HwSwitch starts delivering packets. Packets received
+    // before init completes are dropped by handlePacket() anyway.
+    rxPipeline_ = std::make_unique<RxPacketPipeline>(
+        this,
+        [this](
+            std::unique_ptr<RxPacket> pkt,
+            std::optional<PktHeaderView> headers) {
+          handlePacketNoThrow(std::move(pkt), std::move(headers));
+        },
+        FLAGS_rx_queue_size,
+        FLAGS_rx_batch_size);
+  }
   auto hwInitRet = hw_->init(this, false /*failHwCallsOnWarmboot*/);
   auto initialState = hwInitRet.switchState;
   // for now, warmboot is not keeping failed routes, so keep the same state as
@@ -609,10 +657,11 @@ void SwSwitch::fibSynced() {
 
 void SwSwitch::registerStateObserver(
     StateObserver* observer,
-    const string name) {
+    const string name,
+    StateObserverDispatch dispatch) {
   XLOG(DBG2) << "Registering state observer: " << name;
   updateEventBase_.runImmediatelyOrRunInEventBaseThreadAndWait(
-      [=]() { addStateObserver(observer, name); });
+      [=]() { addStateObserver(observer, name, dispatch); });
 }
 
 void SwSwitch::unregisterStateObserver(StateObserver* observer) {
@@ -627,18 +676,32 @@ bool SwSwitch::stateObserverRegistered(StateObserver* observer) {
 
 void SwSwitch::removeStateObserver(StateObserver* observer) {
   DCHECK(updateEventBase_.isInEventBaseThread());
-  auto nErased = stateObservers_.erase(observer);
-  if (!nErased) {
+  auto it = stateObservers_.find(observer);
+  if (it == stateObservers_.end()) {
     throw FbossError("State observer remove failed: observer does not exist");
   }
+  if (it->second.executor) {
+    // Let the observer finish with the deltas it was already handed before
+    // it goes away.
+    folly::via(it->second.executor.get(), []() {}).get();
+  }
+  stateObservers_.erase(it);
 }
 
-void SwSwitch::addStateObserver(StateObserver* observer, const string& name) {
+void SwSwitch::addStateObserver(
+    StateObserver* observer,
+    const string& name,
+    StateObserverDispatch dispatch) {
   DCHECK(updateEventBase_.isInEventBaseThread());
   if (stateObserverRegistered(observer)) {
     throw FbossError("State observer add failed: ", name, " already exists");
   }
-  stateObservers_.emplace(observer, name);
+  StateObserverInfo info{name, dispatch, {}};
+  if (dispatch == StateObserverDispatch::ASYNC) {
+    info.executor = folly::SerialExecutor::create(
+        folly::getKeepAliveToken(stateObserverExecutor_.get()));
+  }
+  stateObservers_.emplace(observer, std::move(info));
 }
 
 void SwSwitch::notifyStateObservers(const StateDelta& delta) {
@@ -647,18 +710,41 @@ void SwSwitch::notifyStateObservers(const StateDelta& delta) {
     // Make sure the SwSwitch is not already being destroyed
     return;
   }
-  for (auto observerName : stateObservers_) {
-    try {
-      auto observer = observerName.first;
-      observer->stateUpdated(delta);
-    } catch (const std::exception& ex) {
-      // TODO: Figure out the best way to handle errors here.
-      XLOG(FATAL) << "error notifying " << observerName.second
-                  << " of update: " << folly::exceptionStr(ex);
+  for (const auto& [observer, info] : stateObservers_) {
+    if (info.dispatch == StateObserverDispatch::ASYNC) {
+      // The delta only lives for the duration of this call, hand the
+      // observer its own one over the same states.
+      info.executor->add([this,
+                          observer = observer,
+                          name = info.name,
+                          oldState = delta.oldState(),
+                          newState = delta.newState()]() {
+        notifyStateObserver(observer, name, StateDelta(oldState, newState));
+      });
+    } else {
+      notifyStateObserver(observer, info.name, delta);
     }
   }
 }
 
+void SwSwitch::notifyStateObserver(
+    StateObserver* observer,
+    const string& name,
+    const StateDelta& delta) {
+  auto start = std::chrono::steady_clock::now();
+  try {
+    observer->stateUpdated(delta);
+  } catch (const std::exception& ex) {
+    // TODO: Figure out the best way to handle errors here.
+    XLOG(FATAL) << "error notifying " << name
+                << " of update: " << folly::exceptionStr(ex);
+  }
+  stats()->stateObserverNotified(
+      name,
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start));
+}
+
 void SwSwitch::updateState(unique_ptr<StateUpdate> update) {
   {
     folly::SpinLockGuard guard(pendingUpdatesLock_);
@@ -983,9 +1069,19 @@ void SwSwitch::setPortStatusCounter(PortID port, bool up) {
 }
 
 void SwSwitch::packetReceived(std::unique_ptr<RxPacket> pkt) noexcept {
+  if (rxPipeline_) {
+    rxPipeline_->enqueue(std::move(pkt));
+    return;
+  }
+  handlePacketNoThrow(std::move(pkt));
+}
+
+void SwSwitch::handlePacketNoThrow(
+    std::unique_ptr<RxPacket> pkt,
+    std::optional<PktHeaderView> headers) noexcept {
   PortID port = pkt->getSrcPort();
   try {
-    handlePacket(std::move(pkt));
+    handlePacket(std::move(pkt), std::move(headers));
   } catch (const std::exception& ex) {
     portStats(port)->pktError();
     XLOG(ERR) << "error processing trapped packet: " << folly::exceptionStr(ex);
@@ -999,7 +1095,9 @@ void SwSwitch::packetReceivedThrowExceptionOnError(
   handlePacket(std::move(pkt));
 }
 
-void SwSwitch::handlePacket(std::unique_ptr<RxPacket> pkt) {
+void SwSwitch::handlePacket(
+    std::unique_ptr<RxPacket> pkt,
+    std::optional<PktHeaderView> headers) {
   // If we are not fully initialized or are already exiting, don't handle
   // packets since the individual handlers, h/w sdk data structures
   // may not be ready or may already be (partially) destroyed
@@ -1020,16 +1118,20 @@ void SwSwitch::handlePacket(std::unique_ptr<RxPacket> pkt) {
     return;
   }
 
-  // Parse the source and destination MAC, as well as the ethertype.
-  Cursor c(pkt->buf());
-  auto dstMac = PktUtil::readMac(&c);
-  auto srcMac = PktUtil::readMac(&c);
-  auto ethertype = c.readBE<uint16_t>();
-  if (ethertype == 0x8100) {
-    // 802.1Q
-    c += 2; // Advance over the VLAN tag.  We ignore it for now
-    ethertype = c.readBE<uint16_t>();
+  // Parse the source and destination MAC, as well as the ethertype, unless
+  // the RX pipeline already did so.
+  if (!headers) {
+    headers = PktHeaderView::parse(pkt->buf());
   }
+  if (!headers) {
+    portStats(port)->pktBogus();
+    return;
+  }
+  // We ignore the VLAN tag for now
+  auto dstMac = headers->dstMac;
+  auto srcMac = headers->srcMac;
+  auto ethertype = headers->etherType;
+  auto c = headers->l3Cursor(pkt->buf());
 
   XLOG(DBG5) << "trapped packet: src_port=" << pkt->getSrcPort()
              << " srcAggPort="
@@ -1190,6 +1292,7 @@ void SwSwitch::stopThreads() {
   if (neighborCacheThread_) {
     neighborCacheThread_->join();
   }
+  stateObserverExecutor_->join();
 
   platform_->stop();
 }
@@ -1493,15 +1596,25 @@ void SwSwitch::applyConfig(const std::string& reason, bool reload) {
         auto target = reload ? platform_->reloadConfig() : platform_->config();
 
         const auto& newConfig = *target->thrift.sw_ref();
-        auto newState = applyThriftConfig(
-            state,
-            &newConfig,
-            getPlatform(),
-            (getFlags() & SwitchFlags::ENABLE_STANDALONE_RIB) ? getRib()
-                                                              : nullptr);
-
-        if (newState && !isValidStateUpdate(StateDelta(state, newState))) {
-          throw FbossError("Invalid config passed in, skipping");
+        bool standaloneRib = getFlags() & SwitchFlags::ENABLE_STANDALONE_RIB;
+        shared_ptr<SwitchState> newState;
+        try {
+          newState = applyThriftConfig(
+              state,
+              &newConfig,
+              getPlatform(),
+              standaloneRib ? getRib() : nullptr);
+
+          if (newState && !isValidStateUpdate(StateDelta(state, newState))) {
+            throw FbossError("Invalid config passed in, skipping");
+          }
+        } catch (const std::exception&) {
+          // The RIB may already have been reconfigured, with its FIB changes
+          // only applied to the state being discarded
+          if (standaloneRib) {
+            getRib()->resyncFibs();
+          }
+          throw;
         }
 
         // Update config cached in SwSwitch. Update this even if the config did
@@ -14,6 +14,7 @@
 #include "fboss/agent/Utils.h"
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 #include "fboss/agent/if/gen-cpp2/ctrl_types.h"
+#include "fboss/agent/packet/PktHeaderView.h"
 #include "fboss/agent/rib/RoutingInformationBase.h"
 #include "fboss/agent/state/StateUpdate.h"
 #include "fboss/agent/types.h"
@@ -22,6 +23,8 @@
 #include <folly/Range.h>
 #include <folly/SpinLock.h>
 #include <folly/ThreadLocal.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/SerialExecutor.h>
 #include <folly/io/async/EventBase.h>
 #include <optional>
 
@@ -34,6 +37,7 @@
 namespace facebook::fboss {
 
 class ArpHandler;
+class AsyncRouteUpdater;
 class IPv4Handler;
 class IPv6Handler;
 class LinkAggregationManager;
@@ -50,6 +54,7 @@ class SwitchStats;
 class StateDelta;
 class NeighborUpdater;
 class RouteUpdateLogger;
+class RxPacketPipeline;
 class StateObserver;
 class TunManager;
 class MirrorManager;
@@ -61,6 +66,23 @@ class ResolvedNexthopProbeScheduler;
 class StaticL2ForNeighborObserver;
 class MKAServiceManager;
 
+/*
+ * How a StateObserver gets notified of state updates.
+ *
+ * INLINE observers are called on the update thread, one after the other,
+ * before the next state update gets applied.
+ *
+ * ASYNC observers are called on a shared thread pool instead, so that they
+ * don't hold up the update thread. Each ASYNC observer still sees every
+ * delta, one at a time and in the order the updates were applied, but may
+ * run concurrently with other observers and with later state updates. They
+ * must therefore not rely on running on the update thread, nor block on it.
+ */
+enum class StateObserverDispatch {
+  INLINE,
+  ASYNC,
+};
+
 enum class SwitchFlags : int {
   DEFAULT = 0,
   ENABLE_TUN = 1,
@@ -282,10 +304,14 @@ class SwSwitch : public HwSwitch::Callback {
    * all state updates that occur and all classes that care about state updates
    * should register using this api.
    *
-   * The only required method for observers is stateUpdated and observers can
-   * count on this always being called from the update thread.
+   * The only required method for observers is stateUpdated. Unless the
+   * observer registers for ASYNC dispatch, it can count on this always being
+   * called from the update thread.
    */
-  void registerStateObserver(StateObserver* observer, const std::string name);
+  void registerStateObserver(
+      StateObserver* observer,
+      const std::string name,
+      StateObserverDispatch dispatch = StateObserverDispatch::INLINE);
   void unregisterStateObserver(StateObserver* observer);
 
   /*
@@ -583,6 +609,15 @@ class SwSwitch : public HwSwitch::Callback {
     return rib_.get();
   }
 
+  /*
+   * Applies route updates to the standalone RIB without waiting for them
+   * to be programmed.
+   */
+  AsyncRouteUpdater* getAsyncRouteUpdater() {
+    DCHECK(isStandaloneRibEnabled());
+    return asyncRouteUpdater_.get();
+  }
+
   /*
    * Gets the flags the SwSwitch was initialized with.
    */
@@ -729,7 +764,17 @@ class SwSwitch : public HwSwitch::Callback {
   void publishSwitchInfo(struct HwInitResult hwInitRet);
   void setSwitchRunState(SwitchRunState desiredState);
   SwitchStats* createSwitchStats();
-  void handlePacket(std::unique_ptr<RxPacket> pkt);
+  /*
+   * Dispatch a trapped packet to its protocol handler. headers are the
+   * packet's parsed headers if the caller already has them, they are parsed
+   * here otherwise.
+   */
+  void handlePacket(
+      std::unique_ptr<RxPacket> pkt,
+      std::optional<PktHeaderView> headers = std::nullopt);
+  void handlePacketNoThrow(
+      std::unique_ptr<RxPacket> pkt,
+      std::optional<PktHeaderView> headers = std::nullopt) noexcept;
 
   static void handlePendingUpdatesHelper(SwSwitch* sw);
   void handlePendingUpdates();
@@ -747,7 +792,10 @@ class SwSwitch : public HwSwitch::Callback {
    * called from the update thread, if the update thread is running.
    */
   bool stateObserverRegistered(StateObserver* observer);
-  void addStateObserver(StateObserver* observer, const std::string& name);
+  void addStateObserver(
+      StateObserver* observer,
+      const std::string& name,
+      StateObserverDispatch dispatch);
   void removeStateObserver(StateObserver* observer);
 
   /*
@@ -763,6 +811,10 @@ class SwSwitch : public HwSwitch::Callback {
    * Notifies all the observers that a state update occured.
    */
   void notifyStateObservers(const StateDelta& delta);
+  void notifyStateObserver(
+      StateObserver* observer,
+      const std::string& name,
+      const StateDelta& delta);
 
   void logLinkStateEvent(PortID port, bool up);
 
@@ -781,6 +833,11 @@ class SwSwitch : public HwSwitch::Callback {
   // The HwSwitch object.  This object is owned by the Platform.
   HwSwitch* hw_;
   std::unique_ptr<Platform> platform_;
+  /*
+   * Thread pool that ASYNC state observers are notified on. Declared ahead
+   * of stateObservers_, which hold on to it.
+   */
+  std::unique_ptr<folly::CPUThreadPoolExecutor> stateObserverExecutor_;
   std::atomic<SwitchRunState> runState_{SwitchRunState::UNINITIALIZED};
   folly::ThreadLocalPtr<SwitchStats, SwSwitch> stats_;
   /**
@@ -878,8 +935,19 @@ class SwSwitch : public HwSwitch::Callback {
    * be accessed/modified from the update thread. This removes the need for
    * locking when we access the container during a state update.
    */
-  std::map<StateObserver*, std::string> stateObservers_;
+  struct StateObserverInfo {
+    std::string name;
+    StateObserverDispatch dispatch;
+    // Notifies an ASYNC observer of one delta at a time, in order
+    folly::Executor::KeepAlive<folly::SerialExecutor> executor;
+  };
+  std::map<StateObserver*, StateObserverInfo> stateObservers_;
 
+  /*
+   * Hands trapped packets off from the HwSwitch RX callback to per protocol
+   * worker threads. Null if packets are handled on the RX callback thread.
+   */
+  std::unique_ptr<RxPacketPipeline> rxPipeline_;
   std::unique_ptr<ArpHandler> arp_;
   std::unique_ptr<IPv4Handler> ipv4_;
   std::unique_ptr<IPv6Handler> ipv6_;
@@ -891,6 +959,7 @@ class SwSwitch : public HwSwitch::Callback {
   std::unique_ptr<ResolvedNexthopMonitor> resolvedNexthopMonitor_;
   std::unique_ptr<ResolvedNexthopProbeScheduler> resolvedNexthopProbeScheduler_;
   std::unique_ptr<rib::RoutingInformationBase> rib_{nullptr};
+  std::unique_ptr<AsyncRouteUpdater> asyncRouteUpdater_;
 
   BootType bootType_{BootType::UNINITIALIZED};
   std::unique_ptr<LldpManager> lldpManager_;
@@ -9,6 +9,7 @@
  */
 #include "fboss/agent/SwitchStats.h"
 
+#include <folly/Conv.h>
 #include <folly/Memory.h>
 #include "fboss/agent/PortStats.h"
 
@@ -170,6 +171,24 @@ SwitchStats::SwitchStats(ThreadLocalStatsMap* map)
           AVG,
           50,
           100),
+      macLearningBatchSize_(
+          map,
+          kCounterPrefix + "mac_learning.batch_size",
+          10,
+          0,
+          1000,
+          AVG,
+          50,
+          100),
+      macLearningQueueDelay_(
+          map,
+          kCounterPrefix + "mac_learning.queue_delay.us",
+          1000,
+          0,
+          100000,
+          AVG,
+          50,
+          100),
       linkStateChange_(map, kCounterPrefix + "link_state.flap", SUM),
       pcapDistFailure_(map, kCounterPrefix + "pcap_dist_failure.error"),
       updateStatsExceptions_(
@@ -235,6 +254,84 @@ SwitchStats::aggregatePort(AggregatePortID aggregatePortID) {
   return it == aggregatePortIDToStats_.end() ? nullptr : it->second.get();
 }
 
+void SwitchStats::stateObserverNotified(
+    const std::string& observer,
+    std::chrono::microseconds us) {
+  auto it = stateObserverLatency_.find(observer);
+  if (it == stateObserverLatency_.end()) {
+    it = stateObserverLatency_
+             .emplace(
+                 observer,
+                 std::make_unique<TLHistogram>(
+                     fb303::ThreadCachedServiceData::get()->getThreadStats(),
+                     folly::to<std::string>(
+                         kCounterPrefix, "state_observer.", observer, ".us"),
+                     1000,
+                     0,
+                     100000,
+                     AVG,
+                     50,
+                     100))
+             .first;
+  }
+  it->second->addValue(us.count());
+}
+
+SwitchStats::RxQueueStats::RxQueueStats(
+    ThreadLocalStatsMap* map,
+    const std::string& queue)
+    : drops(
+          map,
+          folly::to<std::string>(kCounterPrefix, "rx_queue.", queue, ".drops"),
+          SUM,
+          RATE),
+      batchSize(
+          map,
+          folly::to<std::string>(
+              kCounterPrefix, "rx_queue.", queue, ".batch_size"),
+          10,
+          0,
+          1000,
+          AVG,
+          50,
+          100),
+      depth(
+          map,
+          folly::to<std::string>(kCounterPrefix, "rx_queue.", queue, ".depth"),
+          100,
+          0,
+          10000,
+          AVG,
+          50,
+          100) {}
+
+SwitchStats::RxQueueStats* SwitchStats::rxQueueStats(const std::string& queue) {
+  auto it = rxQueueStats_.find(queue);
+  if (it == rxQueueStats_.end()) {
+    it = rxQueueStats_
+             .emplace(
+                 queue,
+                 std::make_unique<RxQueueStats>(
+                     fb303::ThreadCachedServiceData::get()->getThreadStats(),
+                     queue))
+             .first;
+  }
+  return it->second.get();
+}
+
+void SwitchStats::rxQueueDrop(const std::string& queue) {
+  rxQueueStats(queue)->drops.addValue(1);
+}
+
+void SwitchStats::rxQueueBatch(
+    const std::string& queue,
+    uint64_t batchSize,
+    uint64_t queueDepth) {
+  auto stats = rxQueueStats(queue);
+  stats->batchSize.addValue(batchSize);
+  stats->depth.addValue(queueDepth);
+}
+
 PortStats* SwitchStats::createPortStats(PortID portID, std::string portName) {
   auto rv = ports_.emplace(
       portID, std::make_unique<PortStats>(portID, portName, this));
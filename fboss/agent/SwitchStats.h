@@ -13,6 +13,9 @@
 #include <boost/noncopyable.hpp>
 #include <fb303/ThreadCachedServiceData.h>
 #include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include "fboss/agent/AggregatePortStats.h"
 #include "fboss/agent/PortStats.h"
 #include "fboss/agent/types.h"
@@ -274,6 +277,25 @@ class SwitchStats : public boost::noncopyable {
     neighborCacheEventBacklog_.addValue(value);
   }
 
+  void stateObserverNotified(
+      const std::string& observer,
+      std::chrono::microseconds us);
+
+  /*
+   * Stats of the RX pipeline queues, indexed by queue name. See
+   * RxPacketPipeline.
+   */
+  void rxQueueDrop(const std::string& queue);
+  void rxQueueBatch(
+      const std::string& queue,
+      uint64_t batchSize,
+      uint64_t queueDepth);
+
+  void macLearningBatch(uint64_t batchSize, std::chrono::microseconds delay) {
+    macLearningBatchSize_.addValue(batchSize);
+    macLearningQueueDelay_.addValue(delay.count());
+  }
+
   void linkStateChange() {
     linkStateChange_.addValue(1);
   }
@@ -489,6 +511,37 @@ class SwitchStats : public boost::noncopyable {
    */
   TLHistogram neighborCacheEventBacklog_;
 
+  /**
+   * Number of L2 learn/age events applied per MAC table update
+   */
+  TLHistogram macLearningBatchSize_;
+  /**
+   * Time from the first L2 event of a batch being queued to the batch
+   * being applied (us)
+   */
+  TLHistogram macLearningQueueDelay_;
+
+  /**
+   * Time taken by each state observer to process a state update (us),
+   * indexed by observer name
+   */
+  std::unordered_map<std::string, std::unique_ptr<TLHistogram>>
+      stateObserverLatency_;
+
+  struct RxQueueStats {
+    RxQueueStats(ThreadLocalStatsMap* map, const std::string& queue);
+
+    // Packets dropped because the queue was full
+    TLTimeseries drops;
+    // Packets handled per wakeup of the queue worker
+    TLHistogram batchSize;
+    // Packets left in the queue when the worker took a batch
+    TLHistogram depth;
+  };
+  RxQueueStats* rxQueueStats(const std::string& queue);
+
+  std::unordered_map<std::string, std::unique_ptr<RxQueueStats>> rxQueueStats_;
+
   /**
    * Link state up/down change count
    */
@@ -12,6 +12,7 @@
 #include "common/logging/logging.h"
 #include "fboss/agent/AddressUtil.h"
 #include "fboss/agent/ArpHandler.h"
+#include "fboss/agent/AsyncRouteUpdater.h"
 #include "fboss/agent/HwSwitch.h"
 #include "fboss/agent/IPv6Handler.h"
 #include "fboss/agent/LinkAggregationManager.h"
@@ -64,7 +65,11 @@
 #include <thrift/lib/cpp/util/EnumUtils.h>
 #include <thrift/lib/cpp2/async/DuplexChannel.h>
 
+#include <algorithm>
+#include <chrono>
 #include <limits>
+#include <optional>
+#include <type_traits>
 
 using apache::thrift::ClientReceiveState;
 using apache::thrift::server::TConnectionContext;
@@ -97,6 +102,14 @@ DEFINE_bool(
     enable_running_config_mutations,
     false,
     "Allow external mutations of running config");
+DEFINE_int32(
+    route_table_cursor_idle_s,
+    60,
+    "Seconds after which an unused route table page cursor expires");
+DEFINE_uint32(
+    route_table_max_cursors,
+    16,
+    "Max number of route table walks by page in progress at once");
 
 namespace facebook::fboss {
 
@@ -139,9 +152,10 @@ void dynamicFibUpdate(
     facebook::fboss::RouterID vrf,
     const facebook::fboss::rib::IPv4NetworkToRouteMap& v4NetworkToRoute,
     const facebook::fboss::rib::IPv6NetworkToRouteMap& v6NetworkToRoute,
+    const facebook::fboss::rib::ResolutionDelta& delta,
     void* cookie) {
   facebook::fboss::rib::ForwardingInformationBaseUpdater fibUpdater(
-      vrf, v4NetworkToRoute, v6NetworkToRoute);
+      vrf, v4NetworkToRoute, v6NetworkToRoute, delta);
 
   auto sw = static_cast<facebook::fboss::SwSwitch*>(cookie);
   sw->updateStateBlocking("", std::move(fibUpdater));
@@ -495,6 +509,177 @@ class RouteUpdateStats {
   std::chrono::time_point<std::chrono::steady_clock> start_;
 };
 
+/*
+ * RouteTableCursor walks the routes of a SwitchState snapshot, in order of
+ * RouterID, address family and prefix, a bounded number of routes at a time.
+ * This lets the route table APIs return large route tables in pages, each
+ * page converting only the routes it returns.
+ *
+ * The cursor holds on to the snapshot, so all the pages of a walk see the
+ * same routes regardless of route updates in between.
+ */
+class RouteTableCursor {
+ public:
+  RouteTableCursor(
+      std::shared_ptr<SwitchState> state,
+      const RouteTableFilter& filter)
+      : state_(std::move(state)), lastUsed_(steady_clock::now()) {
+    if (filter.clientId_ref()) {
+      client_ = ClientID(*filter.clientId_ref());
+    }
+    if (filter.prefix_ref()) {
+      // Routes are compared against the network of the filter, so host bits
+      // in the filter address are ignored
+      auto prefixLength = filter.prefix_ref()->prefixLength;
+      prefix_ = folly::CIDRNetwork(
+          toIPAddress(filter.prefix_ref()->ip).mask(prefixLength),
+          prefixLength);
+    }
+  }
+
+  /*
+   * Append up to maxRoutes routes to routes. Without a client filter only
+   * resolved routes are returned, along with their forwarding next hops.
+   * With one, routes are returned along with that client's next hops.
+   *
+   * Returns true once all the routes have been returned.
+   */
+  bool nextRoutes(size_t maxRoutes, std::vector<UnicastRoute>* routes) {
+    return walk(maxRoutes, [this, routes](const auto& route) {
+      return appendRoute(route, routes);
+    });
+  }
+
+  bool nextRouteDetails(size_t maxRoutes, std::vector<RouteDetails>* routes) {
+    return walk(maxRoutes, [routes](const auto& route) {
+      routes->emplace_back(route.toRouteDetails());
+      return true;
+    });
+  }
+
+  steady_clock::time_point lastUsed() const {
+    return lastUsed_;
+  }
+
+ private:
+  template <typename Fn>
+  bool walk(size_t maxRoutes, Fn fn) {
+    lastUsed_ = steady_clock::now();
+    size_t numRoutes = 0;
+    const auto& tables = state_->getRouteTables()->getAllNodes();
+    auto it = routerID_ ? tables.lower_bound(*routerID_) : tables.begin();
+    for (; it != tables.end(); ++it) {
+      if (routerID_ != it->first) {
+        routerID_ = it->first;
+        doneV4_ = false;
+        lastV4_.reset();
+        lastV6_.reset();
+      }
+      if (!doneV4_) {
+        if (!walkRib(
+                *it->second->getRibV4()->routes(),
+                lastV4_,
+                maxRoutes,
+                numRoutes,
+                fn)) {
+          return false;
+        }
+        doneV4_ = true;
+      }
+      if (!walkRib(
+              *it->second->getRibV6()->routes(),
+              lastV6_,
+              maxRoutes,
+              numRoutes,
+              fn)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Returns false if the page filled up before reaching the end of routes.
+  template <typename AddrT, typename Fn>
+  bool walkRib(
+      const RouteTableRibNodeMap<AddrT>& routes,
+      std::optional<RoutePrefix<AddrT>>& last,
+      size_t maxRoutes,
+      size_t& numRoutes,
+      Fn& fn) {
+    constexpr bool kIsV4 = std::is_same_v<AddrT, IPAddressV4>;
+    if (prefix_ && prefix_->first.isV4() != kIsV4) {
+      return true;
+    }
+    const auto& nodes = routes.getAllNodes();
+    for (auto it = last ? nodes.upper_bound(*last) : nodes.begin();
+         it != nodes.end();
+         ++it) {
+      if (numRoutes == maxRoutes) {
+        return false;
+      }
+      const auto& route = *it->second;
+      last = route.prefix();
+      if (matches(route) && fn(route)) {
+        ++numRoutes;
+      }
+    }
+    return true;
+  }
+
+  template <typename AddrT>
+  bool matches(const Route<AddrT>& route) const {
+    if (prefix_) {
+      const auto& prefix = route.prefix();
+      if (prefix.mask < prefix_->second ||
+          IPAddress(prefix.network.mask(prefix_->second)) != prefix_->first) {
+        return false;
+      }
+    }
+    return !client_ || route.getEntryForClient(*client_);
+  }
+
+  template <typename AddrT>
+  bool appendRoute(
+      const Route<AddrT>& route,
+      std::vector<UnicastRoute>* routes) const {
+    UnicastRoute tempRoute;
+    tempRoute.dest.ip = toBinaryAddress(route.prefix().network);
+    tempRoute.dest.prefixLength = route.prefix().mask;
+    if (client_) {
+      *tempRoute.nextHops_ref() = util::fromRouteNextHopSet(
+          route.getEntryForClient(*client_)->getNextHopSet());
+      for (const auto& nh : *tempRoute.nextHops_ref()) {
+        tempRoute.nextHopAddrs_ref()->emplace_back(*nh.address_ref());
+      }
+    } else {
+      if (!route.isResolved()) {
+        XLOG(INFO) << "Skipping unresolved route: " << route.toFollyDynamic();
+        return false;
+      }
+      const auto& fwdInfo = route.getForwardInfo();
+      *tempRoute.nextHopAddrs_ref() =
+          util::fromFwdNextHops(fwdInfo.getNextHopSet());
+      *tempRoute.nextHops_ref() =
+          util::fromRouteNextHopSet(fwdInfo.getNextHopSet());
+    }
+    routes->emplace_back(std::move(tempRoute));
+    return true;
+  }
+
+  const std::shared_ptr<SwitchState> state_;
+  std::optional<ClientID> client_;
+  std::optional<folly::CIDRNetwork> prefix_;
+
+  // Position of the walk: the route table being walked, whether its v4
+  // routes are done, and the last prefix visited in each address family.
+  std::optional<RouterID> routerID_;
+  bool doneV4_{false};
+  std::optional<RoutePrefixV4> lastV4_;
+  std::optional<RoutePrefixV6> lastV6_;
+
+  steady_clock::time_point lastUsed_;
+};
+
 ThriftHandler::ThriftHandler(SwSwitch* sw) : FacebookBase2("FBOSS"), sw_(sw) {
   if (sw) {
     sw->registerNeighborListener([=](const std::vector<std::string>& added,
@@ -698,6 +883,70 @@ void ThriftHandler::syncFib(
   syncFibInVrf(client, std::move(routes), 0);
 }
 
+int64_t ThriftHandler::updateUnicastRoutesAsync(
+    int16_t client,
+    std::unique_ptr<std::vector<UnicastRoute>> toAdd,
+    std::unique_ptr<std::vector<IpPrefix>> toDelete,
+    int32_t vrf,
+    bool syncFib) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  if (!syncFib) {
+    ensureFibSynced(__func__);
+  }
+  if (!sw_->isStandaloneRibEnabled()) {
+    throw FbossError("Async route updates only supported with Stand-Alone RIB");
+  }
+
+  rib::RoutingInformationBase::UpdateStatistics stats;
+  auto generation = sw_->getAsyncRouteUpdater()->update(
+      RouterID(vrf),
+      ClientID(client),
+      sw_->clientIdToAdminDistance(client),
+      *toAdd,
+      *toDelete,
+      syncFib,
+      "updateUnicastRoutesAsync",
+      &stats);
+
+  sw_->stats()->addRoutesV4(stats.v4RoutesAdded);
+  sw_->stats()->addRoutesV6(stats.v6RoutesAdded);
+  sw_->stats()->delRoutesV4(stats.v4RoutesDeleted);
+  sw_->stats()->delRoutesV6(stats.v6RoutesDeleted);
+
+  auto totalRouteCount = stats.v4RoutesAdded + stats.v6RoutesAdded +
+      stats.v4RoutesDeleted + stats.v6RoutesDeleted;
+  sw_->stats()->routeUpdate(stats.duration, totalRouteCount);
+  XLOG(DBG0) << "Async update of " << totalRouteCount << " routes took "
+             << stats.duration.count() << "us, generation " << generation;
+
+  if (syncFib && !sw_->isFibSynced()) {
+    sw_->fibSynced();
+  }
+  return generation;
+}
+
+bool ThriftHandler::waitForRouteGeneration(
+    int64_t generation,
+    int32_t timeoutMs) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  if (!sw_->isStandaloneRibEnabled()) {
+    throw FbossError("Async route updates only supported with Stand-Alone RIB");
+  }
+  return sw_->getAsyncRouteUpdater()->waitForGeneration(
+      generation, std::chrono::milliseconds(std::max(timeoutMs, 0)));
+}
+
+int64_t ThriftHandler::getProgrammedRouteGeneration() {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  if (!sw_->isStandaloneRibEnabled()) {
+    throw FbossError("Async route updates only supported with Stand-Alone RIB");
+  }
+  return sw_->getAsyncRouteUpdater()->getProgrammedGeneration();
+}
+
 void ThriftHandler::updateUnicastRoutesImpl(
     int32_t vrf,
     int16_t client,
@@ -1214,39 +1463,8 @@ void ThriftHandler::setPortState(int32_t portNum, bool enable) {
 void ThriftHandler::getRouteTable(std::vector<UnicastRoute>& routes) {
   auto log = LOG_THRIFT_CALL(DBG1);
   ensureConfigured(__func__);
-  auto appliedState = sw_->getAppliedState();
-  for (const auto& routeTable : (*appliedState->getRouteTables())) {
-    for (const auto& ipv4 : *(routeTable->getRibV4()->routes())) {
-      UnicastRoute tempRoute;
-      if (!ipv4->isResolved()) {
-        XLOG(INFO) << "Skipping unresolved route: " << ipv4->toFollyDynamic();
-        continue;
-      }
-      auto fwdInfo = ipv4->getForwardInfo();
-      tempRoute.dest.ip = toBinaryAddress(ipv4->prefix().network);
-      tempRoute.dest.prefixLength = ipv4->prefix().mask;
-      *tempRoute.nextHopAddrs_ref() =
-          util::fromFwdNextHops(fwdInfo.getNextHopSet());
-      *tempRoute.nextHops_ref() =
-          util::fromRouteNextHopSet(fwdInfo.getNextHopSet());
-      routes.emplace_back(std::move(tempRoute));
-    }
-    for (const auto& ipv6 : *(routeTable->getRibV6()->routes())) {
-      UnicastRoute tempRoute;
-      if (!ipv6->isResolved()) {
-        XLOG(INFO) << "Skipping unresolved route: " << ipv6->toFollyDynamic();
-        continue;
-      }
-      auto fwdInfo = ipv6->getForwardInfo();
-      tempRoute.dest.ip = toBinaryAddress(ipv6->prefix().network);
-      tempRoute.dest.prefixLength = ipv6->prefix().mask;
-      *tempRoute.nextHopAddrs_ref() =
-          util::fromFwdNextHops(fwdInfo.getNextHopSet());
-      *tempRoute.nextHops_ref() =
-          util::fromRouteNextHopSet(fwdInfo.getNextHopSet());
-      routes.emplace_back(std::move(tempRoute));
-    }
-  }
+  RouteTableCursor(sw_->getAppliedState(), RouteTableFilter())
+      .nextRoutes(std::numeric_limits<size_t>::max(), &routes);
 }
 
 void ThriftHandler::getRouteTableByClient(
@@ -1254,58 +1472,91 @@ void ThriftHandler::getRouteTableByClient(
     int16_t client) {
   auto log = LOG_THRIFT_CALL(DBG1);
   ensureConfigured(__func__);
-  auto state = sw_->getState();
-  for (const auto& routeTable : (*state->getRouteTables())) {
-    for (const auto& ipv4 : *(routeTable->getRibV4()->routes())) {
-      auto entry = ipv4->getEntryForClient(ClientID(client));
-      if (not entry) {
-        continue;
-      }
-
-      UnicastRoute tempRoute;
-      tempRoute.dest.ip = toBinaryAddress(ipv4->prefix().network);
-      tempRoute.dest.prefixLength = ipv4->prefix().mask;
-      *tempRoute.nextHops_ref() =
-          util::fromRouteNextHopSet(entry->getNextHopSet());
-      for (const auto& nh : *tempRoute.nextHops_ref()) {
-        tempRoute.nextHopAddrs_ref()->emplace_back(*nh.address_ref());
-      }
-      routes.emplace_back(std::move(tempRoute));
-    }
+  RouteTableFilter filter;
+  filter.clientId_ref() = client;
+  RouteTableCursor(sw_->getState(), filter)
+      .nextRoutes(std::numeric_limits<size_t>::max(), &routes);
+}
 
-    for (const auto& ipv6 : *(routeTable->getRibV6()->routes())) {
-      auto entry = ipv6->getEntryForClient(ClientID(client));
-      if (not entry) {
-        continue;
-      }
+void ThriftHandler::getRouteTableDetails(std::vector<RouteDetails>& routes) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  RouteTableCursor(sw_->getState(), RouteTableFilter())
+      .nextRouteDetails(std::numeric_limits<size_t>::max(), &routes);
+}
 
-      UnicastRoute tempRoute;
-      tempRoute.dest.ip = toBinaryAddress(ipv6->prefix().network);
-      tempRoute.dest.prefixLength = ipv6->prefix().mask;
-      *tempRoute.nextHops_ref() =
-          util::fromRouteNextHopSet(entry->getNextHopSet());
-      for (const auto& nh : *tempRoute.nextHops_ref()) {
-        tempRoute.nextHopAddrs_ref()->emplace_back(*nh.address_ref());
-      }
-      routes.emplace_back(std::move(tempRoute));
-    }
-  }
+void ThriftHandler::getRouteTablePage(
+    RouteTablePage& page,
+    int64_t cursor,
+    int32_t maxRoutes,
+    std::unique_ptr<RouteTableFilter> filter) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  auto routeCursor = checkoutRouteTableCursor(cursor, maxRoutes, *filter);
+  *page.cursor_ref() = routeCursor->nextRoutes(maxRoutes, &*page.routes_ref())
+      ? 0
+      : checkinRouteTableCursor(cursor, std::move(routeCursor));
 }
 
-void ThriftHandler::getRouteTableDetails(std::vector<RouteDetails>& routes) {
+void ThriftHandler::getRouteTableDetailsPage(
+    RouteDetailsPage& page,
+    int64_t cursor,
+    int32_t maxRoutes,
+    std::unique_ptr<RouteTableFilter> filter) {
   auto log = LOG_THRIFT_CALL(DBG1);
   ensureConfigured(__func__);
-  auto state = sw_->getState();
-  for (const auto& routeTable : *(state->getRouteTables())) {
-    for (const auto& ipv4 : *(routeTable->getRibV4()->routes())) {
-      RouteDetails rd = ipv4->toRouteDetails();
-      routes.emplace_back(std::move(rd));
+  auto routeCursor = checkoutRouteTableCursor(cursor, maxRoutes, *filter);
+  *page.cursor_ref() =
+      routeCursor->nextRouteDetails(maxRoutes, &*page.routes_ref())
+      ? 0
+      : checkinRouteTableCursor(cursor, std::move(routeCursor));
+}
+
+std::shared_ptr<RouteTableCursor> ThriftHandler::checkoutRouteTableCursor(
+    int64_t cursor,
+    int32_t maxRoutes,
+    const RouteTableFilter& filter) {
+  if (maxRoutes <= 0) {
+    throw FbossError("maxRoutes must be positive, got ", maxRoutes);
+  }
+  auto cursors = routeTableCursors_.wlock();
+  // Expire idle cursors, whose clients presumably went away mid-walk
+  auto expiry = steady_clock::now() - seconds(FLAGS_route_table_cursor_idle_s);
+  for (auto it = cursors->cursors.begin(); it != cursors->cursors.end();) {
+    if (it->second->lastUsed() < expiry) {
+      it = cursors->cursors.erase(it);
+    } else {
+      ++it;
     }
-    for (const auto& ipv6 : *(routeTable->getRibV6()->routes())) {
-      RouteDetails rd = ipv6->toRouteDetails();
-      routes.emplace_back(std::move(rd));
+  }
+
+  if (cursor == 0) {
+    if (cursors->cursors.size() >= FLAGS_route_table_max_cursors) {
+      throw FbossError(
+          "Too many route table walks in progress: ", cursors->cursors.size());
     }
+    return std::make_shared<RouteTableCursor>(sw_->getState(), filter);
+  }
+  // The cursor is taken out of the map while it is in use, so that concurrent
+  // calls with the same cursor do not walk it at the same time.
+  auto it = cursors->cursors.find(cursor);
+  if (it == cursors->cursors.end()) {
+    throw FbossError("Unknown or expired route table cursor: ", cursor);
+  }
+  auto routeCursor = std::move(it->second);
+  cursors->cursors.erase(it);
+  return routeCursor;
+}
+
+int64_t ThriftHandler::checkinRouteTableCursor(
+    int64_t cursor,
+    std::shared_ptr<RouteTableCursor> routeCursor) {
+  auto cursors = routeTableCursors_.wlock();
+  if (cursor == 0) {
+    cursor = cursors->nextCursor++;
   }
+  cursors->cursors.emplace(cursor, std::move(routeCursor));
+  return cursor;
 }
 
 void ThriftHandler::getIpRoute(
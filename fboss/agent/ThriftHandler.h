@@ -12,6 +12,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "common/fb303/cpp/FacebookBase2.h"
@@ -31,6 +32,7 @@ namespace facebook::fboss {
 
 class AggregatePort;
 class Port;
+class RouteTableCursor;
 class SwSwitch;
 class Vlan;
 class SwitchState;
@@ -97,6 +99,15 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
       std::unique_ptr<std::vector<UnicastRoute>> routes,
       int32_t vrf) override;
 
+  int64_t updateUnicastRoutesAsync(
+      int16_t client,
+      std::unique_ptr<std::vector<UnicastRoute>> toAdd,
+      std::unique_ptr<std::vector<IpPrefix>> toDelete,
+      int32_t vrf,
+      bool syncFib) override;
+  bool waitForRouteGeneration(int64_t generation, int32_t timeoutMs) override;
+  int64_t getProgrammedRouteGeneration() override;
+
   /* MPLS routes */
   void addMplsRoutes(
       int16_t clientId,
@@ -165,6 +176,16 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
       std::vector<UnicastRoute>& routeTable,
       int16_t clientId) override;
   void getRouteTableDetails(std::vector<RouteDetails>& routeTable) override;
+  void getRouteTablePage(
+      RouteTablePage& page,
+      int64_t cursor,
+      int32_t maxRoutes,
+      std::unique_ptr<RouteTableFilter> filter) override;
+  void getRouteTableDetailsPage(
+      RouteDetailsPage& page,
+      int64_t cursor,
+      int32_t maxRoutes,
+      std::unique_ptr<RouteTableFilter> filter) override;
 
   void getPortStatus(
       std::map<int32_t, PortStatus>& status,
@@ -371,6 +392,20 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
 
   void fillPortStats(PortInfoThrift& portInfo, int numPortQs = 0);
 
+  /*
+   * Take the cursor of a route table walk by page out of
+   * routeTableCursors_, or start a new walk if cursor is 0, and put it back
+   * once the page is filled. checkinRouteTableCursor() returns the cursor ID
+   * to get the next page with.
+   */
+  std::shared_ptr<RouteTableCursor> checkoutRouteTableCursor(
+      int64_t cursor,
+      int32_t maxRoutes,
+      const RouteTableFilter& filter);
+  int64_t checkinRouteTableCursor(
+      int64_t cursor,
+      std::shared_ptr<RouteTableCursor> routeCursor);
+
   Vlan* getVlan(int32_t vlanId);
   Vlan* getVlan(const std::string& vlanName);
   template <typename ADDR_TYPE, typename ADDR_CONVERTER>
@@ -398,6 +433,12 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
   int thriftIdleTimeout_;
   std::vector<const TConnectionContext*> brokenClients_;
 
+  struct RouteTableCursors {
+    int64_t nextCursor{1};
+    std::unordered_map<int64_t, std::shared_ptr<RouteTableCursor>> cursors;
+  };
+  folly::Synchronized<RouteTableCursors> routeTableCursors_;
+
   apache::thrift::SSLPolicy sslPolicy_;
 };
 
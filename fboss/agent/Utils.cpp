@@ -9,6 +9,7 @@
  */
 #include "fboss/agent/Utils.h"
 
+#include <fcntl.h>
 #include <sys/resource.h>
 #include <sys/syscall.h>
 
@@ -18,13 +19,19 @@
 #include "fboss/agent/state/InterfaceMap.h"
 #include "fboss/agent/state/SwitchState.h"
 
+#include <folly/File.h>
 #include <folly/FileUtil.h>
+#include <folly/String.h>
 #include <folly/Subprocess.h>
 #include <folly/dynamic.h>
+#include <folly/experimental/bser/Bser.h>
+#include <folly/io/IOBuf.h>
 #include <folly/json.h>
 #include <folly/logging/xlog.h>
+#include <folly/system/MemoryMapping.h>
 
 #include <boost/filesystem/operations.hpp>
+#include <array>
 #include <thrift/lib/cpp/util/EnumUtils.h>
 
 using folly::IPAddressV4;
@@ -33,6 +40,19 @@ using folly::IPAddressV6;
 DEFINE_string(mac, "", "The local MAC address for this switch");
 DEFINE_string(mgmt_if, "eth0", "name of management interface");
 
+namespace {
+/*
+ * Binary state files start with a magic number ("FBST") followed by the
+ * format version, both in network byte order. Bump the version on any
+ * incompatible change to the encoding.
+ */
+constexpr uint32_t kBinaryStateMagic = 0x46425354;
+constexpr uint32_t kBinaryStateVersion = 1;
+constexpr size_t kBinaryStateHeaderSize = 2 * sizeof(uint32_t);
+// Serialize into large buffers, rather than many small ones
+constexpr size_t kBinaryStateBufferSize = 1 << 20;
+} // namespace
+
 namespace facebook::fboss {
 
 void utilCreateDir(folly::StringPiece path) {
@@ -99,6 +119,59 @@ bool dumpStateToFile(const std::string& filename, const folly::dynamic& json) {
   return folly::writeFile(folly::toPrettyJson(json), filename.c_str());
 }
 
+bool dumpBinaryStateToFile(
+    const std::string& filename,
+    const folly::dynamic& json) {
+  std::array<uint32_t, 2> header = {
+      folly::Endian::big(kBinaryStateMagic),
+      folly::Endian::big(kBinaryStateVersion)};
+  folly::bser::serialization_opts opts;
+  opts.growth = kBinaryStateBufferSize;
+  auto payload = folly::bser::toBserIOBuf(json, opts);
+
+  int fd = folly::openNoInt(
+      filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    XLOG(ERR) << "Unable to open " << filename << ": " << folly::errnoStr(errno);
+    return false;
+  }
+  folly::File file(fd, true /* ownsFd */);
+  if (folly::writeFull(fd, header.data(), kBinaryStateHeaderSize) !=
+      kBinaryStateHeaderSize) {
+    XLOG(ERR) << "Unable to write state header to " << filename << ": "
+              << folly::errnoStr(errno);
+    return false;
+  }
+  // Write out the serialized buffers as they are, instead of coalescing them
+  for (auto range : *payload) {
+    auto written = folly::writeFull(fd, range.data(), range.size());
+    if (written < 0 || static_cast<size_t>(written) != range.size()) {
+      XLOG(ERR) << "Unable to write state to " << filename << ": "
+                << folly::errnoStr(errno);
+      return false;
+    }
+  }
+  return true;
+}
+
+folly::dynamic readStateFromFile(const std::string& filename) {
+  folly::MemoryMapping mapping(filename.c_str());
+  auto data = mapping.range();
+  if (data.size() >= kBinaryStateHeaderSize &&
+      readBuffer<uint32_t>(data.data(), 0, data.size()) == kBinaryStateMagic) {
+    auto version =
+        readBuffer<uint32_t>(data.data(), sizeof(uint32_t), data.size());
+    if (version != kBinaryStateVersion) {
+      throw FbossError(
+          "Unsupported binary state version ", version, " in ", filename);
+    }
+    data.advance(kBinaryStateHeaderSize);
+    return folly::bser::parseBser(data);
+  }
+  // Not binary, must have been written by dumpStateToFile
+  return folly::parseJson(folly::StringPiece(data));
+}
+
 std::string getLocalHostname() {
   const size_t kHostnameMaxLen = 256; // from gethostname man page
   char hostname[kHostnameMaxLen];
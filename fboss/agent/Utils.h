@@ -81,6 +81,22 @@ void incNiceValue(const uint32_t increment);
  */
 bool dumpStateToFile(const std::string& filename, const folly::dynamic& json);
 
+/*
+ * Serialize folly dynamic to a compact binary encoding (BSER) behind a small
+ * versioned header, and write it to file. Much smaller and faster to write
+ * and parse than JSON, so meant for state we read back ourselves, such as
+ * warm boot state.
+ */
+bool dumpBinaryStateToFile(
+    const std::string& filename,
+    const folly::dynamic& json);
+
+/*
+ * Read back folly dynamic written by either dumpBinaryStateToFile or
+ * dumpStateToFile. Throws on failure.
+ */
+folly::dynamic readStateFromFile(const std::string& filename);
+
 std::vector<ClientID> AllClientIDs();
 
 /*
@@ -17,15 +17,17 @@
 namespace facebook::fboss {
 
 HwFb303Stats::~HwFb303Stats() {
-  for (const auto& statNameAndStat : counters_) {
-    utility::deleteCounter(statNameAndStat.second.getName());
+  for (const auto& stat : counters_) {
+    if (stat) {
+      utility::deleteCounter(stat->getName());
+    }
   }
 }
 
 const stats::MonotonicCounter* HwFb303Stats::getCounterIf(
     const std::string& statName) const {
-  auto pcitr = counters_.find(statName);
-  return pcitr != counters_.end() ? &pcitr->second : nullptr;
+  auto hitr = statHandles_.find(statName);
+  return hitr != statHandles_.end() ? &*counters_[hitr->second] : nullptr;
 }
 
 stats::MonotonicCounter* HwFb303Stats::getCounterIf(
@@ -34,6 +36,13 @@ stats::MonotonicCounter* HwFb303Stats::getCounterIf(
       const_cast<const HwFb303Stats*>(this)->getCounterIf(statName));
 }
 
+HwFb303Stats::StatHandle HwFb303Stats::getStatHandle(
+    const std::string& statName) const {
+  auto hitr = statHandles_.find(statName);
+  CHECK(hitr != statHandles_.end()) << "No stat: " << statName;
+  return hitr->second;
+}
+
 int64_t HwFb303Stats::getCounterLastIncrement(
     const std::string& statName) const {
   return getCounterIf(statName)->get();
@@ -49,22 +58,33 @@ void HwFb303Stats::reinitStat(
     if (oldStatName == statName) {
       return;
     }
-    auto stat = getCounterIf(*oldStatName);
+    // The renamed stat keeps its slot, and so its handle
+    auto handle = getStatHandle(*oldStatName);
     stats::MonotonicCounter newStat{statName, fb303::SUM, fb303::RATE};
-    stat->swap(newStat);
+    counters_[handle]->swap(newStat);
     utility::deleteCounter(newStat.getName());
-    counters_.insert(std::make_pair(statName, std::move(*stat)));
-    counters_.erase(*oldStatName);
-  } else {
-    counters_.emplace(
-        statName, stats::MonotonicCounter(statName, fb303::SUM, fb303::RATE));
+    statHandles_.erase(*oldStatName);
+    statHandles_.emplace(statName, handle);
+  } else if (statHandles_.find(statName) == statHandles_.end()) {
+    StatHandle handle;
+    if (freeHandles_.empty()) {
+      handle = counters_.size();
+      counters_.emplace_back();
+    } else {
+      handle = freeHandles_.back();
+      freeHandles_.pop_back();
+    }
+    counters_[handle].emplace(statName, fb303::SUM, fb303::RATE);
+    statHandles_.emplace(statName, handle);
   }
 }
 
 void HwFb303Stats::removeStat(const std::string& statName) {
-  auto stat = getCounterIf(statName);
-  utility::deleteCounter(stat->getName());
-  counters_.erase(stat->getName());
+  auto handle = getStatHandle(statName);
+  utility::deleteCounter(statName);
+  counters_[handle].reset();
+  freeHandles_.push_back(handle);
+  statHandles_.erase(statName);
 }
 
 void HwFb303Stats::updateStat(
@@ -76,4 +96,12 @@ void HwFb303Stats::updateStat(
   stat->updateValue(now, val);
 }
 
+void HwFb303Stats::updateStat(
+    const std::chrono::seconds& now,
+    StatHandle handle,
+    int64_t val) {
+  DCHECK(counters_[handle]);
+  counters_[handle]->updateValue(now, val);
+}
+
 } // namespace facebook::fboss
@@ -16,10 +16,21 @@
 
 #include <optional>
 #include <string>
+#include <vector>
 namespace facebook::fboss {
 
+/*
+ * Counters are kept in a dense array, and can be updated either by name or,
+ * without building and hashing the name, by the handle of the counter.
+ */
 class HwFb303Stats {
  public:
+  /*
+   * Index of a counter. A handle stays valid until the counter is removed,
+   * including across reinitStat() renaming the counter.
+   */
+  using StatHandle = size_t;
+
   ~HwFb303Stats();
 
   int64_t getCounterLastIncrement(const std::string& statName) const;
@@ -34,8 +45,14 @@ class HwFb303Stats {
       const std::chrono::seconds& now,
       const std::string& statName,
       int64_t val);
+  void updateStat(
+      const std::chrono::seconds& now,
+      StatHandle handle,
+      int64_t val);
   void removeStat(const std::string& statName);
 
+  StatHandle getStatHandle(const std::string& statName) const;
+
  private:
   /*
    * Update queue stat
@@ -44,6 +61,9 @@ class HwFb303Stats {
   const stats::MonotonicCounter* getCounterIf(
       const std::string& statName) const;
 
-  folly::F14FastMap<std::string, stats::MonotonicCounter> counters_;
+  // Unused slots are empty, and their handles are kept in freeHandles_
+  std::vector<std::optional<stats::MonotonicCounter>> counters_;
+  std::vector<StatHandle> freeHandles_;
+  folly::F14FastMap<std::string, StatHandle> statHandles_;
 };
 } // namespace facebook::fboss
@@ -16,7 +16,8 @@
 
 namespace facebook::fboss {
 
-std::array<folly::StringPiece, 23> HwPortFb303Stats::kPortStatKeys() {
+std::array<folly::StringPiece, HwPortFb303Stats::kNumPortStats>
+HwPortFb303Stats::kPortStatKeys() {
   return {
       kInBytes(),
       kInUnicastPkts(),
@@ -44,7 +45,8 @@ std::array<folly::StringPiece, 23> HwPortFb303Stats::kPortStatKeys() {
   };
 }
 
-std::array<folly::StringPiece, 3> HwPortFb303Stats::kQueueStatKeys() {
+std::array<folly::StringPiece, HwPortFb303Stats::kNumQueueStats>
+HwPortFb303Stats::kQueueStatKeys() {
   return {kOutCongestionDiscards(), kOutBytes(), kOutPkts()};
 }
 
@@ -71,8 +73,11 @@ int64_t HwPortFb303Stats::getCounterLastIncrement(
 void HwPortFb303Stats::reinitStats(std::optional<std::string> oldPortName) {
   XLOG(DBG2) << "Reinitializing stats for " << portName_;
 
-  for (auto statKey : kPortStatKeys()) {
-    reinitStat(statKey, portName_, oldPortName);
+  auto portStatKeys = kPortStatKeys();
+  for (size_t i = 0; i < kNumPortStats; ++i) {
+    reinitStat(portStatKeys[i], portName_, oldPortName);
+    portStatHandles_[i] =
+        portCounters_.getStatHandle(statName(portStatKeys[i], portName_));
   }
   for (auto queueIdAndName : queueId2Name_) {
     for (auto statKey : kQueueStatKeys()) {
@@ -87,6 +92,16 @@ void HwPortFb303Stats::reinitStats(std::optional<std::string> oldPortName) {
           : std::nullopt;
       portCounters_.reinitStat(newStatName, oldStatName);
     }
+    updateQueueStatHandles(queueIdAndName.first);
+  }
+}
+
+void HwPortFb303Stats::updateQueueStatHandles(int queueId) {
+  auto queueStatKeys = kQueueStatKeys();
+  auto& handles = queueStatHandles_[queueId];
+  for (size_t i = 0; i < kNumQueueStats; ++i) {
+    handles[i] = portCounters_.getStatHandle(statName(
+        queueStatKeys[i], portName_, queueId, queueId2Name_[queueId]));
   }
 }
 
@@ -126,6 +141,7 @@ void HwPortFb303Stats::queueChanged(int queueId, const std::string& queueName) {
   for (auto statKey : kQueueStatKeys()) {
     reinitStat(statKey, queueId, oldQueueName);
   }
+  updateQueueStatHandles(queueId);
 }
 
 void HwPortFb303Stats::queueRemoved(int queueId) {
@@ -135,104 +151,64 @@ void HwPortFb303Stats::queueRemoved(int queueId) {
         statName(statKey, portName_, queueId, queueId2Name_[queueId]));
   }
   queueId2Name_.erase(queueId);
+  queueStatHandles_.erase(queueId);
 }
 
 void HwPortFb303Stats::updateStats(
     const HwPortStats& curPortStats,
     const std::chrono::seconds& retrievedAt) {
   timeRetrieved_ = retrievedAt;
-  updateStat(timeRetrieved_, kInBytes(), *curPortStats.inBytes__ref());
-  updateStat(
-      timeRetrieved_, kInUnicastPkts(), *curPortStats.inUnicastPkts__ref());
-  updateStat(
-      timeRetrieved_, kInMulticastPkts(), *curPortStats.inMulticastPkts__ref());
-  updateStat(
-      timeRetrieved_, kInBroadcastPkts(), *curPortStats.inBroadcastPkts__ref());
-  updateStat(
-      timeRetrieved_, kInDiscardsRaw(), *curPortStats.inDiscardsRaw__ref());
-  updateStat(timeRetrieved_, kInDiscards(), *curPortStats.inDiscards__ref());
-  updateStat(timeRetrieved_, kInErrors(), *curPortStats.inErrors__ref());
-  updateStat(timeRetrieved_, kInPause(), *curPortStats.inPause__ref());
-  updateStat(
-      timeRetrieved_, kInIpv4HdrErrors(), *curPortStats.inIpv4HdrErrors__ref());
-  updateStat(
-      timeRetrieved_, kInIpv6HdrErrors(), *curPortStats.inIpv6HdrErrors__ref());
-  updateStat(
-      timeRetrieved_,
-      kInDstNullDiscards(),
-      *curPortStats.inDstNullDiscards__ref());
-  // Egress Stats
-  updateStat(timeRetrieved_, kOutBytes(), *curPortStats.outBytes__ref());
-  updateStat(
-      timeRetrieved_, kOutUnicastPkts(), *curPortStats.outUnicastPkts__ref());
-  updateStat(
-      timeRetrieved_,
-      kOutMulticastPkts(),
-      *curPortStats.outMulticastPkts__ref());
-  updateStat(
-      timeRetrieved_,
-      kOutBroadcastPkts(),
-      *curPortStats.outBroadcastPkts__ref());
-  updateStat(timeRetrieved_, kOutDiscards(), *curPortStats.outDiscards__ref());
-  updateStat(timeRetrieved_, kOutErrors(), *curPortStats.outErrors__ref());
-  updateStat(timeRetrieved_, kOutPause(), *curPortStats.outPause__ref());
-  updateStat(
-      timeRetrieved_,
-      kOutCongestionDiscards(),
-      *curPortStats.outCongestionDiscardPkts__ref());
-  updateStat(
-      timeRetrieved_,
-      kWredDroppedPackets(),
-      *curPortStats.wredDroppedPackets__ref());
-  updateStat(
-      timeRetrieved_, kOutEcnCounter(), *curPortStats.outEcnCounter__ref());
-  updateStat(
-      timeRetrieved_,
-      kFecCorrectable(),
-      *curPortStats.fecCorrectableErrors_ref());
-  updateStat(
-      timeRetrieved_,
-      kFecUncorrectable(),
-      *curPortStats.fecUncorrectableErrors_ref());
-
-  // Update queue stats
-  auto updateQueueStat = [this](
-                             folly::StringPiece statKey,
-                             int queueId,
-                             const std::map<int16_t, int64_t>& queueStats) {
-    auto qitr = queueStats.find(queueId);
-    CHECK(qitr != queueStats.end())
-        << "Missing stat: " << statKey
-        << " for queue: :" << queueId2Name_[queueId];
-    updateStat(timeRetrieved_, statKey, queueId, qitr->second);
+  // In the order of kPortStatKeys()
+  std::array<int64_t, kNumPortStats> portStatValues = {
+      *curPortStats.inBytes__ref(),
+      *curPortStats.inUnicastPkts__ref(),
+      *curPortStats.inMulticastPkts__ref(),
+      *curPortStats.inBroadcastPkts__ref(),
+      *curPortStats.inDiscards__ref(),
+      *curPortStats.inErrors__ref(),
+      *curPortStats.inPause__ref(),
+      *curPortStats.inIpv4HdrErrors__ref(),
+      *curPortStats.inIpv6HdrErrors__ref(),
+      *curPortStats.inDstNullDiscards__ref(),
+      *curPortStats.inDiscardsRaw__ref(),
+      // Egress Stats
+      *curPortStats.outBytes__ref(),
+      *curPortStats.outUnicastPkts__ref(),
+      *curPortStats.outMulticastPkts__ref(),
+      *curPortStats.outBroadcastPkts__ref(),
+      *curPortStats.outDiscards__ref(),
+      *curPortStats.outErrors__ref(),
+      *curPortStats.outPause__ref(),
+      *curPortStats.outCongestionDiscardPkts__ref(),
+      *curPortStats.wredDroppedPackets__ref(),
+      *curPortStats.outEcnCounter__ref(),
+      *curPortStats.fecCorrectableErrors_ref(),
+      *curPortStats.fecUncorrectableErrors_ref(),
   };
-  for (const auto& queueIdAndName : queueId2Name_) {
-    updateQueueStat(
-        kOutCongestionDiscards(),
-        queueIdAndName.first,
-        *curPortStats.queueOutDiscardBytes__ref());
-    updateQueueStat(
-        kOutBytes(), queueIdAndName.first, *curPortStats.queueOutBytes__ref());
-    updateQueueStat(
-        kOutPkts(), queueIdAndName.first, *curPortStats.queueOutPackets__ref());
+  for (size_t i = 0; i < kNumPortStats; ++i) {
+    portCounters_.updateStat(
+        timeRetrieved_, portStatHandles_[i], portStatValues[i]);
+  }
+
+  // Update queue stats, in the order of kQueueStatKeys()
+  std::array<const std::map<int16_t, int64_t>*, kNumQueueStats> queueStats = {
+      &*curPortStats.queueOutDiscardBytes__ref(),
+      &*curPortStats.queueOutBytes__ref(),
+      &*curPortStats.queueOutPackets__ref(),
+  };
+  for (const auto& queueIdAndHandles : queueStatHandles_) {
+    auto queueId = queueIdAndHandles.first;
+    for (size_t i = 0; i < kNumQueueStats; ++i) {
+      auto qitr = queueStats[i]->find(queueId);
+      CHECK(qitr != queueStats[i]->end())
+          << "Missing stat: " << kQueueStatKeys()[i]
+          << " for queue: :" << queueId2Name_[queueId];
+      portCounters_.updateStat(
+          timeRetrieved_, queueIdAndHandles.second[i], qitr->second);
+    }
   }
   updateQueueWatermarkStats(*curPortStats.queueWatermarkBytes__ref());
   portStats_ = curPortStats;
 }
 
-void HwPortFb303Stats::updateStat(
-    const std::chrono::seconds& now,
-    folly::StringPiece statKey,
-    int queueId,
-    int64_t val) {
-  portCounters_.updateStat(
-      now, statName(statKey, portName_, queueId, queueId2Name_[queueId]), val);
-}
-
-void HwPortFb303Stats::updateStat(
-    const std::chrono::seconds& now,
-    folly::StringPiece statKey,
-    int64_t val) {
-  portCounters_.updateStat(now, statName(statKey, portName_), val);
-}
 } // namespace facebook::fboss
@@ -15,14 +15,22 @@
 
 #include "folly/container/F14Map.h"
 
+#include <array>
 #include <optional>
 #include <string>
 
 namespace facebook::fboss {
 
+/*
+ * fb303 counters of a port and its queues. Counter names are built, and
+ * resolved to HwFb303Stats handles, only when the port or its queues are
+ * (re)configured. updateStats() writes through the handles.
+ */
 class HwPortFb303Stats {
  public:
   using QueueId2Name = folly::F14FastMap<int, std::string>;
+  static constexpr size_t kNumPortStats = 23;
+  static constexpr size_t kNumQueueStats = 3;
   explicit HwPortFb303Stats(
       const std::string& portName,
       QueueId2Name queueId2Name = {})
@@ -70,8 +78,8 @@ class HwPortFb303Stats {
       int queueId,
       folly::StringPiece queueName);
 
-  static std::array<folly::StringPiece, 23> kPortStatKeys();
-  static std::array<folly::StringPiece, 3> kQueueStatKeys();
+  static std::array<folly::StringPiece, kNumPortStats> kPortStatKeys();
+  static std::array<folly::StringPiece, kNumQueueStats> kQueueStatKeys();
   int64_t getCounterLastIncrement(folly::StringPiece statKey) const;
 
  private:
@@ -98,20 +106,9 @@ class HwPortFb303Stats {
       const std::string& statName,
       std::optional<std::string> oldStatName);
   /*
-   * update port stat
+   * Resolve handles of port queue stats
    */
-  void updateStat(
-      const std::chrono::seconds& now,
-      folly::StringPiece statKey,
-      int64_t val);
-  /*
-   * update port queue stat
-   */
-  void updateStat(
-      const std::chrono::seconds& now,
-      folly::StringPiece statKey,
-      int queueId,
-      int64_t val);
+  void updateQueueStatHandles(int queueId);
 
   void updateQueueWatermarkStats(
       const std::map<int16_t, int64_t>& queueWatermarkBytes) const;
@@ -119,6 +116,12 @@ class HwPortFb303Stats {
   std::string portName_;
   HwFb303Stats portCounters_;
   QueueId2Name queueId2Name_;
+  // In the order of kPortStatKeys() and kQueueStatKeys()
+  std::array<HwFb303Stats::StatHandle, kNumPortStats> portStatHandles_;
+  folly::F14FastMap<
+      int,
+      std::array<HwFb303Stats::StatHandle, kNumQueueStats>>
+      queueStatHandles_;
   HwPortStats portStats_;
 };
 
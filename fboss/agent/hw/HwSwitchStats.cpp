@@ -50,12 +50,22 @@ HwSwitchStats::HwSwitchStats(
           SwitchStats::kCounterPrefix + vendor + ".tx.pkt.allocation.errors",
           SUM,
           RATE),
+      txQueueDrops_(
+          map,
+          SwitchStats::kCounterPrefix + vendor + ".tx.pkt.queue.drops",
+          SUM,
+          RATE),
       txQueued_(
           map,
           SwitchStats::kCounterPrefix + vendor + ".tx.pkt.queued_us",
           100,
           0,
           1000),
+      sflowSamplesDropped_(
+          map,
+          SwitchStats::kCounterPrefix + vendor + ".sflow.samples.dropped",
+          SUM,
+          RATE),
       parityErrors_(
           map,
           SwitchStats::kCounterPrefix + vendor + ".parity.errors",
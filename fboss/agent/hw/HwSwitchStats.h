@@ -42,6 +42,14 @@ class HwSwitchStats {
     txErrors_.addValue(1);
     txPktAllocErrors_.addValue(1);
   }
+  void txQueueDrops() {
+    txErrors_.addValue(1);
+    txQueueDrops_.addValue(1);
+  }
+
+  void sflowSamplesDropped(int64_t numSamples) {
+    sflowSamplesDropped_.addValue(numSamples);
+  }
 
   void corrParityError() {
     parityErrors_.addValue(1);
@@ -75,6 +83,12 @@ class HwSwitchStats {
   int64_t getTxPktAllocErrorsCount() {
     return txPktAllocErrors_.count();
   }
+  int64_t getTxQueueDropsCount() {
+    return txQueueDrops_.count();
+  }
+  int64_t getSflowSamplesDroppedCount() {
+    return sflowSamplesDropped_.count();
+  }
   int64_t getCorrParityErrorCount() {
     return corrParityErrors_.count();
   }
@@ -103,10 +117,15 @@ class HwSwitchStats {
   // Errors in sending packets
   TLTimeseries txErrors_;
   TLTimeseries txPktAllocErrors_;
+  // Packets dropped because the async TX queue was full
+  TLTimeseries txQueueDrops_;
 
   // Time spent for each Tx packet queued in HW
   TLHistogram txQueued_;
 
+  // sFlow samples dropped because the exporter could not keep up
+  TLTimeseries sflowSamplesDropped_;
+
   // parity errors
   TLTimeseries parityErrors_;
   TLTimeseries corrParityErrors_;
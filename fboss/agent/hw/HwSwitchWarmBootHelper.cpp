@@ -13,15 +13,21 @@
 #include "fboss/agent/SysError.h"
 #include "fboss/agent/Utils.h"
 
-#include <folly/FileUtil.h>
-#include <folly/json.h>
 #include <folly/logging/xlog.h>
 
 DEFINE_bool(can_warm_boot, true, "Enable/disable warm boot functionality");
 DEFINE_string(
     switch_state_file,
     "switch_state",
-    "File for dumping switch state JSON in on exit");
+    "File for dumping switch state in on exit");
+// TODO: default to true once all agents we may downgrade to read the binary
+// format
+DEFINE_bool(
+    binary_warm_boot_state,
+    false,
+    "Dump switch state on exit in a compact binary format rather than JSON. "
+    "Either format is read back on warm boot, but older agents only read "
+    "JSON");
 
 namespace {
 constexpr auto wbFlagPrefix = "can_warm_boot_";
@@ -134,17 +140,14 @@ bool HwSwitchWarmBootHelper::checkAndClearWarmBootFlags() {
 
 bool HwSwitchWarmBootHelper::storeWarmBootState(
     const folly::dynamic& switchState) {
-  warmBootStateWritten_ =
-      dumpStateToFile(warmBootSwitchStateFile(), switchState);
+  warmBootStateWritten_ = FLAGS_binary_warm_boot_state
+      ? dumpBinaryStateToFile(warmBootSwitchStateFile(), switchState)
+      : dumpStateToFile(warmBootSwitchStateFile(), switchState);
   return warmBootStateWritten_;
 }
 
 folly::dynamic HwSwitchWarmBootHelper::getWarmBootState() const {
-  std::string warmBootJson;
-  auto ret = folly::readFile(warmBootSwitchStateFile().c_str(), warmBootJson);
-  sysCheckError(
-      ret, "Unable to read switch state from : ", warmBootSwitchStateFile());
-  return folly::parseJson(warmBootJson);
+  return readStateFromFile(warmBootSwitchStateFile());
 }
 
 void HwSwitchWarmBootHelper::setupWarmBootFile() {
@@ -17,6 +17,7 @@
 #include <fb303/ServiceData.h>
 #include <folly/Conv.h>
 #include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
 #include "common/stats/MonotonicCounter.h"
 #include "fboss/agent/hw/CounterUtils.h"
@@ -63,6 +64,12 @@ using std::chrono::system_clock;
 
 using facebook::stats::MonotonicCounter;
 
+DEFINE_bool(
+    bulk_port_stats,
+    true,
+    "Read all MIB counters of a port with a single bcm_stat_multi_get(), "
+    "rather than a bcm_stat_get() per counter");
+
 namespace {
 
 bool hasPortQueueChanges(
@@ -868,86 +875,62 @@ void BcmPort::updateStats() {
       : *curPortStats.inDiscards__ref();
   curPortStats.timestamp__ref() = now.count();
 
-  updateStat(
-      now, kInBytes(), snmpIfHCInOctets, &(*curPortStats.inBytes__ref()));
-  updateStat(
-      now,
-      kInUnicastPkts(),
-      snmpIfHCInUcastPkts,
-      &(*curPortStats.inUnicastPkts__ref()));
-  updateStat(
-      now,
-      kInMulticastPkts(),
-      snmpIfHCInMulticastPkts,
-      &(*curPortStats.inMulticastPkts__ref()));
-  updateStat(
-      now,
-      kInBroadcastPkts(),
-      snmpIfHCInBroadcastPkts,
-      &(*curPortStats.inBroadcastPkts__ref()));
-  updateStat(
-      now,
-      kInDiscardsRaw(),
-      snmpIfInDiscards,
-      &(*curPortStats.inDiscardsRaw__ref()));
-  updateStat(
-      now, kInErrors(), snmpIfInErrors, &(*curPortStats.inErrors__ref()));
-  updateStat(
-      now,
-      kInIpv4HdrErrors(),
-      snmpIpInHdrErrors,
-      &(*curPortStats.inIpv4HdrErrors__ref()));
-  updateStat(
-      now,
-      kInIpv6HdrErrors(),
-      snmpIpv6IfStatsInHdrErrors,
-      &(*curPortStats.inIpv6HdrErrors__ref()));
-  updateStat(
-      now, kInPause(), snmpDot3InPauseFrames, &(*curPortStats.inPause__ref()));
-  // Egress Stats
-  updateStat(
-      now, kOutBytes(), snmpIfHCOutOctets, &(*curPortStats.outBytes__ref()));
-  updateStat(
-      now,
-      kOutUnicastPkts(),
-      snmpIfHCOutUcastPkts,
-      &(*curPortStats.outUnicastPkts__ref()));
-  updateStat(
-      now,
-      kOutMulticastPkts(),
-      snmpIfHCOutMulticastPkts,
-      &(*curPortStats.outMulticastPkts__ref()));
-  updateStat(
-      now,
-      kOutBroadcastPkts(),
-      snmpIfHCOutBroadcastPckts,
-      &(*curPortStats.outBroadcastPkts__ref()));
-  updateStat(
-      now,
-      kOutDiscards(),
-      snmpIfOutDiscards,
-      &(*curPortStats.outDiscards__ref()));
-  updateStat(
-      now, kOutErrors(), snmpIfOutErrors, &(*curPortStats.outErrors__ref()));
-  updateStat(
-      now,
-      kOutPause(),
-      snmpDot3OutPauseFrames,
-      &(*curPortStats.outPause__ref()));
-
+  std::vector<PortStatInfo> portStats = {
+      {kInBytes(), snmpIfHCInOctets, &(*curPortStats.inBytes__ref())},
+      {kInUnicastPkts(),
+       snmpIfHCInUcastPkts,
+       &(*curPortStats.inUnicastPkts__ref())},
+      {kInMulticastPkts(),
+       snmpIfHCInMulticastPkts,
+       &(*curPortStats.inMulticastPkts__ref())},
+      {kInBroadcastPkts(),
+       snmpIfHCInBroadcastPkts,
+       &(*curPortStats.inBroadcastPkts__ref())},
+      {kInDiscardsRaw(),
+       snmpIfInDiscards,
+       &(*curPortStats.inDiscardsRaw__ref())},
+      {kInErrors(), snmpIfInErrors, &(*curPortStats.inErrors__ref())},
+      {kInIpv4HdrErrors(),
+       snmpIpInHdrErrors,
+       &(*curPortStats.inIpv4HdrErrors__ref())},
+      {kInIpv6HdrErrors(),
+       snmpIpv6IfStatsInHdrErrors,
+       &(*curPortStats.inIpv6HdrErrors__ref())},
+      {kInPause(), snmpDot3InPauseFrames, &(*curPortStats.inPause__ref())},
+      // Egress Stats
+      {kOutBytes(), snmpIfHCOutOctets, &(*curPortStats.outBytes__ref())},
+      {kOutUnicastPkts(),
+       snmpIfHCOutUcastPkts,
+       &(*curPortStats.outUnicastPkts__ref())},
+      {kOutMulticastPkts(),
+       snmpIfHCOutMulticastPkts,
+       &(*curPortStats.outMulticastPkts__ref())},
+      {kOutBroadcastPkts(),
+       snmpIfHCOutBroadcastPckts,
+       &(*curPortStats.outBroadcastPkts__ref())},
+      {kOutDiscards(), snmpIfOutDiscards, &(*curPortStats.outDiscards__ref())},
+      {kOutErrors(), snmpIfOutErrors, &(*curPortStats.outErrors__ref())},
+      {kOutPause(), snmpDot3OutPauseFrames, &(*curPortStats.outPause__ref())},
+  };
   if (hw_->getPlatform()->getAsic()->isSupported(HwAsic::Feature::ECN)) {
     // ECN stats not supported by TD2
-    updateStat(
-        now,
-        kOutEcnCounter(),
-        snmpBcmTxEcnErrors,
-        &(*curPortStats.outEcnCounter__ref()));
-  }
-  updateStat(
-      now,
-      kInDstNullDiscards(),
-      snmpBcmCustomReceive3,
-      &(*curPortStats.inDstNullDiscards__ref()));
+    portStats.push_back(
+        {kOutEcnCounter(),
+         snmpBcmTxEcnErrors,
+         &(*curPortStats.outEcnCounter__ref())});
+  }
+  portStats.push_back(
+      {kInDstNullDiscards(),
+       snmpBcmCustomReceive3,
+       &(*curPortStats.inDstNullDiscards__ref())});
+  bool pktLenHistUpdated = false;
+  if (FLAGS_bulk_port_stats) {
+    pktLenHistUpdated = updateStatsBulk(now, portStats);
+  } else {
+    for (const auto& portStat : portStats) {
+      updateStat(now, portStat.key, portStat.type, portStat.value);
+    }
+  }
   updateFecStats(now, curPortStats);
   updateWredStats(now, &(*curPortStats.wredDroppedPackets__ref()));
   auto asicType = hw_->getPlatform()->getAsic()->getAsicType();
@@ -993,8 +976,10 @@ void BcmPort::updateStats() {
   }
 
   // Update the packet length histograms
-  updatePktLenHist(now, &inPktLengths_, kInPktLengthStats);
-  updatePktLenHist(now, &outPktLengths_, kOutPktLengthStats);
+  if (!pktLenHistUpdated) {
+    updatePktLenHist(now, &inPktLengths_, kInPktLengthStats);
+    updatePktLenHist(now, &outPktLengths_, kOutPktLengthStats);
+  }
 
   // Update any platform specific port counters
   getPlatformPort()->updateStats();
@@ -1070,6 +1055,48 @@ void BcmPort::updateStat(
   *statVal = value;
 }
 
+bool BcmPort::updateStatsBulk(
+    std::chrono::seconds now,
+    const std::vector<PortStatInfo>& portStats) {
+  // The packet length histogram counters are read in the same call, after
+  // the port counters
+  std::vector<bcm_stat_val_t> types;
+  types.reserve(
+      portStats.size() + kInPktLengthStats.size() + kOutPktLengthStats.size());
+  for (const auto& portStat : portStats) {
+    types.push_back(portStat.type);
+  }
+  types.insert(types.end(), kInPktLengthStats.begin(), kInPktLengthStats.end());
+  types.insert(
+      types.end(), kOutPktLengthStats.begin(), kOutPktLengthStats.end());
+
+  std::vector<uint64_t> counters(types.size());
+  auto ret = bcm_stat_multi_get(
+      unit_, port_, types.size(), types.data(), counters.data());
+  if (BCM_FAILURE(ret)) {
+    // Fall back to reading the counters one at a time, so that one bad
+    // counter does not stop all the others from being collected
+    XLOG(ERR) << "Failed to get stats for port " << port_ << " :"
+              << bcm_errmsg(ret);
+    for (const auto& portStat : portStats) {
+      updateStat(now, portStat.key, portStat.type, portStat.value);
+    }
+    return false;
+  }
+
+  for (size_t idx = 0; idx < portStats.size(); ++idx) {
+    getPortCounterIf(portStats[idx].key)->updateValue(now, counters[idx]);
+    *portStats[idx].value = counters[idx];
+  }
+  auto inPktLengths = &counters[portStats.size()];
+  auto outPktLengths = inPktLengths + kInPktLengthStats.size();
+  addPktLenHistValues(
+      now, &inPktLengths_, inPktLengths, kInPktLengthStats.size());
+  addPktLenHistValues(
+      now, &outPktLengths_, outPktLengths, kOutPktLengthStats.size());
+  return true;
+}
+
 void BcmPort::updateWredStats(std::chrono::seconds now, int64_t* portStatVal) {
   auto getWredDroppedPackets = [this](auto statId) {
     uint64_t count{0};
@@ -1109,9 +1136,16 @@ void BcmPort::updatePktLenHist(
     return;
   }
 
-  // Update the histogram
+  addPktLenHistValues(now, hist, counters, stats.size());
+}
+
+void BcmPort::addPktLenHistValues(
+    std::chrono::seconds now,
+    fb303::ExportedHistogramMapImpl::LockableHistogram* hist,
+    const uint64_t* counters,
+    size_t numCounters) {
   auto guard = hist->makeLockGuard();
-  for (int idx = 0; idx < stats.size(); ++idx) {
+  for (int idx = 0; idx < numCounters; ++idx) {
     hist->addValueLocked(guard, now.count(), idx, counters[idx]);
   }
 }
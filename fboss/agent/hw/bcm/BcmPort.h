@@ -229,11 +229,30 @@ class BcmPort {
       folly::StringPiece statName,
       bcm_stat_val_t type,
       int64_t* portStatVal);
+  // A MIB counter of the port, and where to store its value in HwPortStats
+  struct PortStatInfo {
+    folly::StringPiece key;
+    bcm_stat_val_t type;
+    int64_t* value;
+  };
+  /*
+   * Reads all the given counters, and the packet length histogram counters,
+   * with a single SDK call. Returns false if the histograms were not
+   * updated, in which case they still need to be read.
+   */
+  bool updateStatsBulk(
+      std::chrono::seconds now,
+      const std::vector<PortStatInfo>& portStats);
   void updateFecStats(std::chrono::seconds now, HwPortStats& curPortStats);
   void updatePktLenHist(
       std::chrono::seconds now,
       fb303::ExportedHistogramMapImpl::LockableHistogram* hist,
       const std::vector<bcm_stat_val_t>& stats);
+  void addPktLenHistValues(
+      std::chrono::seconds now,
+      fb303::ExportedHistogramMapImpl::LockableHistogram* hist,
+      const uint64_t* counters,
+      size_t numCounters);
   void initCustomStats() const;
   std::string statName(folly::StringPiece statName, folly::StringPiece portName)
       const;
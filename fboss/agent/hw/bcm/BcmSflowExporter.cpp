@@ -9,21 +9,39 @@
  */
 #include "BcmSflowExporter.h"
 
+#include <chrono>
 #include <fstream>
 #include <iostream>
 #include <vector>
 
 #include <fcntl.h>
 #include <ifaddrs.h>
+#include <sys/socket.h>
 
 #include <folly/Range.h>
 #include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
 #include <glog/logging.h>
 #include <optional>
 
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 
 #include "fboss/agent/FbossError.h"
+#include "fboss/agent/Utils.h"
+
+DEFINE_int32(
+    sflow_export_queue_size,
+    8192,
+    "Number of sFlow samples queued for export before dropping samples");
+DEFINE_int32(
+    sflow_export_batch_size,
+    32,
+    "Max number of sFlow samples sent to a collector in one sendmmsg call");
+DEFINE_int32(
+    sflow_export_flush_us,
+    1000,
+    "Max time in microseconds an sFlow sample waits for a batch to fill up "
+    "before it is sent");
 
 using namespace std;
 
@@ -165,28 +183,39 @@ BcmSflowExporter::BcmSflowExporter(const folly::SocketAddress& address)
   }
 }
 
-ssize_t BcmSflowExporter::sendUDPDatagram(iovec* vec, const size_t iovec_len) {
-  XLOG(DBG4) << "Sending an sFlow packet to " << address_.describe();
-
+size_t BcmSflowExporter::sendUDPDatagrams(
+    const std::vector<std::string>& datagrams) {
   sockaddr_storage addrStorage;
   address_.getAddress(&addrStorage);
 
-  struct msghdr msg = {};
-  msg.msg_name = reinterpret_cast<void*>(&addrStorage);
-  msg.msg_namelen = address_.getActualSize();
-  msg.msg_iov = vec;
-  msg.msg_iovlen = iovec_len;
-  msg.msg_control = nullptr;
-  msg.msg_controllen = 0;
-  msg.msg_flags = 0;
-  auto ret = ::sendmsg(socket_, &msg, 0);
-  if (ret < 0) {
-    XLOG(DBG1) << "Failed sending sFlow packet to " << address_.describe()
-               << " reason: " << folly::errnoStr(errno);
+  std::vector<iovec> vecs(datagrams.size());
+  std::vector<mmsghdr> msgs(datagrams.size());
+  for (size_t i = 0; i < datagrams.size(); ++i) {
+    vecs[i].iov_base = const_cast<char*>(datagrams[i].data());
+    vecs[i].iov_len = datagrams[i].length();
+    auto& msg = msgs[i].msg_hdr;
+    msg.msg_name = reinterpret_cast<void*>(&addrStorage);
+    msg.msg_namelen = address_.getActualSize();
+    msg.msg_iov = &vecs[i];
+    msg.msg_iovlen = 1;
   }
-  XLOG(DBG4) << "Sent " << ret << " bytes of sFlow packet to "
-             << address_.describe();
-  return ret;
+
+  size_t sent = 0;
+  while (sent < msgs.size()) {
+    auto ret = ::sendmmsg(socket_, &msgs[sent], msgs.size() - sent, 0);
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      XLOG(DBG1) << "Failed sending " << msgs.size() - sent
+                 << " sFlow packets to " << address_.describe()
+                 << " reason: " << folly::errnoStr(errno);
+      break;
+    }
+    sent += ret;
+  }
+  XLOG(DBG4) << "Sent " << sent << " sFlow packets to " << address_.describe();
+  return sent;
 }
 
 BcmSflowExporter::~BcmSflowExporter() {
@@ -195,20 +224,36 @@ BcmSflowExporter::~BcmSflowExporter() {
   }
 }
 
+BcmSflowExporterTable::BcmSflowExporterTable(
+    SamplesDroppedCallback onSamplesDropped)
+    : onSamplesDropped_(std::move(onSamplesDropped)),
+      exportQueue_(FLAGS_sflow_export_queue_size) {
+  exporterThread_ = make_unique<std::thread>([this]() {
+    initThread("fbossSflowExp");
+    exporterThreadLoop();
+  });
+}
+
+BcmSflowExporterTable::~BcmSflowExporterTable() {
+  // An empty sample tells the exporter thread to stop once it has sent
+  // everything queued ahead of it.
+  exportQueue_.blockingWrite();
+  exporterThread_->join();
+}
+
 bool BcmSflowExporterTable::contains(
     const shared_ptr<SflowCollector>& c) const {
-  auto iter = map_.find(c->getID());
-  return iter != map_.end();
+  return map_.rlock()->count(c->getID()) != 0;
 }
 
 size_t BcmSflowExporterTable::size() const {
-  return map_.size();
+  return map_.rlock()->size();
 }
 
 void BcmSflowExporterTable::addExporter(const shared_ptr<SflowCollector>& c) {
   try {
-    auto exporter = make_unique<BcmSflowExporter>(c->getAddress());
-    map_.emplace(c->getID(), move(exporter));
+    auto exporter = make_shared<BcmSflowExporter>(c->getAddress());
+    map_.wlock()->emplace(c->getID(), move(exporter));
   } catch (const fboss::thrift::FbossBaseError& ex) {
     XLOG(ERR) << "Could not add exporter: "
               << c->getAddress().getFullyQualified()
@@ -222,7 +267,7 @@ void BcmSflowExporterTable::addExporter(const shared_ptr<SflowCollector>& c) {
 
 void BcmSflowExporterTable::removeExporter(const std::string& id) {
   XLOG(INFO) << "Removed sFlow exporter " << id;
-  map_.erase(id);
+  map_.wlock()->erase(id);
 }
 
 void BcmSflowExporterTable::updateSamplingRates(
@@ -241,30 +286,70 @@ void BcmSflowExporterTable::updateSamplingRates(
   localIP_ = getLocalIPv6();
 }
 
-void BcmSflowExporterTable::sendToAll(const SflowPacketInfo& info) {
-  if (map_.empty()) {
+bool BcmSflowExporterTable::sendToAll(const SflowPacketInfo& info) {
+  if (map_.rlock()->empty()) {
     XLOG(DBG1)
         << "zero sFlow collectors with sflow enabled, skipping sample export";
-    return;
+    return true;
   }
-  // Serialize info to a string and wrap it in an IOBuf for sending
   string output;
   apache::thrift::BinarySerializer::serialize(info, &output);
-  auto buf = folly::IOBuf::wrapBuffer(output.data(), output.length());
-
-  // Map the IOBuf to a Linux iovec like a champ
-  iovec vec[16] = {};
-  size_t iovec_len = buf->fillIov(vec, sizeof(vec) / sizeof(vec[0])).numIovecs;
-  if (UNLIKELY(iovec_len == 0)) {
-    buf->coalesce();
-    vec[0].iov_base = const_cast<uint8_t*>(buf->data());
-    vec[0].iov_len = buf->length();
-    iovec_len = 1;
+  if (!exportQueue_.write(std::move(output))) {
+    samplesDropped(1);
+    return false;
   }
+  return true;
+}
+
+void BcmSflowExporterTable::exporterThreadLoop() {
+  std::vector<std::string> batch;
+  batch.reserve(FLAGS_sflow_export_batch_size);
+  bool stop = false;
+  while (!stop) {
+    std::string sample;
+    exportQueue_.blockingRead(sample);
+    auto flushTime = std::chrono::steady_clock::now() +
+        std::chrono::microseconds(FLAGS_sflow_export_flush_us);
+    while (true) {
+      if (sample.empty()) {
+        stop = true;
+        break;
+      }
+      batch.push_back(std::move(sample));
+      if (batch.size() >=
+              static_cast<size_t>(FLAGS_sflow_export_batch_size) ||
+          !exportQueue_.tryReadUntil(flushTime, sample)) {
+        break;
+      }
+    }
+    if (!batch.empty()) {
+      sendBatch(batch);
+      batch.clear();
+    }
+  }
+}
+
+void BcmSflowExporterTable::sendBatch(const std::vector<std::string>& batch) {
+  // Copy the exporters out so that the lock is not held across the sends.
+  std::vector<std::shared_ptr<BcmSflowExporter>> exporters;
+  {
+    auto map = map_.rlock();
+    exporters.reserve(map->size());
+    for (const auto& c : *map) {
+      exporters.push_back(c.second);
+    }
+  }
+  for (const auto& exporter : exporters) {
+    auto sent = exporter->sendUDPDatagrams(batch);
+    if (sent < batch.size()) {
+      samplesDropped(batch.size() - sent);
+    }
+  }
+}
 
-  for (const auto& c : map_) {
-    // TODO: prob need to handle ret code?
-    c.second->sendUDPDatagram(vec, iovec_len);
+void BcmSflowExporterTable::samplesDropped(size_t numSamples) {
+  if (onSamplesDropped_) {
+    onSamplesDropped_(numSamples);
   }
 }
 
@@ -9,10 +9,16 @@
  */
 #pragma once
 
+#include <functional>
+#include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include <folly/IPAddress.h>
+#include <folly/MPMCQueue.h>
 #include <folly/SocketAddress.h>
+#include <folly/Synchronized.h>
 
 #include "fboss/agent/if/gen-cpp2/sflow_types.h"
 #include "fboss/agent/state/SflowCollector.h"
@@ -31,9 +37,12 @@ class BcmSflowExporter {
   ~BcmSflowExporter();
 
   /*
-   * Send out the data in vec using UDP.  Called after init().
+   * Send out each of the datagrams in a single sendmmsg() call.
+   *
+   * Returns the number of datagrams sent, which is less than
+   * datagrams.size() if the socket buffer filled up.
    */
-  ssize_t sendUDPDatagram(iovec* vec, const size_t iovec_len);
+  size_t sendUDPDatagrams(const std::vector<std::string>& datagrams);
 
  private:
   // no copy or assignment
@@ -44,10 +53,25 @@ class BcmSflowExporter {
   int socket_{-1};
 };
 
+/*
+ * BcmSflowExporterTable exports sFlow samples to all the configured
+ * collectors.
+ *
+ * Samples are serialized on the thread calling sendToAll() and queued to an
+ * exporter thread, which sends them out in batches of up to
+ * --sflow_export_batch_size datagrams, using one sendmmsg() call per
+ * collector. A batch is sent once it is full or once its first sample has
+ * waited --sflow_export_flush_us. Samples that do not fit in the queue, or
+ * that a collector's socket has no room for, are dropped and reported to the
+ * onSamplesDropped callback.
+ */
 class BcmSflowExporterTable {
  public:
-  BcmSflowExporterTable() = default;
-  ~BcmSflowExporterTable() = default;
+  using SamplesDroppedCallback = std::function<void(size_t numSamples)>;
+
+  explicit BcmSflowExporterTable(
+      SamplesDroppedCallback onSamplesDropped = nullptr);
+  ~BcmSflowExporterTable();
 
   bool contains(const std::shared_ptr<SflowCollector>& collector) const;
   size_t size() const;
@@ -56,19 +80,38 @@ class BcmSflowExporterTable {
 
   void updateSamplingRates(PortID id, int64_t inRate, int64_t outRate);
 
-  void sendToAll(const SflowPacketInfo& info);
+  /*
+   * Queue a sample to be sent to all the collectors.
+   *
+   * Returns false if the sample was dropped because the export queue is
+   * full.
+   */
+  bool sendToAll(const SflowPacketInfo& info);
 
  private:
   // no copy or assignment
   BcmSflowExporterTable(BcmSflowExporterTable const&) = delete;
   BcmSflowExporterTable& operator=(BcmSflowExporterTable const&) = delete;
 
-  std::unordered_map<std::string, std::unique_ptr<BcmSflowExporter>> map_;
+  void exporterThreadLoop();
+  void sendBatch(const std::vector<std::string>& batch);
+  void samplesDropped(size_t numSamples);
+
+  // Exporters are shared with the exporter thread, so that removing a
+  // collector does not close its socket in the middle of a send.
+  folly::Synchronized<
+      std::unordered_map<std::string, std::shared_ptr<BcmSflowExporter>>>
+      map_;
   std::unordered_map<
       PortID,
       std::pair<int64_t /* ingress rate */, int64_t /* egress rate */>>
       port2samplingRates_;
   folly::IPAddress localIP_;
+
+  SamplesDroppedCallback onSamplesDropped_;
+  // Serialized samples. An empty string tells the exporter thread to stop.
+  folly::MPMCQueue<std::string> exportQueue_;
+  std::unique_ptr<std::thread> exporterThread_;
 };
 
 } // namespace facebook::fboss
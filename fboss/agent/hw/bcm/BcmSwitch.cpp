@@ -349,7 +349,9 @@ BcmSwitch::BcmSwitch(BcmPlatform* platform, uint32_t featuresDesired)
       qosPolicyTable_(new BcmQosPolicyTable(this)),
       aclTable_(new BcmAclTable(this)),
       trunkTable_(new BcmTrunkTable(this)),
-      sFlowExporterTable_(new BcmSflowExporterTable()),
+      sFlowExporterTable_(new BcmSflowExporterTable([this](size_t numSamples) {
+        getSwitchStats()->sflowSamplesDropped(numSamples);
+      })),
       rtag7LoadBalancer_(new BcmRtag7LoadBalancer(this)),
       mirrorTable_(new BcmMirrorTable(this)),
       bstStatsMgr_(new BcmBstStatsMgr(this)),
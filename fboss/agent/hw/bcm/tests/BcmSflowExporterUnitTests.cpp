@@ -0,0 +1,138 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/bcm/BcmSflowExporter.h"
+
+#include <optional>
+
+#include <folly/SocketAddress.h>
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+DECLARE_int32(sflow_export_batch_size);
+DECLARE_int32(sflow_export_flush_us);
+
+using namespace facebook::fboss;
+
+namespace {
+
+/*
+ * A UDP socket on the loopback interface standing in for an sFlow collector.
+ */
+class LocalCollector {
+ public:
+  LocalCollector() {
+    socket_ = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    EXPECT_NE(-1, socket_);
+    timeval timeout{5, 0};
+    setsockopt(socket_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    folly::SocketAddress addr("127.0.0.1", 0);
+    sockaddr_storage addrStorage;
+    addr.getAddress(&addrStorage);
+    EXPECT_EQ(
+        0,
+        ::bind(
+            socket_,
+            reinterpret_cast<sockaddr*>(&addrStorage),
+            addr.getActualSize()));
+    addr.setFromLocalAddress(socket_);
+    port_ = addr.getPort();
+  }
+  ~LocalCollector() {
+    close(socket_);
+  }
+
+  std::shared_ptr<SflowCollector> collector() const {
+    return std::make_shared<SflowCollector>("127.0.0.1", port_);
+  }
+
+  std::optional<SflowPacketInfo> receive() {
+    char buf[2048];
+    auto len = ::recv(socket_, buf, sizeof(buf), 0);
+    if (len <= 0) {
+      return std::nullopt;
+    }
+    return apache::thrift::BinarySerializer::deserialize<SflowPacketInfo>(
+        folly::StringPiece(buf, len));
+  }
+
+ private:
+  int socket_{-1};
+  uint16_t port_{0};
+};
+
+SflowPacketInfo makeSample(int16_t srcPort) {
+  SflowPacketInfo info;
+  *info.ingressSampled_ref() = true;
+  info.srcPort_ref() = srcPort;
+  info.vlan_ref() = 1;
+  *info.packetData_ref() = "sampled packet";
+  return info;
+}
+
+} // namespace
+
+TEST(BcmSflowExporterTest, ExportToAllCollectors) {
+  LocalCollector collector1, collector2;
+  BcmSflowExporterTable table;
+  table.addExporter(collector1.collector());
+  table.addExporter(collector2.collector());
+  EXPECT_EQ(2, table.size());
+
+  // More samples than fit in one batch
+  const int16_t kNumSamples = 2 * FLAGS_sflow_export_batch_size + 1;
+  for (int16_t i = 0; i < kNumSamples; ++i) {
+    EXPECT_TRUE(table.sendToAll(makeSample(i)));
+  }
+  for (auto* collector : {&collector1, &collector2}) {
+    for (int16_t i = 0; i < kNumSamples; ++i) {
+      auto info = collector->receive();
+      ASSERT_TRUE(info);
+      EXPECT_EQ(i, *info->srcPort_ref());
+      EXPECT_EQ("sampled packet", *info->packetData_ref());
+    }
+  }
+}
+
+TEST(BcmSflowExporterTest, FlushPartialBatch) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_sflow_export_flush_us = 100;
+  LocalCollector collector;
+  BcmSflowExporterTable table;
+  table.addExporter(collector.collector());
+
+  // A single sample is sent once the flush time passes, without waiting for
+  // the batch to fill up.
+  EXPECT_TRUE(table.sendToAll(makeSample(7)));
+  auto info = collector.receive();
+  ASSERT_TRUE(info);
+  EXPECT_EQ(7, *info->srcPort_ref());
+}
+
+TEST(BcmSflowExporterTest, RemoveExporter) {
+  LocalCollector collector;
+  BcmSflowExporterTable table;
+  auto sflowCollector = collector.collector();
+  table.addExporter(sflowCollector);
+  EXPECT_TRUE(table.contains(sflowCollector));
+  table.removeExporter(sflowCollector->getID());
+  EXPECT_FALSE(table.contains(sflowCollector));
+
+  // With no collectors samples are skipped rather than dropped
+  size_t numDropped = 0;
+  BcmSflowExporterTable emptyTable(
+      [&numDropped](size_t numSamples) { numDropped += numSamples; });
+  EXPECT_TRUE(emptyTable.sendToAll(makeSample(1)));
+  EXPECT_EQ(0, numDropped);
+}
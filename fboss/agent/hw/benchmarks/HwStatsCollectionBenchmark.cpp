@@ -13,12 +13,41 @@
 #include "fboss/agent/hw/test/ConfigFactory.h"
 #include "fboss/agent/hw/test/HwSwitchEnsemble.h"
 #include "fboss/agent/hw/test/HwSwitchEnsembleFactory.h"
+#include "fboss/agent/test/RouteScaleGenerators.h"
 
 #include <folly/Benchmark.h>
 #include <folly/logging/xlog.h>
 
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
 namespace facebook::fboss {
 
+namespace {
+
+/*
+ * Collect stats numPasses times, and log the average and worst latency of a
+ * single collection pass over all ports.
+ */
+void collectStats(HwSwitch* hwSwitch, int numPasses) {
+  SwitchStats dummy;
+  std::chrono::microseconds total{0}, worst{0};
+  for (auto i = 0; i < numPasses; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    hwSwitch->updateStats(&dummy);
+    auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    total += latency;
+    worst = std::max(worst, latency);
+  }
+  XLOG(INFO) << "Stats collection pass latency: avg "
+             << total.count() / numPasses << "us, max " << worst.count()
+             << "us";
+}
+
+} // namespace
+
 /*
  * Collect stats 10K times and benchmark that.
  * Using a fixed number rather than letting framework
@@ -38,12 +67,40 @@ BENCHMARK(HwStatsCollection) {
   auto config =
       utility::onePortPerVlanConfig(hwSwitch, ensemble->masterLogicalPortIds());
   ensemble->applyInitialConfig(config);
-  SwitchStats dummy;
   suspender.dismiss();
-  for (auto i = 0; i < 10'000; ++i) {
-    hwSwitch->updateStats(&dummy);
-  }
+  collectStats(hwSwitch, 10'000);
+  suspender.rehire();
+}
+
+/*
+ * Same as above, but with route updates being programmed concurrently.
+ * Stats collection should not have to wait on state updates (and vice
+ * versa), so this should be close to HwStatsCollection.
+ */
+BENCHMARK(HwStatsCollectionWithCompetingRouteUpdates) {
+  folly::BenchmarkSuspender suspender;
+  auto ensemble = createHwEnsemble({HwSwitchEnsemble::LINKSCAN});
+  auto hwSwitch = ensemble->getHwSwitch();
+  auto config =
+      utility::onePortPerVlanConfig(hwSwitch, ensemble->masterLogicalPortIds());
+  ensemble->applyInitialConfig(config);
+  auto routeStates = utility::RouteDistributionGenerator(
+                         ensemble->getProgrammedState(),
+                         {{64, 10'000}},
+                         {{}},
+                         1'000,
+                         4,
+                         RouterID(0))
+                         .getSwitchStates();
+  std::thread t([&ensemble, &routeStates]() {
+    for (const auto& state : routeStates) {
+      ensemble->applyNewState(state);
+    }
+  });
+  suspender.dismiss();
+  collectStats(hwSwitch, 10'000);
   suspender.rehire();
+  t.join();
 }
 
 } // namespace facebook::fboss
@@ -55,7 +55,10 @@ void runTxSlowPathBenchmark() {
 
   auto cpuMac = ensemble->getPlatform()->getLocalMac();
   std::atomic<bool> packetTxDone{false};
-  std::thread t([cpuMac, hwSwitch, &config, &packetTxDone]() {
+  // Packets the switch accepted for TX. Unlike the port counters this is also
+  // meaningful on fake ASICs, where nothing actually leaves the port.
+  std::atomic<uint64_t> pktsAccepted{0};
+  std::thread t([cpuMac, hwSwitch, &config, &packetTxDone, &pktsAccepted]() {
     const auto kSrcIp = folly::IPAddressV6("2620:0:1cfe:face:b00c::3");
     const auto kDstIp = folly::IPAddressV6("2620:0:1cfe:face:b00c::4");
     const auto kSrcMac = folly::MacAddress{"fa:ce:b0:00:00:0c"};
@@ -69,18 +72,22 @@ void runTxSlowPathBenchmark() {
             cpuMac,
             kSrcIp,
             kDstIp);
-        hwSwitch->sendPacketSwitchedAsync(std::move(txPacket));
+        if (hwSwitch->sendPacketSwitchedAsync(std::move(txPacket))) {
+          ++pktsAccepted;
+        }
       }
     }
   });
 
   auto [pktsBefore, bytesBefore] =
       getOutPktsAndBytes(ensemble.get(), PortID(portUsed));
+  auto acceptedBefore = pktsAccepted.load();
   auto timeBefore = std::chrono::steady_clock::now();
   // Let the packet flood warm up
   std::this_thread::sleep_for(std::chrono::seconds(5));
   auto [pktsAfter, bytesAfter] =
       getOutPktsAndBytes(ensemble.get(), PortID(portUsed));
+  auto acceptedAfter = pktsAccepted.load();
   auto timeAfter = std::chrono::steady_clock::now();
   packetTxDone = true;
   t.join();
@@ -92,16 +99,21 @@ void runTxSlowPathBenchmark() {
   uint32_t bytesPerSec = (static_cast<double>(bytesAfter - bytesBefore) /
                           durationMillseconds.count()) *
       1000;
+  uint32_t acceptedPps = (static_cast<double>(acceptedAfter - acceptedBefore) /
+                          durationMillseconds.count()) *
+      1000;
 
   if (FLAGS_json) {
     folly::dynamic cpuTxRateJson = folly::dynamic::object;
     cpuTxRateJson["cpu_tx_pps"] = pps;
     cpuTxRateJson["cpu_tx_bytes_per_sec"] = bytesPerSec;
+    cpuTxRateJson["cpu_tx_accepted_pps"] = acceptedPps;
     std::cout << toPrettyJson(cpuTxRateJson) << std::endl;
   } else {
     XLOG(INFO) << " Pkts before: " << pktsBefore << " Pkts after: " << pktsAfter
                << " interval ms: " << durationMillseconds.count()
-               << " pps: " << pps << " bytes per sec: " << bytesPerSec;
+               << " pps: " << pps << " bytes per sec: " << bytesPerSec
+               << " accepted pps: " << acceptedPps;
   }
 }
 } // namespace facebook::fboss
@@ -77,7 +77,7 @@ class SaiApi {
           "Attempting create SAI obj with {}, while hw writes are blocked",
           createAttributes);
     }
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = SaiApiLock::getInstance()->lock(ApiT::ApiType);
     sai_status_t status;
     {
       TIME_CALL;
@@ -109,7 +109,7 @@ class SaiApi {
           "Attempting create SAI obj with {}, while hw writes are blocked",
           createAttributes);
     }
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = SaiApiLock::getInstance()->lock(ApiT::ApiType);
     sai_status_t status;
     {
       TIME_CALL;
@@ -126,7 +126,7 @@ class SaiApi {
 
   template <typename AdapterKeyT>
   void remove(const AdapterKeyT& key) {
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = SaiApiLock::getInstance()->lock(ApiT::ApiType);
     if (UNLIKELY(failHwWrites_)) {
       XLOGF(
           FATAL,
@@ -166,7 +166,7 @@ class SaiApi {
         IsSaiAttribute<typename std::remove_reference<AttrT>::type>::value,
         "getAttribute must be called on a SaiAttribute or supported "
         "collection of SaiAttributes");
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = SaiApiLock::getInstance()->lock(ApiT::ApiType);
     sai_status_t status;
     {
       TIME_CALL;
@@ -303,10 +303,127 @@ class SaiApi {
   }
   template <typename AdapterKeyT, typename AttrT>
   void setAttribute(const AdapterKeyT& key, const AttrT& attr) {
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = SaiApiLock::getInstance()->lock(ApiT::ApiType);
     setAttributeUnlocked(key, attr);
   }
 
+  /*
+   * Bulk variants of create, remove and setAttribute for objects whose
+   * AdapterKey is an entry struct. The whole batch is issued under a single
+   * acquisition of the api lock, which is taken before checking whether hw
+   * writes are blocked.
+   *
+   * Unlike their single object counterparts, these do not throw when an
+   * individual entry fails. Instead, they return the status of every entry
+   * (in the order of the input) and leave it to the caller to decide what to
+   * do about the failed ones. If the adapter does not implement the bulk
+   * operation at all, every entry reports SAI_STATUS_NOT_IMPLEMENTED, and
+   * entries the adapter did not get to report SAI_STATUS_NOT_EXECUTED.
+   */
+  template <typename SaiObjectTraits>
+  std::enable_if_t<
+      AdapterKeyIsEntryStruct<SaiObjectTraits>::value,
+      std::vector<sai_status_t>>
+  bulkCreate(
+      const std::vector<typename SaiObjectTraits::AdapterKey>& entries,
+      const std::vector<typename SaiObjectTraits::CreateAttributes>&
+          createAttributes) {
+    static_assert(
+        std::is_same_v<typename SaiObjectTraits::SaiApiT, ApiT>,
+        "invalid traits for the api");
+    CHECK_EQ(entries.size(), createAttributes.size());
+    std::vector<sai_status_t> statuses(entries.size(), SAI_STATUS_NOT_EXECUTED);
+    if (entries.empty()) {
+      return statuses;
+    }
+    std::vector<std::vector<sai_attribute_t>> saiAttributeTs;
+    saiAttributeTs.reserve(createAttributes.size());
+    for (const auto& attributes : createAttributes) {
+      saiAttributeTs.push_back(saiAttrs(attributes));
+    }
+    std::vector<uint32_t> attrCounts;
+    std::vector<const sai_attribute_t*> attrLists;
+    attrCounts.reserve(saiAttributeTs.size());
+    attrLists.reserve(saiAttributeTs.size());
+    for (const auto& attrs : saiAttributeTs) {
+      attrCounts.push_back(attrs.size());
+      attrLists.push_back(attrs.data());
+    }
+    auto g = SaiApiLock::getInstance()->lock(ApiT::ApiType);
+    if (UNLIKELY(failHwWrites_)) {
+      XLOGF(
+          FATAL,
+          "Attempting bulk create of {} SAI objs, while hw writes are blocked",
+          entries.size());
+    }
+    sai_status_t status;
+    {
+      TIME_CALL;
+      status = impl()._bulkCreate(
+          entries, attrCounts.data(), attrLists.data(), statuses.data());
+    }
+    checkBulkStatus(status, statuses);
+    XLOGF(DBG5, "bulk created {} SAI objects", entries.size());
+    return statuses;
+  }
+
+  template <typename AdapterKeyT>
+  std::vector<sai_status_t> bulkRemove(const std::vector<AdapterKeyT>& keys) {
+    std::vector<sai_status_t> statuses(keys.size(), SAI_STATUS_NOT_EXECUTED);
+    if (keys.empty()) {
+      return statuses;
+    }
+    auto g = SaiApiLock::getInstance()->lock(ApiT::ApiType);
+    if (UNLIKELY(failHwWrites_)) {
+      XLOGF(
+          FATAL,
+          "Attempting bulk remove of {} SAI objs while hw writes are blocked",
+          keys.size());
+    }
+    sai_status_t status;
+    {
+      TIME_CALL;
+      status = impl()._bulkRemove(keys, statuses.data());
+    }
+    checkBulkStatus(status, statuses);
+    XLOGF(DBG5, "bulk removed {} SAI objects", keys.size());
+    return statuses;
+  }
+
+  // Sets attr[i] on keys[i]
+  template <typename AdapterKeyT, typename AttrT>
+  std::vector<sai_status_t> bulkSetAttribute(
+      const std::vector<AdapterKeyT>& keys,
+      const std::vector<AttrT>& attrs) {
+    CHECK_EQ(keys.size(), attrs.size());
+    std::vector<sai_status_t> statuses(keys.size(), SAI_STATUS_NOT_EXECUTED);
+    if (keys.empty()) {
+      return statuses;
+    }
+    std::vector<sai_attribute_t> saiAttributeTs;
+    saiAttributeTs.reserve(attrs.size());
+    for (const auto& attr : attrs) {
+      saiAttributeTs.push_back(*saiAttr(attr));
+    }
+    auto g = SaiApiLock::getInstance()->lock(ApiT::ApiType);
+    if (UNLIKELY(failHwWrites_)) {
+      XLOGF(
+          FATAL,
+          "Attempting bulk set of {} SAI attributes, while hw writes are "
+          "blocked",
+          keys.size());
+    }
+    sai_status_t status;
+    {
+      TIME_CALL;
+      status =
+          impl()._bulkSetAttribute(keys, saiAttributeTs.data(), statuses.data());
+    }
+    checkBulkStatus(status, statuses);
+    XLOGF(DBG5, "bulk set {} SAI attributes", keys.size());
+    return statuses;
+  }
+
   template <typename SaiObjectTraits>
   std::vector<uint64_t> getStats(
       const typename SaiObjectTraits::AdapterKey& key,
@@ -315,7 +432,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "getStats only supported for Sai objects with stats");
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = SaiApiLock::getInstance()->lock(ApiT::ApiType);
     return getStatsImpl<SaiObjectTraits>(
         key, counterIds.data(), counterIds.size(), mode);
   }
@@ -326,7 +443,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "getStats only supported for Sai objects with stats");
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = SaiApiLock::getInstance()->lock(ApiT::ApiType);
     XLOGF(DBG6, "got SAI stats for {}", key);
     return mode == SAI_STATS_MODE_READ
         ? getStatsImpl<SaiObjectTraits>(
@@ -348,7 +465,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "clearStats only supported for Sai objects with stats");
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = SaiApiLock::getInstance()->lock(ApiT::ApiType);
     clearStatsImpl<SaiObjectTraits>(key, counterIds.data(), counterIds.size());
   }
   template <typename SaiObjectTraits>
@@ -356,7 +473,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "clearStats only supported for Sai objects with stats");
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = SaiApiLock::getInstance()->lock(ApiT::ApiType);
     clearStatsImpl<SaiObjectTraits>(
         key,
         SaiObjectTraits::CounterIdsToRead.data(),
@@ -368,6 +485,26 @@ class SaiApi {
   }
 
  private:
+  /*
+   * A bulk call which fails as a whole, rather than on some of its entries,
+   * does not fill in the entry statuses. Reflect the overall failure on
+   * every entry in that case, so callers only need to look at one place.
+   */
+  static void checkBulkStatus(
+      sai_status_t status,
+      std::vector<sai_status_t>& statuses) {
+    if (status == SAI_STATUS_NOT_IMPLEMENTED ||
+        status == SAI_STATUS_NOT_SUPPORTED) {
+      std::fill(statuses.begin(), statuses.end(), status);
+    } else if (status != SAI_STATUS_SUCCESS) {
+      XLOGF(
+          WARNING,
+          "{} bulk operation failed: {}",
+          saiApiTypeToString(ApiT::ApiType),
+          saiStatusToString(status));
+    }
+  }
+
   template <typename SaiObjectTraits>
   std::vector<uint64_t> getStatsImpl(
       const typename SaiObjectTraits::AdapterKey& key,
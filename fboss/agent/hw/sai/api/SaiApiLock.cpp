@@ -10,14 +10,53 @@
 
 #include "fboss/agent/hw/sai/api/SaiApiLock.h"
 
+#include <fb303/ServiceData.h>
 #include <folly/Singleton.h>
+#include <gflags/gflags.h>
+
+#include <chrono>
 #include <mutex>
 
+DEFINE_bool(
+    sai_api_lock_per_api,
+    false,
+    "Serialize SAI calls per SAI api rather than across all apis. Only safe "
+    "for SDKs which are thread safe across apis");
+
 namespace {
 struct singleton_tag_type {};
+
+constexpr auto kContendedCounter = "sai_api_lock.contended";
+constexpr auto kWaitUsecsCounter = "sai_api_lock.wait_us";
 } // namespace
 
 static folly::Singleton<SaiApiLock, singleton_tag_type> saiApiLockSingleton{};
 std::shared_ptr<SaiApiLock> SaiApiLock::getInstance() {
   return saiApiLockSingleton.try_get();
 }
+
+SaiApiLock::SaiApiLock() : perApi_(FLAGS_sai_api_lock_per_api) {}
+
+std::unique_lock<std::mutex> SaiApiLock::lock(sai_api_t apiType) {
+  std::unique_lock<std::mutex> guard(getMutex(apiType), std::try_to_lock);
+  if (guard.owns_lock()) {
+    return guard;
+  }
+  auto start = std::chrono::steady_clock::now();
+  guard.lock();
+  auto waited = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  facebook::fb303::fbData->addStatValue(
+      kContendedCounter, 1, facebook::fb303::SUM);
+  facebook::fb303::fbData->addStatValue(
+      kWaitUsecsCounter, waited.count(), facebook::fb303::SUM);
+  return guard;
+}
+
+std::mutex& SaiApiLock::getMutex(sai_api_t apiType) {
+  // extension apis live outside of [0, SAI_API_MAX)
+  if (!perApi_ || apiType < 0 || apiType >= SAI_API_MAX) {
+    return globalLock_;
+  }
+  return apiLocks_[apiType];
+}
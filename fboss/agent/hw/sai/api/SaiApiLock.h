@@ -9,11 +9,41 @@
  */
 #pragma once
 
+#include <array>
 #include <memory>
 #include <mutex>
 
+extern "C" {
+#include <sai.h>
+}
+
+/*
+ * Serializes calls into the SAI adapter.
+ *
+ * By default, a single mutex is shared by every SAI api, since we can not
+ * assume that an SDK is thread safe. For SDKs which are known to be thread
+ * safe across apis, --sai_api_lock_per_api gives each sai_api_t its own
+ * mutex instead, so that e.g., port stats collection does not wait on route
+ * programming. The mode is fixed when the lock is first used.
+ *
+ * Time spent waiting on a contended lock is exported to fb303 as
+ * sai_api_lock.contended (count) and sai_api_lock.wait_us (sum).
+ */
 class SaiApiLock {
  public:
+  SaiApiLock();
   static std::shared_ptr<SaiApiLock> getInstance();
-  std::mutex lock;
+
+  std::unique_lock<std::mutex> lock(sai_api_t apiType);
+
+  bool isPerApi() const {
+    return perApi_;
+  }
+
+ private:
+  std::mutex& getMutex(sai_api_t apiType);
+
+  const bool perApi_;
+  std::mutex globalLock_;
+  std::array<std::mutex, SAI_API_MAX> apiLocks_;
 };
@@ -174,6 +174,67 @@ TEST_F(RouteApiTest, routeKeys) {
   EXPECT_EQ(routeKeys[0], r);
 }
 
+TEST_F(RouteApiTest, bulkCreateSetRemove) {
+  std::vector<SaiRouteTraits::RouteEntry> entries;
+  std::vector<SaiRouteTraits::CreateAttributes> attributes;
+  for (sai_object_id_t i = 0; i < 10; ++i) {
+    folly::CIDRNetwork prefix(
+        folly::IPAddress(folly::sformat("10.0.{}.0", i)), 24);
+    entries.emplace_back(0, 0, prefix);
+    attributes.push_back(SaiRouteTraits::CreateAttributes{
+        SAI_PACKET_ACTION_FORWARD, i, std::nullopt});
+  }
+  auto statuses = routeApi->bulkCreate<SaiRouteTraits>(entries, attributes);
+  EXPECT_EQ(statuses, std::vector<sai_status_t>(10, SAI_STATUS_SUCCESS));
+  EXPECT_EQ(getObjectCount<SaiRouteTraits>(0), 10);
+  for (sai_object_id_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(
+        routeApi->getAttribute(
+            entries[i], SaiRouteTraits::Attributes::NextHopId()),
+        i);
+  }
+
+  std::vector<SaiRouteTraits::Attributes::NextHopId> nextHops;
+  for (sai_object_id_t i = 0; i < 10; ++i) {
+    nextHops.emplace_back(42 + i);
+  }
+  statuses = routeApi->bulkSetAttribute(entries, nextHops);
+  EXPECT_EQ(statuses, std::vector<sai_status_t>(10, SAI_STATUS_SUCCESS));
+  for (sai_object_id_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(
+        routeApi->getAttribute(
+            entries[i], SaiRouteTraits::Attributes::NextHopId()),
+        42 + i);
+  }
+
+  statuses = routeApi->bulkRemove(entries);
+  EXPECT_EQ(statuses, std::vector<sai_status_t>(10, SAI_STATUS_SUCCESS));
+  EXPECT_EQ(getObjectCount<SaiRouteTraits>(0), 0);
+}
+
+TEST_F(RouteApiTest, bulkPerEntryStatus) {
+  folly::CIDRNetwork prefix1(ip4, 24);
+  folly::CIDRNetwork prefix2(ip6, 64);
+  SaiRouteTraits::RouteEntry r1(0, 0, prefix1);
+  SaiRouteTraits::RouteEntry r2(0, 0, prefix2);
+  SaiRouteTraits::CreateAttributes attributes{
+      SAI_PACKET_ACTION_DROP, std::nullopt, std::nullopt};
+  routeApi->create<SaiRouteTraits>(r1, attributes);
+
+  // Only the already existing entry fails, the other one is still created
+  auto statuses =
+      routeApi->bulkCreate<SaiRouteTraits>({r1, r2}, {attributes, attributes});
+  EXPECT_EQ(statuses[0], SAI_STATUS_ITEM_ALREADY_EXISTS);
+  EXPECT_EQ(statuses[1], SAI_STATUS_SUCCESS);
+  EXPECT_EQ(getObjectCount<SaiRouteTraits>(0), 2);
+
+  routeApi->remove(r1);
+  statuses = routeApi->bulkRemove(std::vector{r1, r2});
+  EXPECT_EQ(statuses[0], SAI_STATUS_ITEM_NOT_FOUND);
+  EXPECT_EQ(statuses[1], SAI_STATUS_SUCCESS);
+  EXPECT_EQ(getObjectCount<SaiRouteTraits>(0), 0);
+}
+
 TEST_F(RouteApiTest, formatRouteNextHopId) {
   SaiRouteTraits::Attributes::NextHopId nhid{42};
   std::string expected("NextHopId: 42");
@@ -0,0 +1,81 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/api/SaiApiLock.h"
+
+#include <fb303/ServiceData.h>
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <map>
+#include <string>
+
+DECLARE_bool(sai_api_lock_per_api);
+
+namespace {
+
+constexpr auto kWaitForBlocked = std::chrono::milliseconds(100);
+constexpr auto kWaitForUnblocked = std::chrono::seconds(10);
+
+const auto kExtensionApi = static_cast<sai_api_t>(SAI_API_MAX + 1);
+const auto kOtherExtensionApi = static_cast<sai_api_t>(SAI_API_MAX + 2);
+
+int64_t getContendedCount() {
+  std::map<std::string, int64_t> counters;
+  facebook::fb303::fbData->getCounters(counters);
+  auto it = counters.find("sai_api_lock.contended.sum");
+  return it == counters.end() ? 0 : it->second;
+}
+
+/*
+ * Takes the lock for apiType on another thread, while the lock for heldApi
+ * is held. Returns whether the other thread had to wait for the lock held.
+ */
+bool blocksOn(SaiApiLock* lock, sai_api_t heldApi, sai_api_t apiType) {
+  auto guard = lock->lock(heldApi);
+  auto locked = std::async(
+      std::launch::async, [lock, apiType]() { lock->lock(apiType); });
+  bool blocked =
+      locked.wait_for(kWaitForBlocked) == std::future_status::timeout;
+  guard.unlock();
+  EXPECT_EQ(std::future_status::ready, locked.wait_for(kWaitForUnblocked));
+  return blocked;
+}
+
+} // namespace
+
+TEST(SaiApiLockTest, globalLock) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_sai_api_lock_per_api = false;
+  SaiApiLock lock;
+  EXPECT_FALSE(lock.isPerApi());
+
+  auto contended = getContendedCount();
+  EXPECT_TRUE(blocksOn(&lock, SAI_API_PORT, SAI_API_ROUTE));
+  EXPECT_TRUE(blocksOn(&lock, SAI_API_PORT, kExtensionApi));
+  EXPECT_EQ(contended + 2, getContendedCount());
+}
+
+TEST(SaiApiLockTest, perApiLock) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_sai_api_lock_per_api = true;
+  SaiApiLock lock;
+  EXPECT_TRUE(lock.isPerApi());
+
+  auto contended = getContendedCount();
+  EXPECT_FALSE(blocksOn(&lock, SAI_API_PORT, SAI_API_ROUTE));
+  EXPECT_TRUE(blocksOn(&lock, SAI_API_PORT, SAI_API_PORT));
+  // Extension apis all share the global lock
+  EXPECT_TRUE(blocksOn(&lock, kExtensionApi, kOtherExtensionApi));
+  EXPECT_FALSE(blocksOn(&lock, kExtensionApi, SAI_API_PORT));
+  EXPECT_EQ(contended + 2, getContendedCount());
+}
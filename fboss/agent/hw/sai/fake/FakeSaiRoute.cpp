@@ -98,6 +98,91 @@ sai_status_t get_route_entry_attribute_fn(
   return SAI_STATUS_SUCCESS;
 }
 
+namespace {
+
+bool route_entry_exists(const sai_route_entry_t* route_entry) {
+  auto fs = FakeSai::getInstance();
+  auto re = std::make_tuple(
+      route_entry->switch_id,
+      route_entry->vr_id,
+      facebook::fboss::fromSaiIpPrefix(route_entry->destination));
+  return fs->routeManager.map().count(re);
+}
+
+/*
+ * Run a bulk operation one entry at a time, filling in the per-entry
+ * statuses. With SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, entries after the
+ * first failure are not attempted and are reported as not executed.
+ */
+template <typename EntryOp>
+sai_status_t bulk_route_op(
+    uint32_t object_count,
+    sai_bulk_op_error_mode_t mode,
+    sai_status_t* object_statuses,
+    EntryOp entryOp) {
+  sai_status_t status = SAI_STATUS_SUCCESS;
+  for (uint32_t i = 0; i < object_count; ++i) {
+    if (status != SAI_STATUS_SUCCESS &&
+        mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR) {
+      object_statuses[i] = SAI_STATUS_NOT_EXECUTED;
+      continue;
+    }
+    object_statuses[i] = entryOp(i);
+    if (object_statuses[i] != SAI_STATUS_SUCCESS) {
+      status = SAI_STATUS_FAILURE;
+    }
+  }
+  return status;
+}
+
+} // namespace
+
+sai_status_t create_route_entries_fn(
+    uint32_t object_count,
+    const sai_route_entry_t* route_entry,
+    const uint32_t* attr_count,
+    const sai_attribute_t** attr_list,
+    sai_bulk_op_error_mode_t mode,
+    sai_status_t* object_statuses) {
+  return bulk_route_op(
+      object_count, mode, object_statuses, [&](uint32_t i) -> sai_status_t {
+        if (route_entry_exists(&route_entry[i])) {
+          return SAI_STATUS_ITEM_ALREADY_EXISTS;
+        }
+        return create_route_entry_fn(
+            &route_entry[i], attr_count[i], attr_list[i]);
+      });
+}
+
+sai_status_t remove_route_entries_fn(
+    uint32_t object_count,
+    const sai_route_entry_t* route_entry,
+    sai_bulk_op_error_mode_t mode,
+    sai_status_t* object_statuses) {
+  return bulk_route_op(
+      object_count, mode, object_statuses, [&](uint32_t i) -> sai_status_t {
+        if (!route_entry_exists(&route_entry[i])) {
+          return SAI_STATUS_ITEM_NOT_FOUND;
+        }
+        return remove_route_entry_fn(&route_entry[i]);
+      });
+}
+
+sai_status_t set_route_entries_attribute_fn(
+    uint32_t object_count,
+    const sai_route_entry_t* route_entry,
+    const sai_attribute_t* attr_list,
+    sai_bulk_op_error_mode_t mode,
+    sai_status_t* object_statuses) {
+  return bulk_route_op(
+      object_count, mode, object_statuses, [&](uint32_t i) -> sai_status_t {
+        if (!route_entry_exists(&route_entry[i])) {
+          return SAI_STATUS_ITEM_NOT_FOUND;
+        }
+        return set_route_entry_attribute_fn(&route_entry[i], &attr_list[i]);
+      });
+}
+
 namespace facebook::fboss {
 
 static sai_route_api_t _route_api;
@@ -107,6 +192,9 @@ void populate_route_api(sai_route_api_t** route_api) {
   _route_api.remove_route_entry = &remove_route_entry_fn;
   _route_api.set_route_entry_attribute = &set_route_entry_attribute_fn;
   _route_api.get_route_entry_attribute = &get_route_entry_attribute_fn;
+  _route_api.create_route_entries = &create_route_entries_fn;
+  _route_api.remove_route_entries = &remove_route_entries_fn;
+  _route_api.set_route_entries_attribute = &set_route_entries_attribute_fn;
   *route_api = &_route_api;
 }
 
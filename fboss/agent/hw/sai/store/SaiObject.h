@@ -165,7 +165,7 @@ typename std::
  * moved from. If it is live, destroying the SaiObject removes the
  * corresponding object from SAI.
  *
- * A SaiObject can be constructed in three ways:
+ * A SaiObject can be constructed in four ways:
  * 1. By loading it from the SAI adapter using the AdapterKey. This can be
  *    thought of as the SaiObject taking control of an existing object in SAI.
  * 2. By creating a new object in the SAI adapter using the AdapterHostKey and
@@ -175,7 +175,10 @@ typename std::
  *    SaiObject manages a given SAI object. (N.B., there is no general hard
  *    guarantee for this property -- a user could load the same SaiObject more
  *    than once).
- * In all three cases, (excepting the unlikely event of moving from a non-live
+ * 4. By adopting an object which was already created in the SAI adapter,
+ *    e.g., by a bulk create issued by SaiObjectStore, along with the
+ *    CreateAttributes it was created with.
+ * In all four cases, (excepting the unlikely event of moving from a non-live
  * SaiObject), the newly constructed SaiObject is live and stores the
  * appropriate values of AdapterHostKey, AdapterKey, and CreateAttributes.
  *
@@ -234,6 +237,18 @@ class SaiObject {
     live_ = true;
   }
 
+  // Take ownership of an object which was already created in the SAI
+  // adapter with the given attributes (e.g., by a bulk create)
+  SaiObject(
+      const typename SaiObjectTraits::AdapterKey& adapterKey,
+      const typename SaiObjectTraits::AdapterHostKey& adapterHostKey,
+      const typename SaiObjectTraits::CreateAttributes& attributes)
+      : adapterKey_(adapterKey),
+        adapterHostKey_(adapterHostKey),
+        attributes_(attributes) {
+    live_ = true;
+  }
+
  public:
   // Forbid copy construction and copy assignment
   SaiObject(const SaiObject& other) = delete;
@@ -26,6 +26,8 @@
 #include <optional>
 #include <sstream>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 extern "C" {
 #include <sai.h>
@@ -189,6 +191,127 @@ class SaiObjectStore {
     return object;
   }
 
+  /*
+   * Bulk version of setObject for objects whose AdapterKey is an entry
+   * struct. Objects which do not exist yet are created with a single bulk
+   * create, while changed attributes of existing objects are programmed with
+   * one bulk set per attribute, in CreateAttributes order (the same order
+   * setAttributes uses).
+   *
+   * Entries the adapter did not program in bulk (bulk operation unsupported
+   * or not executed) are retried one at a time. Any other per-entry failure
+   * is thrown once the rest of the batch has been programmed.
+   */
+  std::vector<std::shared_ptr<ObjectType>> setObjects(
+      const std::vector<typename SaiObjectTraits::AdapterHostKey>&
+          adapterHostKeys,
+      const std::vector<typename SaiObjectTraits::CreateAttributes>&
+          attributes) {
+    static_assert(
+        AdapterKeyIsEntryStruct<SaiObjectTraits>::value,
+        "bulk programming is only supported for entry struct objects");
+    static_assert(
+        !IsObjectPublisher<SaiObjectTraits>::value,
+        "bulk programming is not supported for publisher objects");
+    CHECK_EQ(adapterHostKeys.size(), attributes.size());
+    XLOGF(
+        DBG5,
+        "SaiStore bulk setting {} {} objects",
+        adapterHostKeys.size(),
+        objectTypeName());
+    std::vector<std::shared_ptr<ObjectType>> objects(adapterHostKeys.size());
+    std::vector<size_t> toCreate;
+    std::vector<size_t> toUpdate;
+    for (size_t i = 0; i < adapterHostKeys.size(); ++i) {
+      objects[i] = objects_.ref(adapterHostKeys[i]);
+      if (objects[i]) {
+        toUpdate.push_back(i);
+      } else {
+        toCreate.push_back(i);
+      }
+    }
+    std::optional<std::pair<sai_status_t, size_t>> failure;
+    bulkCreate(adapterHostKeys, attributes, toCreate, objects, failure);
+    bulkSetAttributes(
+        attributes,
+        toUpdate,
+        objects,
+        failure,
+        std::make_index_sequence<
+            std::tuple_size_v<typename SaiObjectTraits::CreateAttributes>>{});
+    for (auto i : toUpdate) {
+      objects[i]->attributes_ = attributes[i];
+    }
+    for (const auto& adapterHostKey : adapterHostKeys) {
+      warmBootHandles_.erase(adapterHostKey);
+    }
+    if (failure) {
+      saiApiCheckError(
+          failure->first,
+          SaiObjectTraits::SaiApiT::ApiType,
+          fmt::format(
+              "Failed to bulk program sai entity {}: {}",
+              adapterHostKeys[failure->second],
+              attributes[failure->second]));
+    }
+    XLOGF(
+        DBG5,
+        "SaiStore bulk set {} {} objects",
+        adapterHostKeys.size(),
+        objectTypeName());
+    return objects;
+  }
+
+  /*
+   * Bulk remove objects which are referenced only by the given pointers.
+   * Objects which still have other references are just dereferenced, as
+   * they would be when any other SaiObject pointer is dropped. Entries the
+   * adapter did not remove in bulk are removed one at a time.
+   */
+  void removeObjects(std::vector<std::shared_ptr<ObjectType>> objects) {
+    static_assert(
+        AdapterKeyIsEntryStruct<SaiObjectTraits>::value,
+        "bulk programming is only supported for entry struct objects");
+    static_assert(
+        !IsObjectPublisher<SaiObjectTraits>::value,
+        "bulk programming is not supported for publisher objects");
+    std::vector<std::shared_ptr<ObjectType>> toRemove;
+    std::vector<typename SaiObjectTraits::AdapterKey> adapterKeys;
+    for (auto& object : objects) {
+      if (object && object.use_count() == 1) {
+        adapterKeys.push_back(object->adapterKey());
+        toRemove.push_back(std::move(object));
+      }
+    }
+    objects.clear();
+    auto& api =
+        SaiApiTable::getInstance()->getApi<typename SaiObjectTraits::SaiApiT>();
+    auto statuses = api.bulkRemove(adapterKeys);
+    std::optional<std::pair<sai_status_t, size_t>> failure;
+    for (size_t i = 0; i < statuses.size(); ++i) {
+      if (retryWithoutBulk(statuses[i])) {
+        // removed by the SaiObject destructor
+        continue;
+      }
+      if (statuses[i] != SAI_STATUS_SUCCESS &&
+          !(statuses[i] == SAI_STATUS_ITEM_NOT_FOUND &&
+            toRemove[i]->ignoreMissingInHwOnDelete_) &&
+          !failure) {
+        failure = std::make_pair(statuses[i], i);
+      }
+      toRemove[i]->release();
+    }
+    toRemove.clear();
+    if (failure) {
+      saiApiCheckError(
+          failure->first,
+          SaiObjectTraits::SaiApiT::ApiType,
+          fmt::format(
+              "Failed to bulk remove sai object: {}",
+              adapterKeys[failure->second]));
+    }
+  }
+
   std::shared_ptr<ObjectType> get(
       const typename SaiObjectTraits::AdapterHostKey& adapterHostKey) {
     XLOGF(DBG5, "SaiStore get object {}", adapterHostKey);
@@ -308,6 +431,115 @@ class SaiObjectStore {
     return std::make_pair(ins.first, notify);
   }
 
+  static bool retryWithoutBulk(sai_status_t status) {
+    return status == SAI_STATUS_NOT_IMPLEMENTED ||
+        status == SAI_STATUS_NOT_SUPPORTED || status == SAI_STATUS_NOT_EXECUTED;
+  }
+
+  void bulkCreate(
+      const std::vector<typename SaiObjectTraits::AdapterHostKey>&
+          adapterHostKeys,
+      const std::vector<typename SaiObjectTraits::CreateAttributes>&
+          attributes,
+      const std::vector<size_t>& toCreate,
+      std::vector<std::shared_ptr<ObjectType>>& objects,
+      std::optional<std::pair<sai_status_t, size_t>>& failure) {
+    if (toCreate.empty()) {
+      return;
+    }
+    std::vector<typename SaiObjectTraits::AdapterKey> adapterKeys;
+    std::vector<typename SaiObjectTraits::CreateAttributes> createAttributes;
+    adapterKeys.reserve(toCreate.size());
+    createAttributes.reserve(toCreate.size());
+    for (auto i : toCreate) {
+      adapterKeys.push_back(adapterHostKeys[i]);
+      createAttributes.push_back(attributes[i]);
+    }
+    auto& api =
+        SaiApiTable::getInstance()->getApi<typename SaiObjectTraits::SaiApiT>();
+    auto statuses =
+        api.template bulkCreate<SaiObjectTraits>(adapterKeys, createAttributes);
+    for (size_t j = 0; j < statuses.size(); ++j) {
+      auto i = toCreate[j];
+      if (statuses[j] == SAI_STATUS_SUCCESS) {
+        objects[i] = objects_
+                         .refOrInsert(
+                             adapterHostKeys[i],
+                             ObjectType(
+                                 adapterKeys[j],
+                                 adapterHostKeys[i],
+                                 createAttributes[j]),
+                             true /*force*/)
+                         .first;
+      } else if (retryWithoutBulk(statuses[j])) {
+        objects[i] = program(adapterHostKeys[i], attributes[i]).first;
+      } else if (!failure) {
+        failure = std::make_pair(statuses[j], i);
+      }
+    }
+  }
+
+  template <size_t... Indices>
+  void bulkSetAttributes(
+      const std::vector<typename SaiObjectTraits::CreateAttributes>&
+          attributes,
+      const std::vector<size_t>& toUpdate,
+      std::vector<std::shared_ptr<ObjectType>>& objects,
+      std::optional<std::pair<sai_status_t, size_t>>& failure,
+      std::index_sequence<Indices...>) {
+    (bulkSetAttribute<Indices>(attributes, toUpdate, objects, failure), ...);
+  }
+
+  template <typename AttrT>
+  static const AttrT* bulkSetValue(const AttrT& attr) {
+    return &attr;
+  }
+  template <typename AttrT>
+  static const AttrT* bulkSetValue(const std::optional<AttrT>& attr) {
+    // an unset optional attribute is left untouched, as in setAttributes
+    return attr ? &attr.value() : nullptr;
+  }
+
+  template <size_t Index>
+  void bulkSetAttribute(
+      const std::vector<typename SaiObjectTraits::CreateAttributes>&
+          attributes,
+      const std::vector<size_t>& toUpdate,
+      std::vector<std::shared_ptr<ObjectType>>& objects,
+      std::optional<std::pair<sai_status_t, size_t>>& failure) {
+    using AttrT = std::decay_t<std::remove_pointer_t<decltype(bulkSetValue(
+        std::get<Index>(std::declval<
+                        typename SaiObjectTraits::CreateAttributes>())))>>;
+    std::vector<size_t> changed;
+    std::vector<typename SaiObjectTraits::AdapterKey> adapterKeys;
+    std::vector<AttrT> newAttrs;
+    for (auto i : toUpdate) {
+      const auto& newAttr = std::get<Index>(attributes[i]);
+      if (std::get<Index>(objects[i]->attributes_) == newAttr) {
+        continue;
+      }
+      if (const auto* value = bulkSetValue(newAttr)) {
+        changed.push_back(i);
+        adapterKeys.push_back(objects[i]->adapterKey());
+        newAttrs.push_back(*value);
+      }
+    }
+    if (changed.empty()) {
+      return;
+    }
+    auto& api =
+        SaiApiTable::getInstance()->getApi<typename SaiObjectTraits::SaiApiT>();
+    auto statuses = api.bulkSetAttribute(adapterKeys, newAttrs);
+    for (size_t j = 0; j < statuses.size(); ++j) {
+      auto i = changed[j];
+      if (retryWithoutBulk(statuses[j])) {
+        objects[i]->checkAndSetAttribute(std::get<Index>(attributes[i]));
+      } else if (statuses[j] != SAI_STATUS_SUCCESS && !failure) {
+        failure = std::make_pair(statuses[j], i);
+      }
+    }
+  }
+
   std::vector<typename SaiObjectTraits::AdapterKey> getAdapterKeys(
       const folly::dynamic* adapterKeysJson) const {
     return adapterKeysJson ? adapterKeysFromFollyDynamic(*adapterKeysJson)
@@ -102,6 +102,49 @@ TEST_F(SaiStoreTest, routeSetToPunt) {
   */
 }
 
+TEST_F(SaiStoreTest, bulkSetAndRemoveRoutes) {
+  auto& routeApi = saiApiTable->routeApi();
+  folly::CIDRNetwork existingDest(folly::IPAddress{"10.0.0.0"}, 24);
+  folly::CIDRNetwork addedDest(folly::IPAddress{"10.0.1.0"}, 24);
+  SaiRouteTraits::RouteEntry existing(0, 0, existingDest);
+  SaiRouteTraits::RouteEntry added(0, 0, addedDest);
+  routeApi.create<SaiRouteTraits>(
+      existing, {SAI_PACKET_ACTION_FORWARD, 5, std::nullopt});
+
+  std::shared_ptr<SaiStore> s = SaiStore::getInstance();
+  s->setSwitchId(0);
+  s->reload();
+  auto& store = s->get<SaiRouteTraits>();
+
+  auto routes = store.setObjects(
+      {existing, added},
+      {{SAI_PACKET_ACTION_FORWARD, 6, 42},
+       {SAI_PACKET_ACTION_DROP, std::nullopt, std::nullopt}});
+  ASSERT_EQ(routes.size(), 2);
+  EXPECT_EQ(routes[0], store.get(existing));
+  EXPECT_EQ(routes[1], store.get(added));
+  EXPECT_EQ(store.warmBootHandlesCount(), 0);
+  EXPECT_EQ(GET_OPT_ATTR(Route, NextHopId, routes[0]->attributes()), 6);
+  EXPECT_EQ(GET_OPT_ATTR(Route, Metadata, routes[0]->attributes()), 42);
+  EXPECT_EQ(
+      routeApi.getAttribute(existing, SaiRouteTraits::Attributes::NextHopId{}),
+      6);
+  EXPECT_EQ(
+      routeApi.getAttribute(existing, SaiRouteTraits::Attributes::Metadata{}),
+      42);
+  EXPECT_EQ(
+      routeApi.getAttribute(added, SaiRouteTraits::Attributes::PacketAction{}),
+      SAI_PACKET_ACTION_DROP);
+
+  // A route which is still referenced elsewhere must stay programmed
+  auto stillUsed = routes[1];
+  store.removeObjects(std::move(routes));
+  EXPECT_FALSE(store.get(existing));
+  EXPECT_EQ(getObjectCount<SaiRouteTraits>(0), 1);
+  stillUsed.reset();
+  EXPECT_EQ(getObjectCount<SaiRouteTraits>(0), 0);
+}
+
 TEST_F(SaiStoreTest, formatTest) {
   folly::IPAddress ip4{"10.10.10.1"};
   folly::CIDRNetwork dest(ip4, 24);
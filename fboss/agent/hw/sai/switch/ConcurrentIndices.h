@@ -14,12 +14,25 @@
 #include "fboss/agent/hw/sai/api/Types.h"
 #include "fboss/agent/types.h"
 
+#include <utility>
+#include <vector>
+
 extern "C" {
 #include <sai.h>
 }
 
 namespace facebook::fboss {
 
+/*
+ * SAI ids which stats collection reads counters from, for a port
+ * whose stats we export.
+ */
+struct PortStatsSaiIds {
+  PortSaiId portSaiId;
+  // (queue id, queue sai id) of each configured queue of the port
+  std::vector<std::pair<uint8_t, QueueSaiId>> queueSaiIds;
+};
+
 struct ConcurrentIndices {
   ~ConcurrentIndices();
   /*
@@ -36,6 +49,12 @@ struct ConcurrentIndices {
    * to sai port id.
    */
   folly::ConcurrentHashMap<PortID, PortSaiId> portSaiIds;
+  /*
+   * Indexed by PortID, only has entries for enabled ports. Modified by
+   * port/queue updates and read by stats collection, so that collecting
+   * counters does not need to walk port handles under the switch lock.
+   */
+  folly::ConcurrentHashMap<PortID, PortStatsSaiIds> portStatsSaiIds;
 };
 
 } // namespace facebook::fboss
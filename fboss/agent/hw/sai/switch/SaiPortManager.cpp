@@ -201,10 +201,16 @@ PortSaiId SaiPortManager::addPort(const std::shared_ptr<Port>& swPort) {
         SaiBridgePortTraits::Attributes::FdbLearningMode{
             getFdbLearningMode(l2LearningMode_.value())});
   }
+  portHandle = handle.get();
   handles_.emplace(swPort->getID(), std::move(handle));
-  if (swPort->isEnabled()) {
-    portStats_.emplace(
-        swPort->getID(), std::make_unique<HwPortFb303Stats>(swPort->getName()));
+  {
+    std::lock_guard<std::mutex> lock(portStatsMutex_);
+    if (swPort->isEnabled()) {
+      portStats_.emplace(
+          swPort->getID(),
+          std::make_unique<HwPortFb303Stats>(swPort->getName()));
+    }
+    updateStatsSaiIdsLocked(swPort->getID(), portHandle);
   }
   if (globalDscpToTcQosMap_) {
     // Both global maps must exist in one of them exists
@@ -243,9 +249,14 @@ void SaiPortManager::removePort(const std::shared_ptr<Port>& swPort) {
   concurrentIndices_->portIds.erase(itr->second->port->adapterKey());
   concurrentIndices_->portSaiIds.erase(swId);
   concurrentIndices_->vlanIds.erase(itr->second->port->adapterKey());
+  {
+    // Stop stats collection before the port goes away
+    std::lock_guard<std::mutex> lock(portStatsMutex_);
+    portStats_.erase(swId);
+    updateStatsSaiIdsLocked(swId, nullptr);
+  }
   addRemovedHandle(itr->first);
   handles_.erase(itr);
-  portStats_.erase(swId);
   // TODO: do FDB entries associated with this port need to be removed
   // now?
   XLOG(INFO) << "removed port " << swPort->getID() << " with vlan "
@@ -260,6 +271,7 @@ void SaiPortManager::changeQueue(
   if (!portHandle) {
     throw FbossError("Attempted to change non-existent port ");
   }
+  std::lock_guard<std::mutex> lock(portStatsMutex_);
   auto pitr = portStats_.find(swId);
   portHandle->configuredQueues.clear();
   const auto asic = platform_->getAsic();
@@ -309,6 +321,7 @@ void SaiPortManager::changeQueue(
       }
     }
   }
+  updateStatsSaiIdsLocked(swId, portHandle);
 }
 
 void SaiPortManager::changePort(
@@ -346,20 +359,24 @@ void SaiPortManager::changePort(
     auto platformPort = platform_->getPort(newPort->getID());
     platformPort->setCurrentProfile(newPort->getProfileID());
   }
-  if (newPort->isEnabled()) {
-    if (!oldPort->isEnabled()) {
-      // Port transitioned from disabled to enabled, setup port stats
-      portStats_.emplace(
-          newPort->getID(),
-          std::make_unique<HwPortFb303Stats>(newPort->getName()));
-    } else if (oldPort->getName() != newPort->getName()) {
-      // Port was already enabled, but Port name changed - update stats
-      portStats_.find(newPort->getID())
-          ->second->portNameChanged(newPort->getName());
+  {
+    std::lock_guard<std::mutex> lock(portStatsMutex_);
+    if (newPort->isEnabled()) {
+      if (!oldPort->isEnabled()) {
+        // Port transitioned from disabled to enabled, setup port stats
+        portStats_.emplace(
+            newPort->getID(),
+            std::make_unique<HwPortFb303Stats>(newPort->getName()));
+      } else if (oldPort->getName() != newPort->getName()) {
+        // Port was already enabled, but Port name changed - update stats
+        portStats_.find(newPort->getID())
+            ->second->portNameChanged(newPort->getName());
+      }
+    } else if (oldPort->isEnabled()) {
+      // Port transitioned from enabled to disabled, remove stats
+      portStats_.erase(newPort->getID());
     }
-  } else if (oldPort->isEnabled()) {
-    // Port transitioned from enabled to disabled, remove stats
-    portStats_.erase(newPort->getID());
+    updateStatsSaiIdsLocked(newPort->getID(), existingPort);
   }
   changeQueue(
       newPort->getID(), oldPort->getPortQueues(), newPort->getPortQueues());
@@ -543,18 +560,38 @@ const std::vector<sai_stat_id_t>& SaiPortManager::supportedStats() const {
   return counterIds;
 }
 
-void SaiPortManager::updateStats(PortID portId) {
-  auto handlesItr = handles_.find(portId);
-  if (handlesItr == handles_.end()) {
+void SaiPortManager::updateStatsSaiIdsLocked(
+    PortID portId,
+    const SaiPortHandle* handle) {
+  if (!handle || portStats_.find(portId) == portStats_.end()) {
+    concurrentIndices_->portStatsSaiIds.erase(portId);
     return;
   }
-  auto now = duration_cast<seconds>(system_clock::now().time_since_epoch());
-  auto* handle = handlesItr->second.get();
+  PortStatsSaiIds statsSaiIds{handle->port->adapterKey(), {}};
+  for (const auto& [queueConfig, queueHandle] : handle->queues) {
+    if (std::find(
+            handle->configuredQueues.begin(),
+            handle->configuredQueues.end(),
+            queueHandle.get()) != handle->configuredQueues.end()) {
+      statsSaiIds.queueSaiIds.emplace_back(
+          queueConfig.first, queueHandle->queue->adapterKey());
+    }
+  }
+  concurrentIndices_->portStatsSaiIds.insert_or_assign(
+      portId, std::move(statsSaiIds));
+}
+
+void SaiPortManager::updateStats(PortID portId) {
+  std::lock_guard<std::mutex> lock(portStatsMutex_);
+  auto idsItr = concurrentIndices_->portStatsSaiIds.find(portId);
   auto portStatItr = portStats_.find(portId);
-  if (portStatItr == portStats_.end()) {
+  if (idsItr == concurrentIndices_->portStatsSaiIds.cend() ||
+      portStatItr == portStats_.end()) {
     // We don't maintain port stats for disabled ports.
     return;
   }
+  const auto& statsSaiIds = idsItr->second;
+  auto now = duration_cast<seconds>(system_clock::now().time_since_epoch());
   const auto& prevPortStats = portStatItr->second->portStats();
   HwPortStats curPortStats{prevPortStats};
   // All stats start with a unitialized (-1) value. If there are no in
@@ -565,8 +602,13 @@ void SaiPortManager::updateStats(PortID portId) {
       ? 0
       : *curPortStats.inDiscards__ref();
   curPortStats.timestamp__ref() = now.count();
-  handle->port->updateStats(supportedStats(), SAI_STATS_MODE_READ);
-  const auto& counters = handle->port->getStats();
+  const auto& counterIds = supportedStats();
+  auto values = SaiApiTable::getInstance()->portApi().getStats<SaiPortTraits>(
+      statsSaiIds.portSaiId, counterIds, SAI_STATS_MODE_READ);
+  folly::F14FastMap<sai_stat_id_t, uint64_t> counters;
+  for (auto i = 0; i < values.size(); ++i) {
+    counters.emplace(counterIds[i], values[i]);
+  }
   fillHwPortStats(counters, managerTable_->debugCounterManager(), curPortStats);
   std::vector<utility::CounterPrevAndCur> toSubtractFromInDiscardsRaw = {
       {*prevPortStats.inDstNullDiscards__ref(),
@@ -576,24 +618,25 @@ void SaiPortManager::updateStats(PortID portId) {
       {*prevPortStats.inDiscardsRaw__ref(), *curPortStats.inDiscardsRaw__ref()},
       toSubtractFromInDiscardsRaw);
   managerTable_->queueManager().updateStats(
-      handle->configuredQueues, curPortStats);
-  portStats_[portId]->updateStats(curPortStats, now);
+      statsSaiIds.queueSaiIds, curPortStats);
+  portStatItr->second->updateStats(curPortStats, now);
 }
 
 std::map<PortID, HwPortStats> SaiPortManager::getPortStats() const {
+  std::lock_guard<std::mutex> lock(portStatsMutex_);
   std::map<PortID, HwPortStats> portStats;
-  for (const auto& [portId, handle] : handles_) {
-    if (portStats_.find(portId) == portStats_.end()) {
-      // We don't maintain port stats for disabled ports.
-      continue;
-    }
-    const auto& counters = handle->port->getStats();
-    std::ignore = platform_->getAsic()->isSupported(HwAsic::Feature::ECN);
-    HwPortStats hwPortStats{};
-    fillHwPortStats(
-        counters, managerTable_->debugCounterManager(), hwPortStats);
-    managerTable_->queueManager().getStats(handle->queues, hwPortStats);
-    portStats.emplace(portId, hwPortStats);
+  for (const auto& [portId, portStat] : portStats_) {
+    portStats.emplace(portId, portStat->portStats());
+  }
+  return portStats;
+}
+
+folly::F14FastMap<std::string, HwPortStats> SaiPortManager::getLastPortStats()
+    const {
+  std::lock_guard<std::mutex> lock(portStatsMutex_);
+  folly::F14FastMap<std::string, HwPortStats> portStats;
+  for (const auto& [portId, portStat] : portStats_) {
+    portStats.emplace(portStat->portName(), portStat->portStats());
   }
   return portStats;
 }
@@ -603,6 +646,8 @@ void SaiPortManager::clearStats(PortID port) {
   if (!portHandle) {
     return;
   }
+  // Don't race with a collection of this port's stats
+  std::lock_guard<std::mutex> lock(portStatsMutex_);
   auto statsToClear = supportedStats();
   if (platform_->getAsic()->isSupported(HwAsic::Feature::DEBUG_COUNTER)) {
     // Debug counters are implemented differently than regular port counters
@@ -627,6 +672,7 @@ void SaiPortManager::clearStats(PortID port) {
 }
 
 const HwPortFb303Stats* SaiPortManager::getLastPortStat(PortID port) const {
+  std::lock_guard<std::mutex> lock(portStatsMutex_);
   auto pitr = portStats_.find(port);
   return pitr != portStats_.end() ? pitr->second.get() : nullptr;
 }
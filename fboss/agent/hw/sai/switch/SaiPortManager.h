@@ -24,6 +24,8 @@
 #include "folly/container/F14Map.h"
 #include "folly/container/F14Set.h"
 
+#include <mutex>
+
 namespace facebook::fboss {
 
 class ConcurrentIndices;
@@ -82,9 +84,8 @@ class SaiPortManager {
 
   const HwPortFb303Stats* getLastPortStat(PortID port) const;
 
-  const Stats& getLastPortStats() const {
-    return portStats_;
-  }
+  // Last collected stats, keyed by port name
+  folly::F14FastMap<std::string, HwPortStats> getLastPortStats() const;
 
   cfg::PortSpeed getMaxSpeed(PortID port) const;
   Handles::const_iterator begin() const {
@@ -101,6 +102,11 @@ class SaiPortManager {
   std::shared_ptr<Port> swPortFromAttributes(
       SaiPortTraits::CreateAttributes attributees) const;
 
+  /*
+   * Collect stats of an enabled port, using the sai ids published in
+   * ConcurrentIndices. Only serializes with changes to this manager's port
+   * stats, so callers need not hold the switch lock.
+   */
   void updateStats(PortID portID);
 
   void clearStats(PortID portID);
@@ -121,6 +127,7 @@ class SaiPortManager {
 
   void setQosMapsOnAllPorts(QosMapSaiId dscpToTc, QosMapSaiId tcToQueue);
   const std::vector<sai_stat_id_t>& supportedStats() const;
+  void updateStatsSaiIdsLocked(PortID portID, const SaiPortHandle* handle);
   SaiPortHandle* getPortHandleImpl(PortID swId) const;
   SaiQueueHandle* getQueueHandleImpl(
       PortID swId,
@@ -136,6 +143,8 @@ class SaiPortManager {
   // on some platforms port can not be removed freely. on such platforms retain
   // removed port handle so it does not invoke remove port api.
   Handles removedHandles_;
+  // Protects portStats_ and the port stats sai ids in concurrentIndices_
+  mutable std::mutex portStatsMutex_;
   Stats portStats_;
   std::shared_ptr<SaiQosMap> globalDscpToTcQosMap_;
   std::shared_ptr<SaiQosMap> globalTcToQueueQosMap_;
@@ -217,6 +217,31 @@ void SaiQueueManager::updateStats(
   }
 }
 
+void SaiQueueManager::updateStats(
+    const std::vector<std::pair<uint8_t, QueueSaiId>>& queueSaiIds,
+    HwPortStats& hwPortStats) const {
+  auto& queueApi = SaiApiTable::getInstance()->queueApi();
+  folly::F14FastMap<sai_stat_id_t, uint64_t> counters;
+  auto fillCounters = [&counters](
+                          const auto& counterIds,
+                          const std::vector<uint64_t>& values) {
+    for (auto i = 0; i < values.size(); ++i) {
+      counters[counterIds[i]] = values[i];
+    }
+  };
+  for (const auto& [queueId, queueSaiId] : queueSaiIds) {
+    counters.clear();
+    fillCounters(
+        SaiQueueTraits::CounterIdsToRead,
+        queueApi.getStats<SaiQueueTraits>(queueSaiId, SAI_STATS_MODE_READ));
+    fillCounters(
+        SaiQueueTraits::CounterIdsToReadAndClear,
+        queueApi.getStats<SaiQueueTraits>(
+            queueSaiId, SAI_STATS_MODE_READ_AND_CLEAR));
+    fillHwQueueStats(queueId, counters, hwPortStats);
+  }
+}
+
 void SaiQueueManager::getStats(
     SaiQueueHandles& queueHandles,
     HwPortStats& hwPortStats) {
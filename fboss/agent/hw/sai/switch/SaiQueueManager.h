@@ -61,6 +61,13 @@ class SaiQueueManager {
   void updateStats(
       const std::vector<SaiQueueHandle*>& queues,
       HwPortStats& stats);
+  /*
+   * Collect stats by queue sai id, without going through queue handles.
+   * Safe to call without holding the switch lock.
+   */
+  void updateStats(
+      const std::vector<std::pair<uint8_t, QueueSaiId>>& queueSaiIds,
+      HwPortStats& stats) const;
   void getStats(SaiQueueHandles& queueHandles, HwPortStats& hwPortStats);
   QueueConfig getQueueSettings(const SaiQueueHandles& queueHandles) const;
 
@@ -246,6 +246,15 @@ void SaiRouteManager::addOrUpdateRoute(
     attributes = SaiRouteTraits::CreateAttributes{
         packetAction, SAI_NULL_OBJECT_ID, metadata};
   }
+  if (batching_) {
+    pendingRoutes_.push_back(PendingRoute{
+        entry,
+        attributes.value(),
+        routeHandle,
+        std::move(routeHandle->nexthopHandle_)});
+    routeHandle->nexthopHandle_ = nextHopHandle;
+    return;
+  }
   auto& store = SaiStore::getInstance()->get<SaiRouteTraits>();
   auto route = store.setObject(entry, attributes.value());
   routeHandle->route = route;
@@ -296,11 +305,15 @@ void SaiRouteManager::removeRoute(
     const std::shared_ptr<Route<AddrT>>& swRoute,
     RouterID routerId) {
   SaiRouteTraits::RouteEntry entry = routeEntryFromSwRoute(routerId, swRoute);
-  size_t count = handles_.erase(entry);
-  if (!count) {
+  auto itr = handles_.find(entry);
+  if (itr == handles_.end()) {
     throw FbossError(
         "Failed to remove non-existent route to ", swRoute->prefix().str());
   }
+  if (batching_) {
+    pendingRemovals_.push_back(std::move(itr->second));
+  }
+  handles_.erase(itr);
 }
 
 SaiRouteHandle* SaiRouteManager::getRouteHandle(
@@ -326,9 +339,71 @@ SaiRouteHandle* SaiRouteManager::getRouteHandleImpl(
 }
 
 void SaiRouteManager::clear() {
+  batching_ = false;
+  pendingRoutes_.clear();
+  pendingRemovals_.clear();
   handles_.clear();
 }
 
+void SaiRouteManager::beginRouteBatch() {
+  CHECK(!batching_);
+  batching_ = true;
+}
+
+void SaiRouteManager::endRouteBatch() {
+  CHECK(batching_);
+  batching_ = false;
+  auto pendingRoutes = std::move(pendingRoutes_);
+  auto pendingRemovals = std::move(pendingRemovals_);
+  pendingRoutes_.clear();
+  pendingRemovals_.clear();
+
+  auto& store = SaiStore::getInstance()->get<SaiRouteTraits>();
+  // Remove routes before releasing the next hops they point to
+  std::vector<std::shared_ptr<SaiRoute>> removedRoutes;
+  removedRoutes.reserve(pendingRemovals.size());
+  for (auto& routeHandle : pendingRemovals) {
+    removedRoutes.push_back(std::move(routeHandle->route));
+  }
+  store.removeObjects(std::move(removedRoutes));
+  auto numRemoved = pendingRemovals.size();
+  pendingRemovals.clear();
+
+  std::vector<SaiRouteTraits::RouteEntry> entries;
+  std::vector<SaiRouteTraits::CreateAttributes> attributes;
+  entries.reserve(pendingRoutes.size());
+  attributes.reserve(pendingRoutes.size());
+  for (const auto& pendingRoute : pendingRoutes) {
+    entries.push_back(pendingRoute.entry);
+    attributes.push_back(pendingRoute.attributes);
+  }
+  auto routes = store.setObjects(entries, attributes);
+  for (size_t i = 0; i < routes.size(); ++i) {
+    pendingRoutes[i].routeHandle->route = std::move(routes[i]);
+  }
+  XLOG(DBG2) << "Route batch: programmed " << pendingRoutes.size()
+             << " routes, removed " << numRemoved << " routes";
+}
+
+void SaiRouteManager::discardRouteBatch() noexcept {
+  if (!batching_) {
+    return;
+  }
+  batching_ = false;
+  for (auto& pendingRoute : pendingRoutes_) {
+    if (pendingRoute.routeHandle->route) {
+      pendingRoute.routeHandle->nexthopHandle_ =
+          std::move(pendingRoute.oldNextHopHandle);
+    } else {
+      handles_.erase(pendingRoute.entry);
+    }
+  }
+  XLOG(WARN) << "Route batch: discarded " << pendingRoutes_.size()
+             << " routes to program";
+  pendingRoutes_.clear();
+  pendingRemovals_.clear();
+}
+
 template <typename NextHopTraitsT>
 ManagedRouteNextHop<NextHopTraitsT>::ManagedRouteNextHop(
     SaiManagerTable* managerTable,
@@ -22,6 +22,7 @@
 
 #include <memory>
 #include <mutex>
+#include <vector>
 
 namespace facebook::fboss {
 
@@ -106,7 +107,31 @@ class SaiRouteManager {
 
   void clear();
 
+  /*
+   * Between beginRouteBatch and endRouteBatch, addRoute, changeRoute and
+   * removeRoute only work out what each route should look like in SAI.
+   * endRouteBatch then programs all of them with the SAI bulk route APIs,
+   * removals first. Each route is expected to be touched at most once per
+   * batch, as is the case when processing a state delta.
+   *
+   * discardRouteBatch ends a batch without programming it, when processing
+   * the delta failed: routes changed by the batch keep what is programmed,
+   * routes added by it are forgotten and routes removed by it are removed.
+   */
+  void beginRouteBatch();
+  void endRouteBatch();
+  void discardRouteBatch() noexcept;
+
  private:
+  struct PendingRoute {
+    SaiRouteTraits::RouteEntry entry;
+    SaiRouteTraits::CreateAttributes attributes;
+    SaiRouteHandle* routeHandle;
+    // next hops the route used before the batch, kept alive until the route
+    // is reprogrammed to no longer point to them
+    SaiRouteHandle::NextHopHandle oldNextHopHandle;
+  };
+
   SaiRouteHandle* getRouteHandleImpl(
       const SaiRouteTraits::RouteEntry& entry) const;
   template <typename AddrT>
@@ -123,6 +148,11 @@ class SaiRouteManager {
   const SaiPlatform* platform_;
   folly::F14FastMap<SaiRouteTraits::RouteEntry, std::unique_ptr<SaiRouteHandle>>
       handles_;
+  bool batching_{false};
+  std::vector<PendingRoute> pendingRoutes_;
+  // handles of removed routes, which hold on to the route's next hops until
+  // the route itself is removed
+  std::vector<std::unique_ptr<SaiRouteHandle>> pendingRemovals_;
 };
 
 } // namespace facebook::fboss
@@ -52,6 +52,7 @@
 #include "fboss/agent/hw/HwSwitchWarmBootHelper.h"
 #include "fboss/agent/hw/switch_asics/HwAsic.h"
 
+#include <folly/ScopeGuard.h>
 #include <folly/logging/xlog.h>
 
 #include <chrono>
@@ -62,6 +63,19 @@ extern "C" {
 }
 
 DEFINE_bool(flexports, true, "Load the agent with flexport support enabled");
+DEFINE_bool(
+    sai_async_tx,
+    true,
+    "Send packets handed to the async TX APIs from a dedicated TX thread "
+    "instead of on the caller's thread");
+DEFINE_int32(
+    sai_tx_queue_size,
+    4096,
+    "Number of packets the async TX queue holds before dropping packets");
+DEFINE_int32(
+    sai_tx_batch_size,
+    64,
+    "Max number of packets the async TX thread sends per wakeup");
 /*
  * Setting the default sai sdk logging level to CRITICAL for several reasons:
  * 1) These are synchronous writes to the syslog so that agent
@@ -81,6 +95,11 @@ DEFINE_bool(
     false,
     "Fail if any warm boot handles are left unclaimed.");
 
+DEFINE_bool(
+    enable_bulk_route_programming,
+    false,
+    "Program the routes of each state delta with the SAI bulk route APIs");
+
 namespace {
 /*
  * For the devices/SDK we use, the only events we should get (and process)
@@ -155,9 +174,15 @@ SaiSwitch::SaiSwitch(SaiPlatform* platform, uint32_t featuresDesired)
     : HwSwitch(featuresDesired), platform_(platform) {
   utilCreateDir(platform_->getVolatileStateDir());
   utilCreateDir(platform_->getPersistentStateDir());
+  if (FLAGS_sai_async_tx) {
+    asyncTxQueue_ = std::make_unique<folly::MPMCQueue<AsyncTxPacket>>(
+        FLAGS_sai_tx_queue_size);
+  }
 }
 
-SaiSwitch::~SaiSwitch() {}
+SaiSwitch::~SaiSwitch() {
+  stopAsyncTxThread();
+}
 
 HwInitResult SaiSwitch::init(
     Callback* callback,
@@ -256,6 +281,8 @@ void SaiSwitch::unregisterCallbacks() noexcept {
 
   fdbEventBottomHalfEventBase_.terminateLoopSoon();
   fdbEventBottomHalfThread_->join();
+
+  stopAsyncTxThread();
 }
 
 template <typename ManagerT>
@@ -378,24 +405,43 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChanged(const StateDelta& delta) {
         &SaiFdbManager::removeMac);
   }
 
-  for (const auto& routeDelta : delta.getRouteTablesDelta()) {
-    auto routerID = routeDelta.getOld() ? routeDelta.getOld()->getID()
-                                        : routeDelta.getNew()->getID();
-    processDelta(
-        routeDelta.getRoutesV4Delta(),
-        managerTable_->routeManager(),
-        &SaiRouteManager::changeRoute<folly::IPAddressV4>,
-        &SaiRouteManager::addRoute<folly::IPAddressV4>,
-        &SaiRouteManager::removeRoute<folly::IPAddressV4>,
-        routerID);
-
-    processDelta(
-        routeDelta.getRoutesV6Delta(),
-        managerTable_->routeManager(),
-        &SaiRouteManager::changeRoute<folly::IPAddressV6>,
-        &SaiRouteManager::addRoute<folly::IPAddressV6>,
-        &SaiRouteManager::removeRoute<folly::IPAddressV6>,
-        routerID);
+  bool batchRoutes = FLAGS_enable_bulk_route_programming;
+  if (batchRoutes) {
+    auto lock = std::lock_guard<std::mutex>(saiSwitchMutex_);
+    managerTable_->routeManager().beginRouteBatch();
+  }
+  {
+    // A failed route update must not leave the batch open, or the next
+    // delta would find one already begun
+    SCOPE_FAIL {
+      if (batchRoutes) {
+        auto lock = std::lock_guard<std::mutex>(saiSwitchMutex_);
+        managerTable_->routeManager().discardRouteBatch();
+      }
+    };
+    for (const auto& routeDelta : delta.getRouteTablesDelta()) {
+      auto routerID = routeDelta.getOld() ? routeDelta.getOld()->getID()
+                                          : routeDelta.getNew()->getID();
+      processDelta(
+          routeDelta.getRoutesV4Delta(),
+          managerTable_->routeManager(),
+          &SaiRouteManager::changeRoute<folly::IPAddressV4>,
+          &SaiRouteManager::addRoute<folly::IPAddressV4>,
+          &SaiRouteManager::removeRoute<folly::IPAddressV4>,
+          routerID);
+
+      processDelta(
+          routeDelta.getRoutesV6Delta(),
+          managerTable_->routeManager(),
+          &SaiRouteManager::changeRoute<folly::IPAddressV6>,
+          &SaiRouteManager::addRoute<folly::IPAddressV6>,
+          &SaiRouteManager::removeRoute<folly::IPAddressV6>,
+          routerID);
+    }
+    if (batchRoutes) {
+      auto lock = std::lock_guard<std::mutex>(saiSwitchMutex_);
+      managerTable_->routeManager().endRouteBatch();
+    }
   }
 
   {
@@ -570,38 +616,129 @@ std::unique_ptr<TxPacket> SaiSwitch::allocatePacket(uint32_t size) const {
 
 bool SaiSwitch::sendPacketSwitchedAsync(
     std::unique_ptr<TxPacket> pkt) noexcept {
-  return sendPacketSwitchedSync(std::move(pkt));
+  if (!asyncTxQueue_) {
+    return sendPacketSwitchedSync(std::move(pkt));
+  }
+  return queueAsyncTxPacket(AsyncTxPacket{
+      std::move(pkt),
+      std::nullopt,
+      std::nullopt,
+      std::chrono::steady_clock::now()});
 }
 
 bool SaiSwitch::sendPacketOutOfPortAsync(
     std::unique_ptr<TxPacket> pkt,
     PortID portID,
     std::optional<uint8_t> queueId) noexcept {
-  return sendPacketOutOfPortSync(std::move(pkt), portID, queueId);
+  if (!asyncTxQueue_) {
+    return sendPacketOutOfPortSync(std::move(pkt), portID, queueId);
+  }
+  return queueAsyncTxPacket(AsyncTxPacket{
+      std::move(pkt), portID, queueId, std::chrono::steady_clock::now()});
 }
 
-void SaiSwitch::updateStatsImpl(SwitchStats* /* switchStats */) {
-  auto& portManager = managerTable_->portManager();
-  auto iter = concurrentIndices_->portIds.begin();
-  while (iter != concurrentIndices_->portIds.end()) {
-    {
-      std::lock_guard<std::mutex> locked(saiSwitchMutex_);
-      portManager.updateStats(iter->second);
+bool SaiSwitch::queueAsyncTxPacket(AsyncTxPacket txPacket) noexcept {
+  if (asyncTxStopped_) {
+    XLOG_EVERY_MS(ERR, 1000) << "async TX stopped, dropping packet";
+    getSwitchStats()->txQueueDrops();
+    return false;
+  }
+  if (!asyncTxQueue_->write(std::move(txPacket))) {
+    XLOG_EVERY_MS(ERR, 1000) << "async TX queue full, dropping packet";
+    getSwitchStats()->txQueueDrops();
+    return false;
+  }
+  return true;
+}
+
+void SaiSwitch::asyncTxThreadLoop() {
+  std::vector<AsyncTxPacket> batch;
+  batch.reserve(FLAGS_sai_tx_batch_size);
+  while (true) {
+    // Block for the first packet, then take whatever else is already
+    // queued, so that a burst is sent with a single wakeup.
+    AsyncTxPacket txPacket;
+    asyncTxQueue_->blockingRead(txPacket);
+    bool stop{false};
+    do {
+      if (!txPacket.pkt) {
+        // Queued by stopAsyncTxThread(), after every packet to send
+        stop = true;
+        break;
+      }
+      batch.push_back(std::move(txPacket));
+    } while (batch.size() < static_cast<size_t>(FLAGS_sai_tx_batch_size) &&
+             asyncTxQueue_->read(txPacket));
+
+    for (auto& queuedPacket : batch) {
+      auto queuedUs = std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - queuedPacket.queued);
+      auto sent = queuedPacket.portID
+          ? sendPacketOutOfPortSync(
+                std::move(queuedPacket.pkt),
+                *queuedPacket.portID,
+                queuedPacket.queueId)
+          : sendPacketSwitchedSync(std::move(queuedPacket.pkt));
+      if (sent) {
+        getSwitchStats()->txSentDone(queuedUs.count());
+      } else {
+        getSwitchStats()->txError();
+      }
+    }
+    batch.clear();
+    if (stop) {
+      return;
     }
-    ++iter;
   }
-  {
-    std::lock_guard<std::mutex> locked(saiSwitchMutex_);
-    managerTable_->hostifManager().updateStats();
+}
+
+void SaiSwitch::startAsyncTxThread() {
+  if (!asyncTxQueue_ || asyncTxThread_) {
+    return;
   }
-  {
-    std::lock_guard<std::mutex> locked(saiSwitchMutex_);
-    managerTable_->bufferManager().updateStats();
+  asyncTxThread_ = std::make_unique<std::thread>([this]() {
+    initThread("fbossSaiAsyncTx");
+    asyncTxThreadLoop();
+  });
+}
+
+void SaiSwitch::stopAsyncTxThread() {
+  if (!asyncTxQueue_) {
+    return;
   }
-  {
-    std::lock_guard<std::mutex> locked(saiSwitchMutex_);
-    HwResourceStatsPublisher().publish(hwResourceStats_);
+  // Nothing sends packets queued from here on, so they are rejected.
+  asyncTxStopped_ = true;
+  if (asyncTxThread_) {
+    // An empty packet tells the TX thread to stop once it has sent
+    // everything queued ahead of it.
+    asyncTxQueue_->blockingWrite();
+    asyncTxThread_->join();
+    asyncTxThread_.reset();
+  }
+  // Free packets which were queued while the thread was stopping
+  AsyncTxPacket txPacket;
+  while (asyncTxQueue_->read(txPacket)) {
+    if (txPacket.pkt) {
+      getSwitchStats()->txQueueDrops();
+    }
+  }
+}
+
+void SaiSwitch::updateStatsImpl(SwitchStats* /* switchStats */) {
+  /*
+   * Port stats are collected against the port/queue sai ids published in
+   * concurrentIndices_, and port manager serializes collection with port
+   * changes itself. So we don't contend with state updates and rx for
+   * the switch lock once per port, every stats interval.
+   */
+  auto& portManager = managerTable_->portManager();
+  for (const auto& portAndSaiIds : concurrentIndices_->portStatsSaiIds) {
+    portManager.updateStats(portAndSaiIds.first);
   }
+  std::lock_guard<std::mutex> locked(saiSwitchMutex_);
+  managerTable_->hostifManager().updateStats();
+  managerTable_->bufferManager().updateStats();
+  HwResourceStatsPublisher().publish(hwResourceStats_);
 }
 
 uint64_t SaiSwitch::getDeviceWatermarkBytes() const {
@@ -621,12 +758,7 @@ folly::F14FastMap<std::string, HwPortStats> SaiSwitch::getPortStats() const {
 
 folly::F14FastMap<std::string, HwPortStats> SaiSwitch::getPortStatsLocked(
     const std::lock_guard<std::mutex>& /* lock */) const {
-  folly::F14FastMap<std::string, HwPortStats> portStatsMap;
-  auto& portIdStatsMap = managerTable_->portManager().getLastPortStats();
-  for (auto& entry : portIdStatsMap) {
-    portStatsMap.emplace(entry.second->portName(), entry.second->portStats());
-  }
-  return portStatsMap;
+  return managerTable_->portManager().getLastPortStats();
 }
 
 void SaiSwitch::fetchL2Table(std::vector<L2EntryThrift>* l2Table) const {
@@ -1155,6 +1287,7 @@ void SaiSwitch::switchRunStateChangedImplLocked(
         initThread("fbossSaiFdbBH");
         fdbEventBottomHalfEventBase_.loopForever();
       });
+      startAsyncTxThread();
       auto& switchApi = SaiApiTable::getInstance()->switchApi();
       switchApi.registerFdbEventCallback(switchId_, __gFdbEventCallback);
     } break;
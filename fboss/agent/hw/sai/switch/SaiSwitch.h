@@ -18,6 +18,7 @@
 #include "fboss/agent/hw/sai/switch/SaiRxPacket.h"
 #include "fboss/agent/platforms/sai/SaiPlatform.h"
 
+#include <folly/MPMCQueue.h>
 #include <folly/io/async/EventBase.h>
 
 #include <memory>
@@ -242,6 +243,27 @@ class SaiSwitch : public HwSwitch {
   folly::F14FastMap<std::string, HwPortStats> getPortStatsLocked(
       const std::lock_guard<std::mutex>& lock) const;
 
+  /*
+   * Packets handed to the async TX APIs are queued on asyncTxQueue_ and
+   * sent from a dedicated thread, so callers never block on
+   * send_hostif_packet. The TX thread drains the queue in batches of up to
+   * --sai_tx_batch_size packets per wakeup, and sends packets in the order
+   * they were queued, which keeps per port ordering. When the queue is full
+   * packets are dropped rather than blocking the caller, as are packets
+   * handed over once the TX thread was stopped.
+   */
+  struct AsyncTxPacket {
+    std::unique_ptr<TxPacket> pkt;
+    // Set for packets sent out of a port, unset for switched packets
+    std::optional<PortID> portID;
+    std::optional<uint8_t> queueId;
+    std::chrono::steady_clock::time_point queued;
+  };
+  bool queueAsyncTxPacket(AsyncTxPacket txPacket) noexcept;
+  void asyncTxThreadLoop();
+  void startAsyncTxThread();
+  void stopAsyncTxThread();
+
   void linkStateChangedCallbackBottomHalf(
       std::vector<sai_port_oper_status_notification_t> data);
 
@@ -359,6 +381,9 @@ class SaiSwitch : public HwSwitch {
   folly::EventBase linkStateBottomHalfEventBase_;
   std::unique_ptr<std::thread> fdbEventBottomHalfThread_;
   folly::EventBase fdbEventBottomHalfEventBase_;
+  std::unique_ptr<folly::MPMCQueue<AsyncTxPacket>> asyncTxQueue_;
+  std::unique_ptr<std::thread> asyncTxThread_;
+  std::atomic<bool> asyncTxStopped_{false};
 
   HwResourceStats hwResourceStats_;
   std::atomic<SwitchRunState> runState_{SwitchRunState::UNINITIALIZED};
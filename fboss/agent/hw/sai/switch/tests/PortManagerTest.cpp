@@ -359,6 +359,25 @@ TEST_F(PortManagerTest, collectStatsAfterPortDisable) {
   checkCounterExport(swPort->getName(), ExpectExport::NO_EXPORT);
 }
 
+TEST_F(PortManagerTest, statsSaiIdsFollowPortState) {
+  std::shared_ptr<Port> swPort = makePort(p0);
+  auto saiId = saiManagerTable->portManager().addPort(swPort);
+  auto itr = concurrentIndices->portStatsSaiIds.find(swPort->getID());
+  ASSERT_NE(itr, concurrentIndices->portStatsSaiIds.cend());
+  EXPECT_EQ(itr->second.portSaiId, saiId);
+  EXPECT_EQ(itr->second.queueSaiIds.size(), swPort->getPortQueues().size());
+  auto newPort = swPort->clone();
+  newPort->setAdminState(cfg::PortState::DISABLED);
+  saiManagerTable->portManager().changePort(swPort, newPort);
+  EXPECT_EQ(concurrentIndices->portStatsSaiIds.count(swPort->getID()), 0);
+  auto newNewPort = newPort->clone();
+  newNewPort->setAdminState(cfg::PortState::ENABLED);
+  saiManagerTable->portManager().changePort(newPort, newNewPort);
+  EXPECT_EQ(concurrentIndices->portStatsSaiIds.count(swPort->getID()), 1);
+  saiManagerTable->portManager().removePort(newNewPort);
+  EXPECT_EQ(concurrentIndices->portStatsSaiIds.count(swPort->getID()), 0);
+}
+
 TEST_F(PortManagerTest, subsumedPorts) {
   // Port P0 has a port ID 0 and only be configured with all speeds.
   checkSubsumedPorts(p0, cfg::PortSpeed::XG, {});
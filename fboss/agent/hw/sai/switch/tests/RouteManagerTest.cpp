@@ -10,6 +10,7 @@
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/hw/sai/api/SaiApiTable.h"
 #include "fboss/agent/hw/sai/fake/FakeSai.h"
+#include "fboss/agent/hw/sai/store/SaiStore.h"
 #include "fboss/agent/hw/sai/switch/SaiManagerTable.h"
 #include "fboss/agent/hw/sai/switch/SaiNextHopGroupManager.h"
 #include "fboss/agent/hw/sai/switch/SaiRouteManager.h"
@@ -301,6 +302,100 @@ TEST_F(RouteManagerTest, updateCpuRoutetoNextHopRoute) {
   EXPECT_FALSE(saiRouteHandle->nextHopGroupHandle());
 }
 
+TEST_F(RouteManagerTest, batchAddChangeRemoveRoutes) {
+  auto& routeManager = saiManagerTable->routeManager();
+  auto r1 = makeRoute(tr1);
+  tr2.nextHopInterfaces = {testInterfaces.at(1)};
+  auto r2 = makeRoute(tr2);
+  auto routeEntry1 = routeManager.routeEntryFromSwRoute(RouterID(0), r1);
+  auto routeEntry2 = routeManager.routeEntryFromSwRoute(RouterID(0), r2);
+  auto& store = SaiStore::getInstance()->get<SaiRouteTraits>();
+
+  routeManager.beginRouteBatch();
+  routeManager.addRoute<folly::IPAddressV4>(r1, RouterID(0));
+  routeManager.addRoute<folly::IPAddressV4>(r2, RouterID(0));
+  // Nothing is programmed until the batch ends
+  EXPECT_FALSE(store.get(routeEntry1));
+  EXPECT_FALSE(store.get(routeEntry2));
+  routeManager.endRouteBatch();
+  auto saiRouteHandle1 = routeManager.getRouteHandle(routeEntry1);
+  ASSERT_TRUE(saiRouteHandle1);
+  EXPECT_EQ(saiRouteHandle1->route, store.get(routeEntry1));
+  auto oldGroupId = saiRouteHandle1->nextHopGroupHandle()->adapterKey();
+  EXPECT_EQ(
+      GET_OPT_ATTR(Route, NextHopId, saiRouteHandle1->route->attributes()),
+      oldGroupId);
+  ASSERT_TRUE(routeManager.getRouteHandle(routeEntry2));
+
+  tr1.nextHopInterfaces.clear();
+  tr1.nextHopInterfaces.push_back(testInterfaces.at(4));
+  tr1.nextHopInterfaces.push_back(testInterfaces.at(5));
+  auto r3 = makeRoute(tr1);
+  routeManager.beginRouteBatch();
+  routeManager.changeRoute<folly::IPAddressV4>(r1, r3, RouterID(0));
+  routeManager.removeRoute<folly::IPAddressV4>(r2, RouterID(0));
+  // The route still points to the old group until the batch ends, so the
+  // group must not be removed yet
+  EXPECT_EQ(
+      saiApiTable->routeApi().getAttribute(
+          routeEntry1, SaiRouteTraits::Attributes::NextHopId{}),
+      oldGroupId);
+  EXPECT_EQ(fs->nextHopGroupManager.map().count(oldGroupId), 1);
+  EXPECT_TRUE(store.get(routeEntry2));
+  routeManager.endRouteBatch();
+  auto newGroupId = saiRouteHandle1->nextHopGroupHandle()->adapterKey();
+  EXPECT_NE(oldGroupId, newGroupId);
+  EXPECT_EQ(
+      GET_OPT_ATTR(Route, NextHopId, saiRouteHandle1->route->attributes()),
+      newGroupId);
+  EXPECT_EQ(
+      saiApiTable->routeApi().getAttribute(
+          routeEntry1, SaiRouteTraits::Attributes::NextHopId{}),
+      newGroupId);
+  EXPECT_EQ(fs->nextHopGroupManager.map().count(oldGroupId), 0);
+  EXPECT_FALSE(routeManager.getRouteHandle(routeEntry2));
+  EXPECT_FALSE(store.get(routeEntry2));
+}
+
+TEST_F(RouteManagerTest, discardRouteBatch) {
+  auto& routeManager = saiManagerTable->routeManager();
+  auto r1 = makeRoute(tr1);
+  tr2.nextHopInterfaces = {testInterfaces.at(1)};
+  auto r2 = makeRoute(tr2);
+  auto routeEntry1 = routeManager.routeEntryFromSwRoute(RouterID(0), r1);
+  auto routeEntry2 = routeManager.routeEntryFromSwRoute(RouterID(0), r2);
+  auto& store = SaiStore::getInstance()->get<SaiRouteTraits>();
+
+  routeManager.addRoute<folly::IPAddressV4>(r1, RouterID(0));
+  auto saiRouteHandle1 = routeManager.getRouteHandle(routeEntry1);
+  ASSERT_TRUE(saiRouteHandle1);
+  auto oldGroupId = saiRouteHandle1->nextHopGroupHandle()->adapterKey();
+
+  tr1.nextHopInterfaces.clear();
+  tr1.nextHopInterfaces.push_back(testInterfaces.at(4));
+  tr1.nextHopInterfaces.push_back(testInterfaces.at(5));
+  auto r3 = makeRoute(tr1);
+  routeManager.beginRouteBatch();
+  routeManager.changeRoute<folly::IPAddressV4>(r1, r3, RouterID(0));
+  routeManager.addRoute<folly::IPAddressV4>(r2, RouterID(0));
+  routeManager.discardRouteBatch();
+
+  // The changed route keeps what is programmed, the added one is forgotten
+  EXPECT_EQ(saiRouteHandle1->nextHopGroupHandle()->adapterKey(), oldGroupId);
+  EXPECT_EQ(
+      saiApiTable->routeApi().getAttribute(
+          routeEntry1, SaiRouteTraits::Attributes::NextHopId{}),
+      oldGroupId);
+  EXPECT_FALSE(routeManager.getRouteHandle(routeEntry2));
+  EXPECT_FALSE(store.get(routeEntry2));
+
+  // and the next batch starts afresh
+  routeManager.beginRouteBatch();
+  routeManager.addRoute<folly::IPAddressV4>(r2, RouterID(0));
+  routeManager.endRouteBatch();
+  EXPECT_TRUE(store.get(routeEntry2));
+}
+
 /*
  * Test for ToMe routes doesn't want to do all the setup, because
  * setting up the router interfaces will result in creating ToMeRoutes
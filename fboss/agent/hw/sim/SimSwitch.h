@@ -12,6 +12,7 @@
 #include "fboss/agent/HwSwitch.h"
 #include "fboss/agent/hw/sim/SimPlatform.h"
 
+#include <atomic>
 #include <optional>
 
 namespace facebook::fboss {
@@ -117,7 +118,7 @@ class SimSwitch : public HwSwitch {
   SimPlatform* platform_;
   HwSwitch::Callback* callback_{nullptr};
   uint32_t numPorts_{0};
-  uint64_t txCount_{0};
+  std::atomic<uint64_t> txCount_{0};
   BootType bootType_{BootType::UNINITIALIZED};
 };
 
@@ -0,0 +1,130 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "common/init/Init.h"
+#include "fboss/agent/hw/HwFb303Stats.h"
+#include "fboss/agent/hw/HwPortFb303Stats.h"
+
+#include <folly/Benchmark.h>
+#include <folly/Conv.h>
+
+#include <string>
+#include <vector>
+
+/*
+ * Cost of updating the counters of 128 ports with 8 queues each, building
+ * and looking up their names on every update (as HwPortFb303Stats used to)
+ * and through the handles HwPortFb303Stats now resolves at (re)configuration
+ * time.
+ */
+
+using namespace facebook::fboss;
+using namespace std::chrono;
+
+namespace {
+
+constexpr auto kNumPorts = 128;
+constexpr auto kNumQueues = 8;
+
+std::string portName(int port) {
+  return folly::to<std::string>("eth1/", port, "/1");
+}
+
+std::string queueName(int queueId) {
+  return folly::to<std::string>("queue", queueId);
+}
+
+/*
+ * Registers the port and queue counters of every port with stats, and
+ * returns their names.
+ */
+std::vector<std::string> initStats(HwFb303Stats* stats) {
+  std::vector<std::string> statNames;
+  for (auto port = 0; port < kNumPorts; ++port) {
+    for (auto statKey : HwPortFb303Stats::kPortStatKeys()) {
+      statNames.push_back(HwPortFb303Stats::statName(statKey, portName(port)));
+    }
+    for (auto queueId = 0; queueId < kNumQueues; ++queueId) {
+      for (auto statKey : HwPortFb303Stats::kQueueStatKeys()) {
+        statNames.push_back(HwPortFb303Stats::statName(
+            statKey, portName(port), queueId, queueName(queueId)));
+      }
+    }
+  }
+  for (const auto& statName : statNames) {
+    stats->reinitStat(statName, std::nullopt);
+  }
+  return statNames;
+}
+
+seconds now(size_t iter) {
+  return duration_cast<seconds>(system_clock::now().time_since_epoch()) +
+      seconds(iter);
+}
+
+} // namespace
+
+BENCHMARK(PortStatsUpdateByName, iters) {
+  folly::BenchmarkSuspender suspender;
+  HwFb303Stats stats;
+  initStats(&stats);
+  std::vector<std::string> portNames;
+  for (auto port = 0; port < kNumPorts; ++port) {
+    portNames.push_back(portName(port));
+  }
+  std::vector<std::string> queueNames;
+  for (auto queueId = 0; queueId < kNumQueues; ++queueId) {
+    queueNames.push_back(queueName(queueId));
+  }
+  suspender.dismiss();
+
+  // Counter names are built on every update, as HwPortFb303Stats used to
+  for (size_t i = 0; i < iters; ++i) {
+    auto retrievedAt = now(i);
+    for (const auto& portName : portNames) {
+      for (auto statKey : HwPortFb303Stats::kPortStatKeys()) {
+        stats.updateStat(
+            retrievedAt, HwPortFb303Stats::statName(statKey, portName), i);
+      }
+      for (auto queueId = 0; queueId < kNumQueues; ++queueId) {
+        for (auto statKey : HwPortFb303Stats::kQueueStatKeys()) {
+          stats.updateStat(
+              retrievedAt,
+              HwPortFb303Stats::statName(
+                  statKey, portName, queueId, queueNames[queueId]),
+              i);
+        }
+      }
+    }
+  }
+}
+
+BENCHMARK_RELATIVE(PortStatsUpdateByHandle, iters) {
+  folly::BenchmarkSuspender suspender;
+  HwFb303Stats stats;
+  std::vector<HwFb303Stats::StatHandle> statHandles;
+  for (const auto& statName : initStats(&stats)) {
+    statHandles.push_back(stats.getStatHandle(statName));
+  }
+  suspender.dismiss();
+
+  for (size_t i = 0; i < iters; ++i) {
+    auto retrievedAt = now(i);
+    for (auto statHandle : statHandles) {
+      stats.updateStat(retrievedAt, statHandle, i);
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return EXIT_SUCCESS;
+}
@@ -275,3 +275,34 @@ TEST(HwPortFb303Stats, queueNameChangeResetsValue) {
     }
   }
 }
+
+TEST(HwPortFb303Stats, UpdateStatsAfterRename) {
+  HwPortFb303Stats portStats(kPortName, kQueue2Name);
+  constexpr auto kNewPortName = "eth1/2/1";
+  portStats.portNameChanged(kNewPortName);
+  portStats.queueChanged(1, "platinum");
+  portStats.queueChanged(3, "bronze");
+  portStats.queueRemoved(3);
+  updateStats(portStats);
+  auto curValue{1};
+  for (auto counterName : HwPortFb303Stats::kPortStatKeys()) {
+    EXPECT_EQ(
+        portStats.getCounterLastIncrement(
+            HwPortFb303Stats::statName(counterName, kNewPortName)),
+        curValue++ + 1);
+  }
+  curValue = 1;
+  HwPortFb303Stats::QueueId2Name newQueues = {{1, "platinum"}, {2, "silver"}};
+  for (auto counterName : HwPortFb303Stats::kQueueStatKeys()) {
+    for (const auto& queueIdAndName : newQueues) {
+      EXPECT_EQ(
+          portStats.getCounterLastIncrement(HwPortFb303Stats::statName(
+              counterName,
+              kNewPortName,
+              queueIdAndName.first,
+              queueIdAndName.second)),
+          curValue);
+    }
+    ++curValue;
+  }
+}
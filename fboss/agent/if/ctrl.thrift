@@ -113,6 +113,25 @@ struct RouteDetails {
   7: list<NextHopThrift> nextHops,
 }
 
+struct RouteTableFilter {
+  // Only return routes with a next hop entry from this client
+  1: optional i16 clientId,
+  // Only return routes for prefixes within this prefix
+  2: optional IpPrefix prefix,
+}
+
+struct RouteTablePage {
+  1: list<UnicastRoute> routes,
+  // Cursor to fetch the next page with, 0 once all routes have been returned
+  2: i64 cursor,
+}
+
+struct RouteDetailsPage {
+  1: list<RouteDetails> routes,
+  // Cursor to fetch the next page with, 0 once all routes have been returned
+  2: i64 cursor,
+}
+
 struct MplsRouteDetails {
   1: mpls.MplsLabel topLabel
   2: string action
@@ -596,6 +615,29 @@ service FbossCtrl extends fb303.FacebookService {
   void syncFibInVrf(1: i16 clientId, 2: list<UnicastRoute> routes, 3: i32 vrf)
     throws (1: fboss.FbossBaseError error)
 
+  /*
+   * Add and delete routes of a client without waiting for them to be
+   * programmed, which requires the standalone RIB. If syncFib is set, all
+   * other routes of the client are removed, as with syncFibInVrf().
+   *
+   * Returns once the RIB is updated, with the generation of the update.
+   * Updates from all clients are then programmed together. Clients needing
+   * the routes to be in hardware call waitForRouteGeneration() with the
+   * returned generation, which returns false if that did not happen within
+   * timeoutMs.
+   */
+  i64 updateUnicastRoutesAsync(
+    1: i16 clientId,
+    2: list<UnicastRoute> toAdd,
+    3: list<IpPrefix> toDelete,
+    4: i32 vrf,
+    5: bool syncFib,
+  ) throws (1: fboss.FbossBaseError error)
+  bool waitForRouteGeneration(1: i64 generation, 2: i32 timeoutMs)
+    throws (1: fboss.FbossBaseError error)
+  i64 getProgrammedRouteGeneration()
+    throws (1: fboss.FbossBaseError error)
+
   /*
    * Send packets in binary or hex format to controller.
    *
@@ -690,6 +732,25 @@ service FbossCtrl extends fb303.FacebookService {
     throws (1: fboss.FbossBaseError error)
   list<RouteDetails> getRouteTableDetails()
     throws (1: fboss.FbossBaseError error)
+  /*
+   * Walk the route table a page of up to maxRoutes routes at a time.
+   *
+   * A cursor of 0 starts a new walk over a snapshot of the route table,
+   * returning the routes matching filter. Following pages are fetched by
+   * passing the cursor returned with the previous page, in which case
+   * filter is ignored. Cursors that are not used for
+   * --route_table_cursor_idle_s seconds expire.
+   */
+  RouteTablePage getRouteTablePage(
+    1: i64 cursor,
+    2: i32 maxRoutes,
+    3: RouteTableFilter filter,
+  ) throws (1: fboss.FbossBaseError error)
+  RouteDetailsPage getRouteTableDetailsPage(
+    1: i64 cursor,
+    2: i32 maxRoutes,
+    3: RouteTableFilter filter,
+  ) throws (1: fboss.FbossBaseError error)
   InterfaceDetail getInterfaceDetail(1: i32 interfaceId)
     throws (1: fboss.FbossBaseError error)
 
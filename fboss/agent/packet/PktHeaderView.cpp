@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/packet/PktHeaderView.h"
+
+#include "fboss/agent/packet/Ethertype.h"
+#include "fboss/agent/packet/IPProto.h"
+#include "fboss/agent/packet/IPv6Hdr.h"
+#include "fboss/agent/packet/PktUtil.h"
+
+#include <folly/io/IOBuf.h>
+
+namespace facebook::fboss {
+
+namespace {
+constexpr uint16_t kEthHdrSize = 2 * folly::MacAddress::SIZE + 2;
+constexpr uint16_t kVlanTagSize = 4;
+constexpr uint16_t kIPv4MinHdrSize = 20;
+} // namespace
+
+std::optional<PktHeaderView> PktHeaderView::parse(const folly::IOBuf* buf) {
+  folly::io::Cursor cursor(buf);
+  if (!cursor.canAdvance(kEthHdrSize)) {
+    return std::nullopt;
+  }
+  PktHeaderView view;
+  view.dstMac = PktUtil::readMac(&cursor);
+  view.srcMac = PktUtil::readMac(&cursor);
+  view.etherType = cursor.readBE<uint16_t>();
+  view.l3Offset = kEthHdrSize;
+  if (view.etherType == static_cast<uint16_t>(ETHERTYPE::ETHERTYPE_VLAN)) {
+    if (!cursor.canAdvance(kVlanTagSize)) {
+      return std::nullopt;
+    }
+    view.vlanTag = cursor.readBE<uint16_t>();
+    view.etherType = cursor.readBE<uint16_t>();
+    view.l3Offset += kVlanTagSize;
+  }
+
+  // cursor now points to the L3 header
+  switch (static_cast<ETHERTYPE>(view.etherType)) {
+    case ETHERTYPE::ETHERTYPE_IPV4: {
+      if (!cursor.canAdvance(kIPv4MinHdrSize)) {
+        return view;
+      }
+      uint16_t hdrSize = (cursor.read<uint8_t>() & 0x0f) * 4;
+      if (hdrSize < kIPv4MinHdrSize) {
+        return view;
+      }
+      cursor.skip(8);
+      view.ipProto = cursor.read<uint8_t>();
+      view.l4Offset = view.l3Offset + hdrSize;
+      // Skip the rest of the header, including any options
+      auto toL4 = hdrSize - 10;
+      if (view.ipProto == static_cast<uint8_t>(IP_PROTO::IP_PROTO_ICMP) &&
+          cursor.canAdvance(toL4 + 1)) {
+        cursor.skip(toL4);
+        view.icmpType = cursor.read<uint8_t>();
+      }
+      return view;
+    }
+    case ETHERTYPE::ETHERTYPE_IPV6: {
+      if (!cursor.canAdvance(IPv6Hdr::SIZE)) {
+        return view;
+      }
+      cursor.skip(6);
+      view.ipProto = cursor.read<uint8_t>();
+      view.l4Offset = view.l3Offset + IPv6Hdr::SIZE;
+      if (view.ipProto ==
+              static_cast<uint8_t>(IP_PROTO::IP_PROTO_IPV6_ICMP) &&
+          cursor.canAdvance(IPv6Hdr::SIZE - 7 + 1)) {
+        cursor.skip(IPv6Hdr::SIZE - 7);
+        view.icmpType = cursor.read<uint8_t>();
+      }
+      return view;
+    }
+    default:
+      return view;
+  }
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,67 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/MacAddress.h>
+#include <folly/io/Cursor.h>
+
+#include <optional>
+
+namespace folly {
+class IOBuf;
+}
+
+namespace facebook::fboss {
+
+/*
+ * PktHeaderView holds the decoded Ethernet, VLAN and IP protocol fields of a
+ * received packet, together with the offsets at which its L3 and L4 headers
+ * start.
+ *
+ * It is parsed in a single pass over the packet, without allocating, once
+ * per trapped packet. Classifying and dispatching the packet then only looks
+ * at the view, and the protocol handlers pick up parsing from l3Cursor().
+ */
+struct PktHeaderView {
+  /*
+   * Parse the headers of the packet in buf.
+   *
+   * Returns std::nullopt if buf is too short to hold an Ethernet header. The
+   * IP fields are only set if the packet holds a complete IPv4 or IPv6
+   * header. For a packet with IPv6 extension headers ipProto is the type of
+   * the first extension header, which l4Offset points to.
+   */
+  static std::optional<PktHeaderView> parse(const folly::IOBuf* buf);
+
+  /*
+   * A cursor pointing just past the ethertype, to the start of the L3
+   * header.
+   */
+  folly::io::Cursor l3Cursor(const folly::IOBuf* buf) const {
+    folly::io::Cursor cursor(buf);
+    cursor.skip(l3Offset);
+    return cursor;
+  }
+
+  folly::MacAddress dstMac;
+  folly::MacAddress srcMac;
+  // The VLAN TCI, for 802.1Q tagged packets
+  std::optional<uint16_t> vlanTag;
+  uint16_t etherType{0};
+  uint16_t l3Offset{0};
+
+  // IPv4 protocol, or IPv6 next header
+  std::optional<uint8_t> ipProto;
+  uint16_t l4Offset{0};
+  // ICMP or ICMPv6 message type
+  std::optional<uint8_t> icmpType;
+};
+
+} // namespace facebook::fboss
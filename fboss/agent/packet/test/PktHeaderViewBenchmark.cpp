@@ -0,0 +1,147 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <folly/Benchmark.h>
+#include <folly/Conv.h>
+#include <folly/init/Init.h>
+#include <folly/io/Cursor.h>
+
+#include "fboss/agent/hw/mock/MockRxPacket.h"
+#include "fboss/agent/packet/EthHdr.h"
+#include "fboss/agent/packet/IPv4Hdr.h"
+#include "fboss/agent/packet/IPv6Hdr.h"
+#include "fboss/agent/packet/PktHeaderView.h"
+
+/*
+ * Packets/sec parsing the headers of trapped packets of each protocol, using
+ * the header classes one layer at a time (as the packet handlers used to do)
+ * and using PktHeaderView.
+ */
+
+using namespace facebook::fboss;
+using folly::io::Cursor;
+
+namespace {
+
+constexpr auto kEthHdr =
+    // dst mac, src mac, 802.1q, VLAN 1
+    "02 00 01 00 00 01  00 02 00 01 02 03  81 00 00 01";
+constexpr auto kIPv6Addrs =
+    "fe 80 00 00 00 00 00 00 02 02 00 ff fe 01 02 03"
+    "ff 02 00 00 00 00 00 00 00 00 00 01 ff 00 00 01";
+
+std::unique_ptr<MockRxPacket> makePacket(folly::StringPiece hex) {
+  auto pkt = MockRxPacket::fromHex(folly::to<std::string>(kEthHdr, hex));
+  pkt->padToLength(68);
+  return pkt;
+}
+
+const auto kArp = makePacket("08 06  00 01  08 00  06  04  00 01");
+const auto kLacp = makePacket("88 09  01 01");
+const auto kDhcpV4 = makePacket(
+    "08 00"
+    "45 00 01 48  00 00 00 00  40 11 00 00"
+    "00 00 00 00  ff ff ff ff"
+    "00 44 00 43  01 34 00 00");
+const auto kTtlExpiredV4 = makePacket(
+    "08 00"
+    "45 00 00 1c  00 00 00 00  01 06 00 00"
+    "0a 00 00 0f  0a 01 00 01");
+const auto kNdp = makePacket(folly::to<std::string>(
+    "86 dd  60 00 00 00  00 20  3a ff",
+    kIPv6Addrs,
+    "87 00 00 00"));
+const auto kDhcpV6 = makePacket(folly::to<std::string>(
+    "86 dd  60 00 00 00  00 08  11 01",
+    kIPv6Addrs,
+    "02 22 02 23  00 08 00 00"));
+
+void parseWithHeaderClasses(const MockRxPacket* pkt, size_t iters) {
+  for (size_t i = 0; i < iters; ++i) {
+    Cursor cursor(pkt->buf());
+    EthHdr ethHdr(cursor);
+    switch (static_cast<ETHERTYPE>(ethHdr.getEtherType())) {
+      case ETHERTYPE::ETHERTYPE_IPV4: {
+        IPv4Hdr ipv4(cursor);
+        folly::doNotOptimizeAway(ipv4);
+        break;
+      }
+      case ETHERTYPE::ETHERTYPE_IPV6: {
+        IPv6Hdr ipv6(cursor);
+        folly::doNotOptimizeAway(ipv6);
+        break;
+      }
+      default:
+        break;
+    }
+    folly::doNotOptimizeAway(ethHdr);
+  }
+}
+
+void parseWithView(const MockRxPacket* pkt, size_t iters) {
+  for (size_t i = 0; i < iters; ++i) {
+    auto view = PktHeaderView::parse(pkt->buf());
+    folly::doNotOptimizeAway(view);
+  }
+}
+
+} // namespace
+
+BENCHMARK(HeaderClassesArp, iters) {
+  parseWithHeaderClasses(kArp.get(), iters);
+}
+BENCHMARK_RELATIVE(PktHeaderViewArp, iters) {
+  parseWithView(kArp.get(), iters);
+}
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(HeaderClassesLacp, iters) {
+  parseWithHeaderClasses(kLacp.get(), iters);
+}
+BENCHMARK_RELATIVE(PktHeaderViewLacp, iters) {
+  parseWithView(kLacp.get(), iters);
+}
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(HeaderClassesDhcpV4, iters) {
+  parseWithHeaderClasses(kDhcpV4.get(), iters);
+}
+BENCHMARK_RELATIVE(PktHeaderViewDhcpV4, iters) {
+  parseWithView(kDhcpV4.get(), iters);
+}
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(HeaderClassesTtlExpiredV4, iters) {
+  parseWithHeaderClasses(kTtlExpiredV4.get(), iters);
+}
+BENCHMARK_RELATIVE(PktHeaderViewTtlExpiredV4, iters) {
+  parseWithView(kTtlExpiredV4.get(), iters);
+}
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(HeaderClassesNdp, iters) {
+  parseWithHeaderClasses(kNdp.get(), iters);
+}
+BENCHMARK_RELATIVE(PktHeaderViewNdp, iters) {
+  parseWithView(kNdp.get(), iters);
+}
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(HeaderClassesDhcpV6, iters) {
+  parseWithHeaderClasses(kDhcpV6.get(), iters);
+}
+BENCHMARK_RELATIVE(PktHeaderViewDhcpV6, iters) {
+  parseWithView(kDhcpV6.get(), iters);
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
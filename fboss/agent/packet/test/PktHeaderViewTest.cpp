@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/packet/PktHeaderView.h"
+
+#include <gtest/gtest.h>
+
+#include <folly/Conv.h>
+#include <folly/MacAddress.h>
+#include <folly/io/Cursor.h>
+
+#include "fboss/agent/hw/mock/MockRxPacket.h"
+#include "fboss/agent/packet/Ethertype.h"
+#include "fboss/agent/packet/IPProto.h"
+
+using namespace facebook::fboss;
+using folly::MacAddress;
+
+namespace {
+constexpr auto kEthHdr =
+    // dst mac, src mac
+    "02 00 01 00 00 01  00 02 00 01 02 03";
+constexpr auto kIPv6Addrs =
+    "fe 80 00 00 00 00 00 00 02 02 00 ff fe 01 02 03"
+    "ff 02 00 00 00 00 00 00 00 00 00 01 ff 00 00 01";
+
+std::unique_ptr<MockRxPacket> makePacket(folly::StringPiece hex) {
+  return MockRxPacket::fromHex(folly::to<std::string>(kEthHdr, hex));
+}
+} // namespace
+
+TEST(PktHeaderViewTest, TooShort) {
+  auto pkt = MockRxPacket::fromHex("02 00 01 00 00 01  00 02 00 01 02 03  08");
+  EXPECT_FALSE(PktHeaderView::parse(pkt->buf()));
+
+  // VLAN tag without the ethertype following it
+  pkt = makePacket("81 00  00 01");
+  EXPECT_FALSE(PktHeaderView::parse(pkt->buf()));
+}
+
+TEST(PktHeaderViewTest, Arp) {
+  auto pkt = makePacket(
+      "81 00  00 05"
+      "08 06  00 01  08 00  06  04");
+  auto view = PktHeaderView::parse(pkt->buf());
+  ASSERT_TRUE(view);
+  EXPECT_EQ(MacAddress("02:00:01:00:00:01"), view->dstMac);
+  EXPECT_EQ(MacAddress("00:02:00:01:02:03"), view->srcMac);
+  EXPECT_EQ(0x0005, view->vlanTag);
+  EXPECT_EQ(static_cast<uint16_t>(ETHERTYPE::ETHERTYPE_ARP), view->etherType);
+  EXPECT_EQ(18, view->l3Offset);
+  EXPECT_FALSE(view->ipProto);
+  EXPECT_EQ(0x0001, view->l3Cursor(pkt->buf()).readBE<uint16_t>());
+}
+
+TEST(PktHeaderViewTest, IPv4WithOptions) {
+  auto pkt = makePacket(
+      "08 00"
+      // Version 4, IHL 6, total length, id, flags, TTL 1, proto ICMP, csum
+      "46 00 00 24  00 00 00 00  01 01 00 00"
+      // Source and destination IPs
+      "0a 00 00 0f  0a 00 00 01"
+      // Options
+      "01 01 01 00"
+      // ICMP echo request
+      "08 00 00 00");
+  auto view = PktHeaderView::parse(pkt->buf());
+  ASSERT_TRUE(view);
+  EXPECT_FALSE(view->vlanTag);
+  EXPECT_EQ(14, view->l3Offset);
+  EXPECT_EQ(static_cast<uint8_t>(IP_PROTO::IP_PROTO_ICMP), view->ipProto);
+  EXPECT_EQ(14 + 24, view->l4Offset);
+  EXPECT_EQ(8, view->icmpType);
+}
+
+TEST(PktHeaderViewTest, IPv4Truncated) {
+  auto pkt = makePacket("08 00  45 00 00 24");
+  auto view = PktHeaderView::parse(pkt->buf());
+  ASSERT_TRUE(view);
+  EXPECT_EQ(static_cast<uint16_t>(ETHERTYPE::ETHERTYPE_IPV4), view->etherType);
+  EXPECT_FALSE(view->ipProto);
+  EXPECT_FALSE(view->icmpType);
+}
+
+TEST(PktHeaderViewTest, IPv6NeighborSolicitation) {
+  auto pkt = makePacket(folly::to<std::string>(
+      "81 00  00 01  86 dd"
+      "60 00 00 00  00 20  3a ff",
+      kIPv6Addrs,
+      "87 00 00 00"));
+  auto view = PktHeaderView::parse(pkt->buf());
+  ASSERT_TRUE(view);
+  EXPECT_EQ(18, view->l3Offset);
+  EXPECT_EQ(static_cast<uint8_t>(IP_PROTO::IP_PROTO_IPV6_ICMP), view->ipProto);
+  EXPECT_EQ(18 + 40, view->l4Offset);
+  EXPECT_EQ(135, view->icmpType);
+}
+
+TEST(PktHeaderViewTest, IPv6Udp) {
+  auto pkt = makePacket(folly::to<std::string>(
+      "86 dd"
+      "60 00 00 00  00 08  11 ff",
+      kIPv6Addrs,
+      "02 22 02 23  00 08 00 00"));
+  auto view = PktHeaderView::parse(pkt->buf());
+  ASSERT_TRUE(view);
+  EXPECT_EQ(static_cast<uint8_t>(IP_PROTO::IP_PROTO_UDP), view->ipProto);
+  EXPECT_EQ(14 + 40, view->l4Offset);
+  EXPECT_FALSE(view->icmpType);
+}
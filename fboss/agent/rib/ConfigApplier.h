@@ -19,6 +19,8 @@
 
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 #include "fboss/agent/rib/NetworkToRouteMap.h"
+#include "fboss/agent/rib/NextHopDependencyIndex.h"
+#include "fboss/agent/rib/ResolutionDelta.h"
 #include "fboss/agent/rib/RoutingInformationBase.h"
 #include "fboss/agent/types.h"
 
@@ -46,6 +48,7 @@ class ConfigApplier {
       RouterID vrf,
       IPv4NetworkToRouteMap* v4RouteTable,
       IPv6NetworkToRouteMap* v6RouteTable,
+      NextHopDependencyIndex* nextHopDependencies,
       folly::Range<DirectlyConnectedRouteIterator> directlyConnectedRouteRange,
       folly::Range<StaticRouteNoNextHopsIterator> staticCpuRouteRange,
       folly::Range<StaticRouteNoNextHopsIterator> staticDropRouteRange,
@@ -53,6 +56,16 @@ class ConfigApplier {
       RoutingInformationBase::FibUpdateFunction fibUpdateCallback,
       void* cookie);
 
+  /*
+   * updateRib() brings the routes of this VRF in line with config and returns
+   * the resulting ResolutionDelta, without updating the FIB. It only touches
+   * the route tables of its own VRF, so ConfigAppliers of different VRFs can
+   * run it concurrently. updateFib() then passes that delta on to the FIB
+   * update callback.
+   */
+  ResolutionDelta updateRib();
+  void updateFib(const ResolutionDelta& delta);
+
   void updateRibAndFib();
 
  private:
@@ -64,6 +77,7 @@ class ConfigApplier {
   RouterID vrf_;
   IPv4NetworkToRouteMap* v4NetworkToRoute_;
   IPv6NetworkToRouteMap* v6NetworkToRoute_;
+  NextHopDependencyIndex* nextHopDependencies_;
   folly::Range<DirectlyConnectedRouteIterator> directlyConnectedRouteRange_;
   folly::Range<StaticRouteNoNextHopsIterator> staticCpuRouteRange_;
   folly::Range<StaticRouteNoNextHopsIterator> staticDropRouteRange_;
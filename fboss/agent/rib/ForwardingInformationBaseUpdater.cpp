@@ -23,10 +23,12 @@ namespace facebook::fboss::rib {
 ForwardingInformationBaseUpdater::ForwardingInformationBaseUpdater(
     RouterID vrf,
     const IPv4NetworkToRouteMap& v4NetworkToRoute,
-    const IPv6NetworkToRouteMap& v6NetworkToRoute)
+    const IPv6NetworkToRouteMap& v6NetworkToRoute,
+    ResolutionDelta delta)
     : vrf_(vrf),
       v4NetworkToRoute_(v4NetworkToRoute),
-      v6NetworkToRoute_(v6NetworkToRoute) {}
+      v6NetworkToRoute_(v6NetworkToRoute),
+      delta_(std::move(delta)) {}
 
 std::shared_ptr<SwitchState> ForwardingInformationBaseUpdater::operator()(
     const std::shared_ptr<SwitchState>& state) {
@@ -43,19 +45,71 @@ std::shared_ptr<SwitchState> ForwardingInformationBaseUpdater::operator()(
   auto previousFibContainer = state->getFibs()->getFibContainerIf(vrf_);
   CHECK(previousFibContainer);
 
-  auto nextFibContainer = previousFibContainer->modify(&nextState);
+  if (delta_.empty()) {
+    // Nothing changed in the RIB's forwarding information
+    return nextState;
+  }
 
-  nextFibContainer->writableFields()->fibV4 =
-      std::shared_ptr<ForwardingInformationBaseV4>(createUpdatedFib(
-          v4NetworkToRoute_, previousFibContainer->getFibV4()));
+  // Grab the FIBs before modify(): an unpublished container is modified in
+  // place.
+  auto previousFibV4 = previousFibContainer->getFibV4();
+  auto previousFibV6 = previousFibContainer->getFibV6();
+  auto nextFibContainer = previousFibContainer->modify(&nextState);
 
-  nextFibContainer->writableFields()->fibV6 =
-      std::shared_ptr<ForwardingInformationBaseV6>(createUpdatedFib(
-          v6NetworkToRoute_, previousFibContainer->getFibV6()));
+  if (delta_.isFull()) {
+    nextFibContainer->writableFields()->fibV4 =
+        std::shared_ptr<ForwardingInformationBaseV4>(
+            createUpdatedFib(v4NetworkToRoute_, previousFibV4));
+    nextFibContainer->writableFields()->fibV6 =
+        std::shared_ptr<ForwardingInformationBaseV6>(
+            createUpdatedFib(v6NetworkToRoute_, previousFibV6));
+  } else {
+    nextFibContainer->writableFields()->fibV4 =
+        applyDelta(v4NetworkToRoute_, previousFibV4);
+    nextFibContainer->writableFields()->fibV6 =
+        applyDelta(v6NetworkToRoute_, previousFibV6);
+  }
 
   return nextState;
 }
 
+template <typename AddressT>
+std::shared_ptr<typename facebook::fboss::ForwardingInformationBase<AddressT>>
+ForwardingInformationBaseUpdater::applyDelta(
+    const facebook::fboss::rib::NetworkToRouteMap<AddressT>& rib,
+    const std::shared_ptr<facebook::fboss::ForwardingInformationBase<AddressT>>&
+        fib) {
+  const auto& changedPrefixes = delta_.getChangedPrefixes<AddressT>();
+  if (changedPrefixes.empty()) {
+    return fib;
+  }
+
+  auto updatedFib = fib->isPublished() ? fib->clone() : fib;
+  for (const auto& prefix : changedPrefixes) {
+    facebook::fboss::RoutePrefix<AddressT> fibPrefix{prefix.network,
+                                                     prefix.mask};
+    auto ribIt = rib.exactMatch(prefix.network, prefix.mask);
+    if (ribIt == rib.end() || !ribIt->value().isResolved()) {
+      // The route is gone or can no longer be resolved
+      updatedFib->removeNodeIf(fibPrefix);
+      continue;
+    }
+
+    const facebook::fboss::rib::Route<AddressT>& ribRoute = ribIt->value();
+    auto fibRoute = updatedFib->getNodeIf(fibPrefix);
+    if (!fibRoute) {
+      updatedFib->addNode(toFibRoute(ribRoute));
+    } else if (
+        !(toFibNextHop(ribRoute.getForwardInfo()) ==
+          fibRoute->getForwardInfo()) ||
+        ribRoute.isConnected() != fibRoute->isConnected()) {
+      updatedFib->updateNode(toFibRoute(ribRoute));
+    }
+  }
+
+  return updatedFib;
+}
+
 template <typename AddressT>
 std::unique_ptr<typename facebook::fboss::ForwardingInformationBase<AddressT>>
 ForwardingInformationBaseUpdater::createUpdatedFib(
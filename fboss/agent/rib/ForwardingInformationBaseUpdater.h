@@ -10,6 +10,7 @@
 #pragma once
 
 #include "fboss/agent/rib/NetworkToRouteMap.h"
+#include "fboss/agent/rib/ResolutionDelta.h"
 #include "fboss/agent/rib/Route.h"
 #include "fboss/agent/state/ForwardingInformationBase.h"
 #include "fboss/agent/state/Route.h"
@@ -28,12 +29,20 @@ namespace facebook::fboss::rib {
 
 class RouteNextHopEntry;
 
+/*
+ * ForwardingInformationBaseUpdater brings the FIB of a VRF in line with the
+ * RIB. If the RIB update produced a (non-full) ResolutionDelta, only the
+ * prefixes in the delta are added, changed or removed in the FIB, which
+ * requires the FIB to reflect the RIB as it was before that update.
+ * Otherwise, the FIB is rebuilt from the whole RIB.
+ */
 class ForwardingInformationBaseUpdater {
  public:
   ForwardingInformationBaseUpdater(
       RouterID vrf,
       const IPv4NetworkToRouteMap& v4NetworkToRoute,
-      const IPv6NetworkToRouteMap& v6NetworkToRoute);
+      const IPv6NetworkToRouteMap& v6NetworkToRoute,
+      ResolutionDelta delta = ResolutionDelta::full());
 
   std::shared_ptr<SwitchState> operator()(
       const std::shared_ptr<SwitchState>& state);
@@ -52,9 +61,17 @@ class ForwardingInformationBaseUpdater {
       const std::shared_ptr<
           facebook::fboss::ForwardingInformationBase<AddressT>>& fib);
 
+  template <typename AddressT>
+  std::shared_ptr<typename facebook::fboss::ForwardingInformationBase<AddressT>>
+  applyDelta(
+      const facebook::fboss::rib::NetworkToRouteMap<AddressT>& rib,
+      const std::shared_ptr<
+          facebook::fboss::ForwardingInformationBase<AddressT>>& fib);
+
   RouterID vrf_;
   const IPv4NetworkToRouteMap& v4NetworkToRoute_;
   const IPv6NetworkToRouteMap& v6NetworkToRoute_;
+  ResolutionDelta delta_;
 };
 
 } // namespace facebook::fboss::rib
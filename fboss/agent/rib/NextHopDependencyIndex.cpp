@@ -0,0 +1,162 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/rib/NextHopDependencyIndex.h"
+
+#include <algorithm>
+
+#include <glog/logging.h>
+
+namespace facebook::fboss::rib {
+
+template <>
+NextHopDependencyIndex::NextHopInfos<folly::IPAddressV4>&
+NextHopDependencyIndex::nextHops<folly::IPAddressV4>() {
+  return v4NextHops_;
+}
+
+template <>
+NextHopDependencyIndex::NextHopInfos<folly::IPAddressV6>&
+NextHopDependencyIndex::nextHops<folly::IPAddressV6>() {
+  return v6NextHops_;
+}
+
+template <>
+const NextHopDependencyIndex::NextHopInfos<folly::IPAddressV4>&
+NextHopDependencyIndex::nextHops<folly::IPAddressV4>() const {
+  return v4NextHops_;
+}
+
+template <>
+const NextHopDependencyIndex::NextHopInfos<folly::IPAddressV6>&
+NextHopDependencyIndex::nextHops<folly::IPAddressV6>() const {
+  return v6NextHops_;
+}
+
+template <typename AddressT>
+void NextHopDependencyIndex::addDependencyImpl(
+    const AddressT& nexthop,
+    std::optional<uint8_t> resolvedVia,
+    const folly::CIDRNetwork& dependent) {
+  auto& info = nextHops<AddressT>()[nexthop];
+  // Every lookup of the same next-hop within one resolution pass returns the
+  // same route, and all dependents of a next-hop are re-resolved together, so
+  // the latest lookup result is authoritative.
+  info.resolvedVia = resolvedVia;
+  info.dependents.insert(dependent);
+}
+
+void NextHopDependencyIndex::addDependency(
+    const folly::IPAddress& nexthop,
+    std::optional<uint8_t> resolvedVia,
+    const folly::CIDRNetwork& dependent) {
+  if (nexthop.isV4()) {
+    addDependencyImpl(nexthop.asV4(), resolvedVia, dependent);
+  } else {
+    addDependencyImpl(nexthop.asV6(), resolvedVia, dependent);
+  }
+
+  auto& usedNextHops = dependentToNextHops_[dependent];
+  if (std::find(usedNextHops.begin(), usedNextHops.end(), nexthop) ==
+      usedNextHops.end()) {
+    usedNextHops.push_back(nexthop);
+  }
+}
+
+template <typename AddressT>
+void NextHopDependencyIndex::removeDependencyImpl(
+    const AddressT& nexthop,
+    const folly::CIDRNetwork& dependent) {
+  auto& infos = nextHops<AddressT>();
+  auto it = infos.find(nexthop);
+  CHECK(it != infos.end());
+  it->second.dependents.erase(dependent);
+  if (it->second.dependents.empty()) {
+    infos.erase(it);
+  }
+}
+
+void NextHopDependencyIndex::removeDependent(
+    const folly::CIDRNetwork& dependent) {
+  auto it = dependentToNextHops_.find(dependent);
+  if (it == dependentToNextHops_.end()) {
+    return;
+  }
+  for (const auto& nexthop : it->second) {
+    if (nexthop.isV4()) {
+      removeDependencyImpl(nexthop.asV4(), dependent);
+    } else {
+      removeDependencyImpl(nexthop.asV6(), dependent);
+    }
+  }
+  dependentToNextHops_.erase(it);
+}
+
+template <typename AddressT, typename Predicate>
+void NextHopDependencyIndex::collectDependents(
+    const AddressT& network,
+    uint8_t mask,
+    Predicate shouldCollect,
+    Dependents* dependents) const {
+  const auto& infos = nextHops<AddressT>();
+  // Addresses inside network/mask are contiguous in the ordered map and none
+  // of them sorts before the (masked) network address itself.
+  for (auto it = infos.lower_bound(network);
+       it != infos.end() && it->first.inSubnet(network, mask);
+       ++it) {
+    if (shouldCollect(it->second)) {
+      dependents->insert(
+          it->second.dependents.begin(), it->second.dependents.end());
+    }
+  }
+}
+
+void NextHopDependencyIndex::getDependentsAffectedBy(
+    const folly::CIDRNetwork& prefix,
+    Dependents* affected) const {
+  auto mask = prefix.second;
+  // A next-hop that resolved through a more specific route than prefix keeps
+  // its longest match irrespective of what happens to prefix.
+  auto mayChange = [mask](const NextHopInfo& info) {
+    return !info.resolvedVia.has_value() || *info.resolvedVia <= mask;
+  };
+  if (prefix.first.isV4()) {
+    collectDependents(
+        prefix.first.asV4().mask(mask), mask, mayChange, affected);
+  } else {
+    collectDependents(
+        prefix.first.asV6().mask(mask), mask, mayChange, affected);
+  }
+}
+
+void NextHopDependencyIndex::getDependentsResolvedVia(
+    const folly::CIDRNetwork& prefix,
+    Dependents* dependents) const {
+  auto mask = prefix.second;
+  auto resolvedViaPrefix = [mask](const NextHopInfo& info) {
+    return info.resolvedVia.has_value() && *info.resolvedVia == mask;
+  };
+  if (prefix.first.isV4()) {
+    collectDependents(
+        prefix.first.asV4().mask(mask), mask, resolvedViaPrefix, dependents);
+  } else {
+    collectDependents(
+        prefix.first.asV6().mask(mask), mask, resolvedViaPrefix, dependents);
+  }
+}
+
+void NextHopDependencyIndex::clear() {
+  v4NextHops_.clear();
+  v6NextHops_.clear();
+  dependentToNextHops_.clear();
+  initialized_ = false;
+}
+
+} // namespace facebook::fboss::rib
@@ -0,0 +1,130 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/IPAddress.h>
+
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace facebook::fboss::rib {
+
+/*
+ * NextHopDependencyIndex records, for every next-hop address that had to be
+ * recursively resolved, the route (identified by its mask) that the next-hop
+ * resolved through and the set of routes whose resolution used that next-hop.
+ *
+ * RouteUpdater uses this reverse index to limit re-resolution to the routes
+ * whose resolution inputs changed:
+ * 1. When a route for prefix P is added, changed or removed, only next-hops
+ *    inside P which resolved through P or a route less specific than P (or
+ *    did not resolve at all) can see a different longest match.
+ * 2. When a route is re-resolved, its forwarding information may change and
+ *    so the routes that resolved through it have to be re-resolved too.
+ *
+ * Next-hops are keyed by address in an ordered map so that the next-hops
+ * covered by a prefix form a contiguous range.
+ */
+class NextHopDependencyIndex {
+ public:
+  using Dependents = std::set<folly::CIDRNetwork>;
+
+  /*
+   * Record that `dependent` used `nexthop` during resolution. `resolvedVia` is
+   * the mask of the route `nexthop` matched, or std::nullopt if no route
+   * matched.
+   */
+  void addDependency(
+      const folly::IPAddress& nexthop,
+      std::optional<uint8_t> resolvedVia,
+      const folly::CIDRNetwork& dependent);
+
+  /*
+   * Forget every next-hop `dependent` used during its last resolution.
+   */
+  void removeDependent(const folly::CIDRNetwork& dependent);
+
+  /*
+   * Collect the routes whose resolution may change because the route for
+   * `prefix` was added, changed or removed.
+   */
+  void getDependentsAffectedBy(
+      const folly::CIDRNetwork& prefix,
+      Dependents* affected) const;
+
+  /*
+   * Collect the routes that resolved at least one next-hop through the route
+   * for `prefix`.
+   */
+  void getDependentsResolvedVia(
+      const folly::CIDRNetwork& prefix,
+      Dependents* dependents) const;
+
+  /*
+   * The index is only usable once a full resolution pass has populated it.
+   * Routes restored from warm boot state, for instance, carry resolution
+   * results that were not recorded here.
+   */
+  bool isInitialized() const {
+    return initialized_;
+  }
+  void setInitialized() {
+    initialized_ = true;
+  }
+  void clear();
+
+  size_t numNextHops() const {
+    return v4NextHops_.size() + v6NextHops_.size();
+  }
+  size_t numDependents() const {
+    return dependentToNextHops_.size();
+  }
+
+ private:
+  struct NextHopInfo {
+    std::optional<uint8_t> resolvedVia;
+    Dependents dependents;
+  };
+
+  template <typename AddressT>
+  using NextHopInfos = std::map<AddressT, NextHopInfo>;
+
+  template <typename AddressT>
+  NextHopInfos<AddressT>& nextHops();
+  template <typename AddressT>
+  const NextHopInfos<AddressT>& nextHops() const;
+
+  template <typename AddressT>
+  void addDependencyImpl(
+      const AddressT& nexthop,
+      std::optional<uint8_t> resolvedVia,
+      const folly::CIDRNetwork& dependent);
+  template <typename AddressT>
+  void removeDependencyImpl(
+      const AddressT& nexthop,
+      const folly::CIDRNetwork& dependent);
+  template <typename AddressT, typename Predicate>
+  void collectDependents(
+      const AddressT& network,
+      uint8_t mask,
+      Predicate shouldCollect,
+      Dependents* dependents) const;
+
+  NextHopInfos<folly::IPAddressV4> v4NextHops_;
+  NextHopInfos<folly::IPAddressV6> v6NextHops_;
+  // Forward index, used to drop stale edges when a route is re-resolved
+  std::map<folly::CIDRNetwork, std::vector<folly::IPAddress>>
+      dependentToNextHops_;
+  bool initialized_{false};
+};
+
+} // namespace facebook::fboss::rib
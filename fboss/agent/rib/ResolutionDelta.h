@@ -0,0 +1,96 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/rib/RouteTypes.h"
+
+#include <folly/IPAddress.h>
+
+#include <vector>
+
+namespace facebook::fboss::rib {
+
+/*
+ * ResolutionDelta lists the prefixes whose resolved forwarding information
+ * (resolution status, next-hops or connectedness) changed during a RIB
+ * update, including prefixes whose routes were deleted.
+ *
+ * When every route had to be re-resolved, the delta is "full": it carries no
+ * prefixes and consumers have to consider the whole RIB.
+ */
+class ResolutionDelta {
+ public:
+  static ResolutionDelta full() {
+    ResolutionDelta delta;
+    delta.full_ = true;
+    return delta;
+  }
+
+  bool isFull() const {
+    return full_;
+  }
+
+  void addChangedPrefix(const folly::CIDRNetwork& prefix) {
+    if (prefix.first.isV4()) {
+      v4Prefixes_.push_back(PrefixV4{prefix.first.asV4(), prefix.second});
+    } else {
+      v6Prefixes_.push_back(PrefixV6{prefix.first.asV6(), prefix.second});
+    }
+  }
+
+  template <typename AddressT>
+  const std::vector<RoutePrefix<AddressT>>& getChangedPrefixes() const;
+
+  size_t size() const {
+    return v4Prefixes_.size() + v6Prefixes_.size();
+  }
+
+  bool empty() const {
+    return !full_ && size() == 0;
+  }
+
+  /*
+   * Fold the prefixes of other into this delta. Prefixes may then be listed
+   * more than once, which consumers tolerate as they re-read the RIB for each
+   * changed prefix.
+   */
+  void merge(const ResolutionDelta& other) {
+    if (full_) {
+      return;
+    }
+    if (other.full_) {
+      *this = full();
+      return;
+    }
+    v4Prefixes_.insert(
+        v4Prefixes_.end(), other.v4Prefixes_.begin(), other.v4Prefixes_.end());
+    v6Prefixes_.insert(
+        v6Prefixes_.end(), other.v6Prefixes_.begin(), other.v6Prefixes_.end());
+  }
+
+ private:
+  bool full_{false};
+  std::vector<PrefixV4> v4Prefixes_;
+  std::vector<PrefixV6> v6Prefixes_;
+};
+
+template <>
+inline const std::vector<PrefixV4>&
+ResolutionDelta::getChangedPrefixes<folly::IPAddressV4>() const {
+  return v4Prefixes_;
+}
+
+template <>
+inline const std::vector<PrefixV6>&
+ResolutionDelta::getChangedPrefixes<folly::IPAddressV6>() const {
+  return v6Prefixes_;
+}
+
+} // namespace facebook::fboss::rib
@@ -10,6 +10,7 @@
 
 #include "RouteUpdater.h"
 
+#include <algorithm>
 #include <numeric>
 
 #include <boost/container/flat_map.hpp>
@@ -37,8 +38,18 @@ static const auto kInterfaceRouteClientId = ClientID::INTERFACE_ROUTE;
 
 RouteUpdater::RouteUpdater(
     IPv4NetworkToRouteMap* v4Routes,
-    IPv6NetworkToRouteMap* v6Routes)
-    : v4Routes_(v4Routes), v6Routes_(v6Routes) {}
+    IPv6NetworkToRouteMap* v6Routes,
+    NextHopDependencyIndex* nextHopDependencies)
+    : v4Routes_(v4Routes),
+      v6Routes_(v6Routes),
+      nextHopDependencies_(nextHopDependencies) {}
+
+template <typename AddressT>
+void RouteUpdater::recordModified(const Prefix<AddressT>& prefix) {
+  if (nextHopDependencies_) {
+    modifiedPrefixes_.emplace_back(prefix.network, prefix.mask);
+  }
+}
 
 template <typename AddressT>
 void RouteUpdater::addRouteImpl(
@@ -55,12 +66,14 @@ void RouteUpdater::addRouteImpl(
     }
 
     route->update(clientID, entry);
+    recordModified(prefix);
     return;
   }
 
   CHECK(it == routes->end());
   routes->insert(
       prefix.network, prefix.mask, Route<AddressT>(prefix, clientID, entry));
+  recordModified(prefix);
 }
 
 void RouteUpdater::addRoute(
@@ -121,6 +134,7 @@ void RouteUpdater::delRouteImpl(
 
   Route<AddressT>& route = it->value();
   route.delEntryForClient(clientID);
+  recordModified(prefix);
 
   XLOG(DBG3) << "Deleted next-hops for prefix " << prefix.str()
              << "from client " << folly::to<std::string>(clientID);
@@ -153,7 +167,11 @@ void RouteUpdater::removeAllRoutesFromClientImpl(
 
   for (auto it = routes->begin(); it != routes->end(); ++it) {
     auto& route = it->value();
+    if (!route.getEntryForClient(clientID)) {
+      continue;
+    }
     route.delEntryForClient(clientID);
+    recordModified(route.prefix());
     if (route.hasNoEntry()) {
       // The nexthops we removed was the only one.  Delete the route.
       toDelete.push_back(it);
@@ -383,12 +401,20 @@ RouteNextHopSet mergeForwardInfos(
 template <typename AddressT>
 void RouteUpdater::getFwdInfoFromNhop(
     NetworkToRouteMap<AddressT>* routes,
+    const folly::CIDRNetwork& dependent,
     const AddressT& nh,
     const std::optional<LabelForwardingAction>& labelAction,
     bool* hasToCpu,
     bool* hasDrop,
     RouteNextHopSet& fwd) {
   auto it = routes->longestMatch(nh, nh.bitCount());
+  if (nextHopDependencies_) {
+    std::optional<uint8_t> resolvedVia;
+    if (it != routes->end()) {
+      resolvedVia = it->value().prefix().mask;
+    }
+    nextHopDependencies_->addDependency(nh, resolvedVia, dependent);
+  }
   if (it == routes->end()) {
     XLOG(DBG3) << "Could not find subnet for next-hop:  " << nh;
     // Unresolvable next hop
@@ -445,6 +471,8 @@ void RouteUpdater::resolveOne(Route<AddressT>* route) {
   bool hasToCpu{false};
   bool hasDrop{false};
   RouteNextHopSet fwd;
+  const folly::CIDRNetwork dependent{route->prefix().network,
+                                     route->prefix().mask};
 
   auto bestPair = route->getBestEntry();
   const auto clientId = bestPair.first;
@@ -476,6 +504,7 @@ void RouteUpdater::resolveOne(Route<AddressT>* route) {
       if (addr.isV4()) {
         getFwdInfoFromNhop(
             v4Routes_,
+            dependent,
             nh.addr().asV4(),
             nh.labelForwardingAction(),
             &hasToCpu,
@@ -485,6 +514,7 @@ void RouteUpdater::resolveOne(Route<AddressT>* route) {
         CHECK(addr.isV6());
         getFwdInfoFromNhop(
             v6Routes_,
+            dependent,
             nh.addr().asV6(),
             nh.labelForwardingAction(),
             &hasToCpu,
@@ -516,6 +546,14 @@ void RouteUpdater::resolveOne(Route<AddressT>* route) {
              << " route " << route->str();
 }
 
+template <typename AddressT>
+void RouteUpdater::clearForwardInfo(NetworkToRouteMap<AddressT>* routes) {
+  for (auto& entry : *routes) {
+    Route<AddressT>& route = entry.value();
+    route.clearForward();
+  }
+}
+
 template <typename AddressT>
 void RouteUpdater::resolve(NetworkToRouteMap<AddressT>* routes) {
   for (auto& entry : *routes) {
@@ -527,17 +565,152 @@ void RouteUpdater::resolve(NetworkToRouteMap<AddressT>* routes) {
 }
 
 template <typename AddressT>
-void RouteUpdater::updateDoneImpl(NetworkToRouteMap<AddressT>* routes) {
-  for (auto& entry : *routes) {
-    Route<AddressT>& route = entry.value();
-    route.clearForward();
+Route<AddressT>* FOLLY_NULLABLE RouteUpdater::findRoute(
+    NetworkToRouteMap<AddressT>* routes,
+    const Prefix<AddressT>& prefix) {
+  auto it = routes->exactMatch(prefix.network, prefix.mask);
+  return it == routes->end() ? nullptr : &(it->value());
+}
+
+template <typename AddressT>
+std::vector<std::optional<RouteUpdater::ForwardInfoSnapshot>>
+RouteUpdater::clearForwardInfo(
+    NetworkToRouteMap<AddressT>* routes,
+    const std::vector<Prefix<AddressT>>& prefixes) {
+  std::vector<std::optional<ForwardInfoSnapshot>> snapshots;
+  snapshots.reserve(prefixes.size());
+  for (const auto& prefix : prefixes) {
+    auto route = findRoute(routes, prefix);
+    snapshots.push_back(snapshotForwardInfo(route));
+    if (route) {
+      route->clearForward();
+    }
+  }
+  return snapshots;
+}
+
+template <typename AddressT>
+void RouteUpdater::resolve(
+    NetworkToRouteMap<AddressT>* routes,
+    const std::vector<Prefix<AddressT>>& prefixes) {
+  for (const auto& prefix : prefixes) {
+    auto route = findRoute(routes, prefix);
+    if (route && route->needResolve()) {
+      resolveOne(route);
+    }
   }
-  resolve(routes);
 }
 
-void RouteUpdater::updateDone() {
-  updateDoneImpl(v4Routes_);
-  updateDoneImpl(v6Routes_);
+template <typename AddressT>
+void RouteUpdater::collectChanges(
+    NetworkToRouteMap<AddressT>* routes,
+    const std::vector<Prefix<AddressT>>& prefixes,
+    const std::vector<std::optional<ForwardInfoSnapshot>>& previous,
+    ResolutionDelta* delta) {
+  CHECK_EQ(prefixes.size(), previous.size());
+  for (size_t i = 0; i < prefixes.size(); ++i) {
+    if (snapshotForwardInfo(findRoute(routes, prefixes[i])) != previous[i]) {
+      delta->addChangedPrefix({prefixes[i].network, prefixes[i].mask});
+    }
+  }
+}
+
+template <typename AddressT>
+std::optional<RouteUpdater::ForwardInfoSnapshot>
+RouteUpdater::snapshotForwardInfo(const Route<AddressT>* route) {
+  // Only resolved routes make it to the FIB
+  if (!route || !route->isResolved()) {
+    return std::nullopt;
+  }
+  return ForwardInfoSnapshot{route->getForwardInfo(), route->isConnected()};
+}
+
+ResolutionDelta RouteUpdater::resolveAll() {
+  if (nextHopDependencies_) {
+    nextHopDependencies_->clear();
+  }
+
+  // Clear both address families before resolving either of them: a route
+  // may have next-hops of the other address family.
+  clearForwardInfo(v4Routes_);
+  clearForwardInfo(v6Routes_);
+  resolve(v4Routes_);
+  resolve(v6Routes_);
+
+  if (nextHopDependencies_) {
+    nextHopDependencies_->setInitialized();
+  }
+  return ResolutionDelta::full();
+}
+
+ResolutionDelta RouteUpdater::resolveModified() {
+  std::sort(modifiedPrefixes_.begin(), modifiedPrefixes_.end());
+  modifiedPrefixes_.erase(
+      std::unique(modifiedPrefixes_.begin(), modifiedPrefixes_.end()),
+      modifiedPrefixes_.end());
+
+  // 1. Seed the set of routes to re-resolve with the modified routes and with
+  // the routes that looked up a next-hop whose longest match may have changed.
+  NextHopDependencyIndex::Dependents toResolve;
+  for (const auto& prefix : modifiedPrefixes_) {
+    toResolve.insert(prefix);
+    nextHopDependencies_->getDependentsAffectedBy(prefix, &toResolve);
+  }
+
+  // 2. Re-resolving a route may change its forwarding info, so every route
+  // which resolved through it has to be re-resolved as well.
+  std::vector<folly::CIDRNetwork> pending(toResolve.begin(), toResolve.end());
+  while (!pending.empty()) {
+    auto prefix = std::move(pending.back());
+    pending.pop_back();
+
+    NextHopDependencyIndex::Dependents dependents;
+    nextHopDependencies_->getDependentsResolvedVia(prefix, &dependents);
+    for (const auto& dependent : dependents) {
+      if (toResolve.insert(dependent).second) {
+        pending.push_back(dependent);
+      }
+    }
+  }
+
+  std::vector<PrefixV4> v4ToResolve;
+  std::vector<PrefixV6> v6ToResolve;
+  for (const auto& prefix : toResolve) {
+    // Deleted routes only need their dependencies dropped
+    nextHopDependencies_->removeDependent(prefix);
+    if (prefix.first.isV4()) {
+      v4ToResolve.push_back(PrefixV4{prefix.first.asV4(), prefix.second});
+    } else {
+      v6ToResolve.push_back(PrefixV6{prefix.first.asV6(), prefix.second});
+    }
+  }
+
+  // 3. Forget the previous resolution of every route we are going to
+  // re-resolve, in both address families before resolving either of them.
+  auto v4Previous = clearForwardInfo(v4Routes_, v4ToResolve);
+  auto v6Previous = clearForwardInfo(v6Routes_, v6ToResolve);
+
+  // 4. Resolve. Routes outside of toResolve keep their forwarding info and
+  // are used as is when reached through recursive lookups.
+  resolve(v4Routes_, v4ToResolve);
+  resolve(v6Routes_, v6ToResolve);
+
+  ResolutionDelta delta;
+  collectChanges(v4Routes_, v4ToResolve, v4Previous, &delta);
+  collectChanges(v6Routes_, v6ToResolve, v6Previous, &delta);
+
+  XLOG(DBG3) << "Re-resolved " << toResolve.size() << " routes for "
+             << modifiedPrefixes_.size() << " modified prefixes, "
+             << delta.size() << " changed forwarding";
+  return delta;
+}
+
+ResolutionDelta RouteUpdater::updateDone() {
+  auto delta = nextHopDependencies_ && nextHopDependencies_->isInitialized()
+      ? resolveModified()
+      : resolveAll();
+  modifiedPrefixes_.clear();
+  return delta;
 }
 
 } // namespace facebook::fboss::rib
@@ -13,6 +13,8 @@
 #include "fboss/agent/types.h"
 
 #include "fboss/agent/rib/NetworkToRouteMap.h"
+#include "fboss/agent/rib/NextHopDependencyIndex.h"
+#include "fboss/agent/rib/ResolutionDelta.h"
 #include "fboss/agent/rib/Route.h"
 #include "fboss/agent/rib/RouteNextHopEntry.h"
 #include "fboss/agent/rib/RouteNextHopsMulti.h"
@@ -20,6 +22,9 @@
 
 #include <folly/IPAddress.h>
 
+#include <optional>
+#include <vector>
+
 namespace facebook::fboss::rib {
 
 /**
@@ -45,12 +50,18 @@ namespace facebook::fboss::rib {
  *    only IP nexthops will be in the final ECMP group.
  * 5. If and only if TO_CPU is the only nexthop (directly or indirectly) of
  *    a route, TO_CPU action will be only path in the resolved ECMP group.
+ *
+ * When a NextHopDependencyIndex is supplied, updateDone() only re-resolves
+ * the routes that were modified through this RouteUpdater and the routes
+ * whose resolution (transitively) depended on them. Without one, or before
+ * the index has been populated, every route is re-resolved.
  */
 class RouteUpdater {
  public:
   RouteUpdater(
       IPv4NetworkToRouteMap* v4Routes,
-      IPv6NetworkToRouteMap* v6Routes);
+      IPv6NetworkToRouteMap* v6Routes,
+      NextHopDependencyIndex* nextHopDependencies = nullptr);
 
   void addRoute(
       const folly::IPAddress& network,
@@ -70,11 +81,19 @@ class RouteUpdater {
   void delLinkLocalRoutes();
   void removeAllRoutesForClient(ClientID clientID);
 
-  void updateDone();
+  /*
+   * Resolves the routes affected by the updates made through this
+   * RouteUpdater and returns the prefixes whose forwarding info changed.
+   */
+  ResolutionDelta updateDone();
 
  private:
   IPv4NetworkToRouteMap* v4Routes_{nullptr};
   IPv6NetworkToRouteMap* v6Routes_{nullptr};
+  NextHopDependencyIndex* nextHopDependencies_{nullptr};
+  // Prefixes added, changed or deleted since construction. Only tracked when
+  // nextHopDependencies_ is set.
+  std::vector<folly::CIDRNetwork> modifiedPrefixes_;
 
   // TODO(samank): rename in original file
   template <typename AddressT>
@@ -97,16 +116,57 @@ class RouteUpdater {
       NetworkToRouteMap<AddressT>* routes,
       ClientID clientID);
   template <typename AddressT>
-  void updateDoneImpl(NetworkToRouteMap<AddressT>* routes);
+  void recordModified(const Prefix<AddressT>& prefix);
+
+  struct ForwardInfoSnapshot {
+    RouteNextHopEntry fwd;
+    bool connected;
+
+    bool operator==(const ForwardInfoSnapshot& other) const {
+      return connected == other.connected && fwd == other.fwd;
+    }
+    bool operator!=(const ForwardInfoSnapshot& other) const {
+      return !(*this == other);
+    }
+  };
+
+  ResolutionDelta resolveAll();
+  ResolutionDelta resolveModified();
 
+  template <typename AddressT>
+  void clearForwardInfo(NetworkToRouteMap<AddressT>* routes);
   template <typename AddressT>
   void resolve(NetworkToRouteMap<AddressT>* routes);
+
+  template <typename AddressT>
+  Route<AddressT>* FOLLY_NULLABLE findRoute(
+      NetworkToRouteMap<AddressT>* routes,
+      const Prefix<AddressT>& prefix);
+  template <typename AddressT>
+  std::vector<std::optional<ForwardInfoSnapshot>> clearForwardInfo(
+      NetworkToRouteMap<AddressT>* routes,
+      const std::vector<Prefix<AddressT>>& prefixes);
+  template <typename AddressT>
+  void resolve(
+      NetworkToRouteMap<AddressT>* routes,
+      const std::vector<Prefix<AddressT>>& prefixes);
+  template <typename AddressT>
+  void collectChanges(
+      NetworkToRouteMap<AddressT>* routes,
+      const std::vector<Prefix<AddressT>>& prefixes,
+      const std::vector<std::optional<ForwardInfoSnapshot>>& previous,
+      ResolutionDelta* delta);
+  template <typename AddressT>
+  static std::optional<ForwardInfoSnapshot> snapshotForwardInfo(
+      const Route<AddressT>* route);
+
   template <typename AddressT>
   void resolveOne(Route<AddressT>* route);
 
   template <typename AddressT>
   void getFwdInfoFromNhop(
       NetworkToRouteMap<AddressT>* routes,
+      const folly::CIDRNetwork& dependent,
       const AddressT& nh,
       const std::optional<LabelForwardingAction>& labelAction,
       bool* hasToCpu,
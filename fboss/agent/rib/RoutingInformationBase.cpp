@@ -17,9 +17,21 @@
 #include "fboss/agent/rib/RouteNextHopEntry.h"
 #include "fboss/agent/rib/RouteUpdater.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/futures/Future.h>
+#include <gflags/gflags.h>
+
+#include <algorithm>
+#include <exception>
 #include <memory>
 #include <utility>
 
+DEFINE_int32(
+    rib_reconfigure_threads,
+    4,
+    "Maximum number of VRFs whose routes are updated concurrently when "
+    "applying config to the RIB");
+
 namespace {
 class Timer {
  public:
@@ -40,6 +52,19 @@ class Timer {
 
 namespace facebook::fboss::rib {
 
+namespace {
+template <typename AddressT>
+NetworkToRouteMap<AddressT> copyNetworkToRouteMap(
+    const NetworkToRouteMap<AddressT>& networkToRoute) {
+  NetworkToRouteMap<AddressT> copy;
+  for (const auto& route : networkToRoute) {
+    const auto& prefix = route.value().prefix();
+    copy.insert(prefix.network, prefix.mask, route.value());
+  }
+  return copy;
+}
+} // namespace
+
 void RoutingInformationBase::reconfigure(
     const RouterIDAndNetworkToInterfaceRoutes& configRouterIDToInterfaceRoutes,
     const std::vector<cfg::StaticRouteWithNextHops>& staticRoutesWithNextHops,
@@ -70,14 +95,20 @@ void RoutingInformationBase::reconfigure(
   *lockedRouteTables =
       constructRouteTables(lockedRouteTables, configRouterIDToInterfaceRoutes);
 
-  // Because of this sequential loop over each VRF, config application scales
-  // linearly with the number of VRFs. If FBOSS is run in a multi-VRF routing
-  // architecture in the future, this slow-down can be avoided by parallelizing
-  // this loop. Converting this loop to use task-level parallelism should be
-  // straightfoward because it has been written to avoid dependencies across
-  // different iterations of the loop.
+  // Nobody else can get to the route tables while we hold the write lock on
+  // the map of VRFs, but lock them all the same, on behalf of the
+  // ConfigAppliers below.
+  std::vector<SynchronizedRouteTable::WLockedPtr> lockedVrfRouteTables;
+  lockedVrfRouteTables.reserve(lockedRouteTables->size());
+  std::vector<ConfigApplier> configAppliers;
+  configAppliers.reserve(lockedRouteTables->size());
+  std::vector<RouterID> vrfs;
+  vrfs.reserve(lockedRouteTables->size());
   for (auto& vrfAndRouteTable : *lockedRouteTables) {
     auto vrf = vrfAndRouteTable.first;
+    vrfs.push_back(vrf);
+    lockedVrfRouteTables.push_back(vrfAndRouteTable.second->wlock());
+    auto& routeTable = *lockedVrfRouteTables.back();
     const auto& interfaceRoutes = configRouterIDToInterfaceRoutes.at(vrf);
 
     // A ConfigApplier object should be independent of the VRF whose routes it
@@ -87,10 +118,11 @@ void RoutingInformationBase::reconfigure(
 
     // ConfigApplier can be made independent of the VRF whose routes it is
     // processing by the use of boost::filter_iterator.
-    ConfigApplier configApplier(
+    configAppliers.emplace_back(
         vrf,
-        &(vrfAndRouteTable.second.v4NetworkToRoute),
-        &(vrfAndRouteTable.second.v6NetworkToRoute),
+        &(routeTable.v4NetworkToRoute),
+        &(routeTable.v6NetworkToRoute),
+        &(routeTable.nextHopDependencies),
         folly::range(interfaceRoutes.cbegin(), interfaceRoutes.cend()),
         folly::range(staticRoutesToCpu.cbegin(), staticRoutesToCpu.cend()),
         folly::range(staticRoutesToNull.cbegin(), staticRoutesToNull.cend()),
@@ -98,8 +130,70 @@ void RoutingInformationBase::reconfigure(
             staticRoutesWithNextHops.cbegin(), staticRoutesWithNextHops.cend()),
         updateFibCallback,
         cookie);
+  }
+
+  // Steps 2-4 have no dependencies across VRFs, so they are run in parallel.
+  std::vector<ResolutionDelta> deltas(configAppliers.size());
+  std::vector<std::exception_ptr> errors(configAppliers.size());
+  auto updateRib = [&configAppliers, &deltas, &errors](size_t i) {
+    try {
+      deltas[i] = configAppliers[i].updateRib();
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  };
+  auto numThreads = std::min<size_t>(
+      configAppliers.size(), std::max(FLAGS_rib_reconfigure_threads, 1));
+  if (numThreads <= 1) {
+    for (auto i = 0; i < configAppliers.size(); ++i) {
+      updateRib(i);
+    }
+  } else {
+    if (!reconfigureExecutor_) {
+      reconfigureExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+          std::max(FLAGS_rib_reconfigure_threads, 1));
+    }
+    std::vector<folly::Future<folly::Unit>> futures;
+    futures.reserve(configAppliers.size());
+    for (auto i = 0; i < configAppliers.size(); ++i) {
+      futures.push_back(folly::via(
+          reconfigureExecutor_.get(), [&updateRib, i]() { updateRib(i); }));
+    }
+    folly::collectAll(futures.begin(), futures.end()).wait();
+  }
 
-    configApplier.updateRibAndFib();
+  auto firstError = std::find_if(
+      errors.begin(), errors.end(), [](const auto& error) { return !!error; });
+  if (firstError != errors.end()) {
+    // The RIBs of the other VRFs were updated, so their FIBs have to catch
+    // up on the next FIB update. A failed VRF may be partially updated, so
+    // its FIB is rebuilt.
+    for (auto i = 0; i < configAppliers.size(); ++i) {
+      lockedVrfRouteTables[i]->pendingFibDelta.merge(
+          errors[i] ? ResolutionDelta::full() : deltas[i]);
+    }
+    std::rethrow_exception(*firstError);
+  }
+
+  // Step 5. FIB update callbacks typically modify one SwitchState, so these
+  // are applied back to back, once all VRFs are done, rather than
+  // interleaved with RIB updates.
+  for (auto i = 0; i < configAppliers.size(); ++i) {
+    try {
+      updateFib(
+          vrfs[i],
+          &(*lockedVrfRouteTables[i]),
+          std::move(deltas[i]),
+          updateFibCallback,
+          cookie);
+    } catch (const std::exception&) {
+      // updateFib() kept the delta of this VRF pending, so keep those of the
+      // VRFs not reached yet as well
+      for (auto j = i + 1; j < configAppliers.size(); ++j) {
+        lockedVrfRouteTables[j]->pendingFibDelta.merge(deltas[j]);
+      }
+      throw;
+    }
   }
 }
 
@@ -117,15 +211,161 @@ RoutingInformationBase::UpdateStatistics RoutingInformationBase::update(
 
   Timer updateTimer(&stats.duration);
 
-  auto lockedRouteTables = synchronizedRouteTables_.wlock();
+  // Only a shared lock on the map of VRFs, so that updates to other VRFs
+  // can proceed concurrently
+  auto lockedRouteTables = synchronizedRouteTables_.rlock();
+
+  auto it = lockedRouteTables->find(routerID);
+  if (it == lockedRouteTables->end()) {
+    throw FbossError("VRF ", routerID, " not configured");
+  }
+  auto lockedRouteTable = it->second->wlock();
+
+  auto delta = updateRouteTable(
+      &(*lockedRouteTable),
+      clientID,
+      adminDistanceFromClientID,
+      toAdd,
+      toDelete,
+      resetClientsRoutes,
+      &stats);
+
+  updateFib(
+      routerID,
+      &(*lockedRouteTable),
+      std::move(delta),
+      fibUpdateCallback,
+      cookie);
+
+  return stats;
+}
+
+RoutingInformationBase::UpdateStatistics RoutingInformationBase::updateRibOnly(
+    RouterID routerID,
+    ClientID clientID,
+    AdminDistance adminDistanceFromClientID,
+    const std::vector<UnicastRoute>& toAdd,
+    const std::vector<IpPrefix>& toDelete,
+    bool resetClientsRoutes,
+    folly::StringPiece /* updateType */) {
+  UpdateStatistics stats;
+
+  Timer updateTimer(&stats.duration);
+
+  auto lockedRouteTables = synchronizedRouteTables_.rlock();
 
   auto it = lockedRouteTables->find(routerID);
   if (it == lockedRouteTables->end()) {
     throw FbossError("VRF ", routerID, " not configured");
   }
+  auto lockedRouteTable = it->second->wlock();
+
+  auto delta = updateRouteTable(
+      &(*lockedRouteTable),
+      clientID,
+      adminDistanceFromClientID,
+      toAdd,
+      toDelete,
+      resetClientsRoutes,
+      &stats);
+  lockedRouteTable->pendingFibDelta.merge(delta);
 
+  return stats;
+}
+
+bool RoutingInformationBase::syncFib(
+    RouterID routerID,
+    FibUpdateFunction fibUpdateCallback,
+    void* cookie) {
+  bool synced = false;
+  while (true) {
+    SynchronizedRouteTable* routeTable;
+    ResolutionDelta delta;
+    IPv4NetworkToRouteMap v4NetworkToRoute;
+    IPv6NetworkToRouteMap v6NetworkToRoute;
+    uint64_t fibUpdate;
+    {
+      auto lockedRouteTables = synchronizedRouteTables_.rlock();
+
+      auto it = lockedRouteTables->find(routerID);
+      if (it == lockedRouteTables->end()) {
+        // The VRF was removed by reconfiguration, along with its pending
+        // delta
+        return synced;
+      }
+      routeTable = it->second.get();
+      auto lockedRouteTable = routeTable->wlock();
+      if (lockedRouteTable->pendingFibDelta.empty()) {
+        return synced;
+      }
+
+      delta =
+          std::exchange(lockedRouteTable->pendingFibDelta, ResolutionDelta());
+      v4NetworkToRoute =
+          copyNetworkToRouteMap(lockedRouteTable->v4NetworkToRoute);
+      v6NetworkToRoute =
+          copyNetworkToRouteMap(lockedRouteTable->v6NetworkToRoute);
+      fibUpdate = ++lockedRouteTable->fibUpdates;
+    }
+
+    // Puts the delta back into the pending one if the callback failed, or if
+    // another FIB update of this VRF, from more recent routes, started in
+    // the meantime and may have been overwritten by this one. Returns
+    // whether it did.
+    auto requeueDelta = [this, routerID, routeTable, fibUpdate, &delta](
+                            bool failed) {
+      auto lockedRouteTables = synchronizedRouteTables_.rlock();
+      auto it = lockedRouteTables->find(routerID);
+      if (it == lockedRouteTables->end()) {
+        return false;
+      }
+      auto lockedRouteTable = it->second->wlock();
+      if (!failed && it->second.get() == routeTable &&
+          lockedRouteTable->fibUpdates == fibUpdate) {
+        return false;
+      }
+      lockedRouteTable->pendingFibDelta.merge(delta);
+      return true;
+    };
+
+    // The callback typically waits for the FIB to be programmed by another
+    // thread, which may itself need the RIB's locks, e.g. to reconfigure it.
+    // Hence it is passed a copy of the routes, with no lock held.
+    try {
+      fibUpdateCallback(
+          routerID, v4NetworkToRoute, v6NetworkToRoute, delta, cookie);
+    } catch (const std::exception&) {
+      requeueDelta(true);
+      throw;
+    }
+    synced = true;
+
+    if (!requeueDelta(false)) {
+      return synced;
+    }
+  }
+}
+
+void RoutingInformationBase::resyncFibs() {
+  auto lockedRouteTables = synchronizedRouteTables_.rlock();
+  for (auto& vrfAndRouteTable : *lockedRouteTables) {
+    vrfAndRouteTable.second->wlock()->pendingFibDelta =
+        ResolutionDelta::full();
+  }
+}
+
+ResolutionDelta RoutingInformationBase::updateRouteTable(
+    RouteTable* routeTable,
+    ClientID clientID,
+    AdminDistance adminDistanceFromClientID,
+    const std::vector<UnicastRoute>& toAdd,
+    const std::vector<IpPrefix>& toDelete,
+    bool resetClientsRoutes,
+    UpdateStatistics* stats) const {
   RouteUpdater updater(
-      &(it->second.v4NetworkToRoute), &(it->second.v6NetworkToRoute));
+      &(routeTable->v4NetworkToRoute),
+      &(routeTable->v6NetworkToRoute),
+      &(routeTable->nextHopDependencies));
 
   if (resetClientsRoutes) {
     updater.removeAllRoutesForClient(clientID);
@@ -136,9 +376,9 @@ RoutingInformationBase::UpdateStatistics RoutingInformationBase::update(
     auto mask = static_cast<uint8_t>(route.dest.prefixLength);
 
     if (network.isV4()) {
-      ++stats.v4RoutesAdded;
+      ++stats->v4RoutesAdded;
     } else {
-      ++stats.v6RoutesAdded;
+      ++stats->v6RoutesAdded;
     }
 
     updater.addRoute(
@@ -153,38 +393,53 @@ RoutingInformationBase::UpdateStatistics RoutingInformationBase::update(
     auto mask = static_cast<uint8_t>(prefix.prefixLength);
 
     if (network.isV4()) {
-      ++stats.v4RoutesDeleted;
+      ++stats->v4RoutesDeleted;
     } else {
-      ++stats.v6RoutesDeleted;
+      ++stats->v6RoutesDeleted;
     }
 
     updater.delRoute(network, mask, clientID);
   }
 
-  updater.updateDone();
-
-  fibUpdateCallback(
-      routerID,
-      it->second.v4NetworkToRoute,
-      it->second.v6NetworkToRoute,
-      cookie);
+  return updater.updateDone();
+}
 
-  return stats;
+void RoutingInformationBase::updateFib(
+    RouterID routerID,
+    RouteTable* routeTable,
+    ResolutionDelta delta,
+    const FibUpdateFunction& fibUpdateCallback,
+    void* cookie) const {
+  // The FIB reflects the RIB except for the pending prefixes, so those have
+  // to go along with any new changes
+  delta.merge(std::exchange(routeTable->pendingFibDelta, ResolutionDelta()));
+  ++routeTable->fibUpdates;
+
+  try {
+    fibUpdateCallback(
+        routerID,
+        routeTable->v4NetworkToRoute,
+        routeTable->v6NetworkToRoute,
+        delta,
+        cookie);
+  } catch (const std::exception&) {
+    routeTable->pendingFibDelta = std::move(delta);
+    throw;
+  }
 }
 
 folly::dynamic RoutingInformationBase::toFollyDynamic() const {
   folly::dynamic rib = folly::dynamic::object;
 
   auto lockedRouteTables = synchronizedRouteTables_.rlock();
-  for (const auto& routeTable : *lockedRouteTables) {
+  for (const auto& vrfAndRouteTable : *lockedRouteTables) {
     auto routerIdStr =
-        folly::to<std::string>(static_cast<uint32_t>(routeTable.first));
+        folly::to<std::string>(static_cast<uint32_t>(vrfAndRouteTable.first));
+    auto routeTable = vrfAndRouteTable.second->rlock();
     rib[routerIdStr] = folly::dynamic::object;
-    rib[routerIdStr][kRouterId] = static_cast<uint32_t>(routeTable.first);
-    rib[routerIdStr][kRibV4] =
-        routeTable.second.v4NetworkToRoute.toFollyDynamic();
-    rib[routerIdStr][kRibV6] =
-        routeTable.second.v6NetworkToRoute.toFollyDynamic();
+    rib[routerIdStr][kRouterId] = static_cast<uint32_t>(vrfAndRouteTable.first);
+    rib[routerIdStr][kRibV4] = routeTable->v4NetworkToRoute.toFollyDynamic();
+    rib[routerIdStr][kRibV6] = routeTable->v6NetworkToRoute.toFollyDynamic();
   }
 
   return rib;
@@ -198,10 +453,10 @@ RoutingInformationBase RoutingInformationBase::fromFollyDynamic(
   for (const auto& routeTable : ribJson.items()) {
     lockedRouteTables->insert(std::make_pair(
         RouterID(routeTable.first.asInt()),
-        RouteTable{
+        std::make_unique<SynchronizedRouteTable>(RouteTable{
             IPv4NetworkToRouteMap::fromFollyDynamic(routeTable.second[kRibV4]),
             IPv6NetworkToRouteMap::fromFollyDynamic(routeTable.second[kRibV6]),
-            UpdateStatistics{}}));
+            UpdateStatistics{}})));
   }
 
   return rib;
@@ -209,7 +464,8 @@ RoutingInformationBase RoutingInformationBase::fromFollyDynamic(
 
 void RoutingInformationBase::createVrf(RouterID rid) {
   auto lockedRouteTables = synchronizedRouteTables_.wlock();
-  lockedRouteTables->insert(std::make_pair(rid, RouteTable()));
+  lockedRouteTables->insert(
+      std::make_pair(rid, std::make_unique<SynchronizedRouteTable>()));
 }
 
 std::vector<RouterID> RoutingInformationBase::getVrfList() const {
@@ -224,19 +480,19 @@ std::vector<RouterID> RoutingInformationBase::getVrfList() const {
 std::vector<RouteDetails> RoutingInformationBase::getRouteTableDetails(
     RouterID rid) const {
   std::vector<RouteDetails> routeDetails;
-  SYNCHRONIZED_CONST(synchronizedRouteTables_) {
-    const auto it = synchronizedRouteTables_.find(rid);
-    if (it != synchronizedRouteTables_.end()) {
-      for (auto rit = it->second.v4NetworkToRoute.begin();
-           rit != it->second.v4NetworkToRoute.end();
-           ++rit) {
-        routeDetails.emplace_back(rit->value().toRouteDetails());
-      }
-      for (auto rit = it->second.v6NetworkToRoute.begin();
-           rit != it->second.v6NetworkToRoute.end();
-           ++rit) {
-        routeDetails.emplace_back(rit->value().toRouteDetails());
-      }
+  auto lockedRouteTables = synchronizedRouteTables_.rlock();
+  const auto it = lockedRouteTables->find(rid);
+  if (it != lockedRouteTables->end()) {
+    auto routeTable = it->second->rlock();
+    for (auto rit = routeTable->v4NetworkToRoute.begin();
+         rit != routeTable->v4NetworkToRoute.end();
+         ++rit) {
+      routeDetails.emplace_back(rit->value().toRouteDetails());
+    }
+    for (auto rit = routeTable->v6NetworkToRoute.begin();
+         rit != routeTable->v6NetworkToRoute.end();
+         ++rit) {
+      routeDetails.emplace_back(rit->value().toRouteDetails());
     }
   }
   return routeDetails;
@@ -255,7 +511,9 @@ RoutingInformationBase::constructRouteTables(
     const RouterID configVrf = routerIDAndInterfaceRoutes.first;
 
     newRouteTablesIter = newRouteTables.emplace_hint(
-        newRouteTables.cend(), configVrf, RouteTable());
+        newRouteTables.cend(),
+        configVrf,
+        std::make_unique<SynchronizedRouteTable>());
 
     auto oldRouteTablesIter = lockedRouteTables->find(configVrf);
     if (oldRouteTablesIter == lockedRouteTables->end()) {
@@ -277,7 +535,17 @@ bool RoutingInformationBase::operator==(
   const auto& routeTables = synchronizedRouteTables_.rlock();
   const auto& otherTables = other.synchronizedRouteTables_.rlock();
 
-  return *routeTables == *otherTables;
+  if (routeTables->size() != otherTables->size()) {
+    return false;
+  }
+  for (const auto& [vrf, routeTable] : *routeTables) {
+    auto otherIt = otherTables->find(vrf);
+    if (otherIt == otherTables->end() ||
+        *routeTable->rlock() != *otherIt->second->rlock()) {
+      return false;
+    }
+  }
+  return true;
 }
 
 } // namespace facebook::fboss::rib
@@ -12,13 +12,15 @@
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 #include "fboss/agent/if/gen-cpp2/FbossCtrl.h"
 #include "fboss/agent/rib/NetworkToRouteMap.h"
+#include "fboss/agent/rib/NextHopDependencyIndex.h"
+#include "fboss/agent/rib/ResolutionDelta.h"
 #include "fboss/agent/types.h"
 
 #include <folly/Synchronized.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 
 #include <functional>
 #include <memory>
-#include <thread>
 #include <vector>
 
 namespace facebook::fboss::rib {
@@ -29,6 +31,7 @@ class RoutingInformationBase {
       RouterID vrf,
       const IPv4NetworkToRouteMap& v4NetworkToRoute,
       const IPv6NetworkToRouteMap& v6NetworkToRoute,
+      const ResolutionDelta& delta,
       void* cookie)>;
 
   struct UpdateStatistics {
@@ -44,7 +47,8 @@ class RoutingInformationBase {
    * following sequence of actions:
    * 1. Injects and removes routes in `toAdd` and `toDelete`, respectively.
    * 2. Triggers recursive (IP) resolution.
-   * 3. Updates the FIB synchronously.
+   * 3. Updates the FIB synchronously, passing the prefixes whose forwarding
+   *    information changed to `fibUpdateCallback`.
    *
    * If a UnicastRoute does not specify its admin distance, then we derive its
    * admin distance via its clientID.  This is accomplished by a mapping from
@@ -64,6 +68,45 @@ class RoutingInformationBase {
       FibUpdateFunction fibUpdateCallback,
       void* cookie);
 
+  /*
+   * `updateRibOnly()` performs steps 1 and 2 of `update()` but leaves the FIB
+   * alone. The prefixes whose forwarding information changed are instead
+   * added to the VRF's pending FIB delta, which is passed to the FIB update
+   * callback, together with its own changes, by the next `syncFib()`,
+   * `update()` or `reconfigure()` of that VRF. Updates from several clients
+   * can thus be programmed with a single FIB update.
+   */
+  UpdateStatistics updateRibOnly(
+      RouterID routerID,
+      ClientID clientID,
+      AdminDistance adminDistanceFromClientID,
+      const std::vector<UnicastRoute>& toAdd,
+      const std::vector<IpPrefix>& toDelete,
+      bool resetClientsRoutes,
+      folly::StringPiece updateType);
+
+  /*
+   * Passes the pending FIB delta of routerID to `fibUpdateCallback`. Returns
+   * false, without calling `fibUpdateCallback`, if nothing was pending. If
+   * `fibUpdateCallback` throws, the delta is kept pending.
+   *
+   * Unlike `update()`, no lock is held while `fibUpdateCallback` runs: it is
+   * passed a copy of the VRF's routes, so that `updateRibOnly()` and
+   * `reconfigure()` do not wait for the FIB to be programmed.
+   */
+  bool syncFib(
+      RouterID routerID,
+      FibUpdateFunction fibUpdateCallback,
+      void* cookie);
+
+  /*
+   * Makes the next FIB update of every VRF rebuild its FIB from the whole
+   * RIB. To be called when a FIB update passed to a callback was discarded
+   * afterwards, as later deltas would otherwise be applied to a FIB which
+   * does not reflect the RIB.
+   */
+  void resyncFibs();
+
   /*
    * VrfAndNetworkToInterfaceRoute is conceptually a mapping from the pair
    * (RouterID, folly::CIDRNetwork) to the pair (Interface(1),
@@ -107,6 +150,17 @@ class RoutingInformationBase {
 
     UpdateStatistics lastUpdateStats_;
 
+    // Tracks which routes resolved through which next-hops so that updates
+    // only re-resolve the affected routes. Derived state, hence not compared
+    // or serialized.
+    NextHopDependencyIndex nextHopDependencies;
+
+    // Prefixes changed by updateRibOnly() which the FIB does not reflect yet.
+    ResolutionDelta pendingFibDelta;
+    // Counts the FIB updates passed to callbacks, so that syncFib() can tell
+    // whether another one started while it had no lock held.
+    uint64_t fibUpdates{0};
+
     bool operator==(const RouteTable& other) const {
       return v4NetworkToRoute == other.v4NetworkToRoute &&
           v6NetworkToRoute == other.v6NetworkToRoute;
@@ -117,21 +171,48 @@ class RoutingInformationBase {
   };
 
   /*
-   * Currently, route updates to separate VRFs are made to be sequential. In the
-   * event FBOSS has to operate in a routing architecture with numerous VRFs,
-   * we can avoid a slow down by a factor of number of VRFs by parallelizing
-   * route updates across VRFs. This can be accomplished simply by associating
-   * the mutex implicit in folly::Synchronized with an individual RouteTable.
+   * Each VRF's RouteTable is synchronized on its own, so that route updates
+   * to different VRFs proceed concurrently and readers only block updates to
+   * the VRF they read. The map of VRFs itself is only modified on
+   * reconfiguration. Locks are always acquired in the order: map of VRFs,
+   * then route table.
    */
-  using RouterIDToRouteTable = boost::container::flat_map<RouterID, RouteTable>;
+  using SynchronizedRouteTable = folly::Synchronized<RouteTable>;
+  using RouterIDToRouteTable = boost::container::
+      flat_map<RouterID, std::unique_ptr<SynchronizedRouteTable>>;
   using SynchronizedRouteTables = folly::Synchronized<RouterIDToRouteTable>;
 
+  /*
+   * Steps 1 and 2 of `update()`, on a route table the caller holds locked.
+   */
+  ResolutionDelta updateRouteTable(
+      RouteTable* routeTable,
+      ClientID clientID,
+      AdminDistance adminDistanceFromClientID,
+      const std::vector<UnicastRoute>& toAdd,
+      const std::vector<IpPrefix>& toDelete,
+      bool resetClientsRoutes,
+      UpdateStatistics* stats) const;
+
+  /*
+   * Passes delta, merged with the pending FIB delta, to fibUpdateCallback.
+   */
+  void updateFib(
+      RouterID routerID,
+      RouteTable* routeTable,
+      ResolutionDelta delta,
+      const FibUpdateFunction& fibUpdateCallback,
+      void* cookie) const;
+
   RouterIDToRouteTable constructRouteTables(
       const SynchronizedRouteTables::WLockedPtr& lockedRouteTables,
       const RouterIDAndNetworkToInterfaceRoutes&
           configRouterIDToInterfaceRoutes) const;
 
   SynchronizedRouteTables synchronizedRouteTables_;
+  // Updates the RIBs of different VRFs in parallel on reconfigure(). Created
+  // on the first reconfigure() which needs it.
+  std::unique_ptr<folly::CPUThreadPoolExecutor> reconfigureExecutor_;
 };
 
 } // namespace facebook::fboss::rib
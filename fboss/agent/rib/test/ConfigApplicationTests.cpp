@@ -8,6 +8,7 @@
  *
  */
 
+#include "fboss/agent/FbossError.h"
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 #include "fboss/agent/hw/mock/MockPlatform.h"
 #include "fboss/agent/rib/RouteTypes.h"
@@ -345,3 +346,39 @@ TEST(ConfigApplication, MultiVrfColdBoot) {
   fibContainer = fibMap->getFibContainer(RouterID(1));
   EXPECT_NE(nullptr, fibContainer);
 }
+
+TEST(ConfigApplication, MultiVrfFibUpdateFailureKeepsDeltasPending) {
+  rib::RoutingInformationBase rib;
+
+  rib::RoutingInformationBase::RouterIDAndNetworkToInterfaceRoutes
+      interfaceRoutes;
+  interfaceRoutes[RouterID(0)].emplace(
+      folly::IPAddress::createNetwork("1.1.1.0/24"),
+      std::make_pair(InterfaceID(1), folly::IPAddress("1.1.1.1")));
+  interfaceRoutes[RouterID(1)].emplace(
+      folly::IPAddress::createNetwork("2.2.2.0/24"),
+      std::make_pair(InterfaceID(2), folly::IPAddress("2.2.2.2")));
+
+  auto failingFibUpdate = [](RouterID /* vrf */,
+                             const rib::IPv4NetworkToRouteMap& /* v4 */,
+                             const rib::IPv6NetworkToRouteMap& /* v6 */,
+                             const rib::ResolutionDelta& /* delta */,
+                             void* /* cookie */) {
+    throw FbossError("FIB update failed");
+  };
+  auto noopFibUpdate = [](RouterID /* vrf */,
+                          const rib::IPv4NetworkToRouteMap& /* v4 */,
+                          const rib::IPv6NetworkToRouteMap& /* v6 */,
+                          const rib::ResolutionDelta& /* delta */,
+                          void* /* cookie */) {};
+
+  EXPECT_THROW(
+      rib.reconfigure(interfaceRoutes, {}, {}, {}, failingFibUpdate, nullptr),
+      FbossError);
+
+  // Neither the VRF whose FIB update failed nor the one which was not
+  // reached lose their FIB changes
+  EXPECT_TRUE(rib.syncFib(RouterID(0), noopFibUpdate, nullptr));
+  EXPECT_TRUE(rib.syncFib(RouterID(1), noopFibUpdate, nullptr));
+  EXPECT_FALSE(rib.syncFib(RouterID(0), noopFibUpdate, nullptr));
+}
@@ -10,6 +10,7 @@
 
 #include "common/network/if/gen-cpp2/Address_types.h"
 #include "fboss/agent/AddressUtil.h"
+#include "fboss/agent/FbossError.h"
 #include "fboss/agent/hw/mock/MockPlatform.h"
 #include "fboss/agent/if/gen-cpp2/ctrl_types.h"
 #include "fboss/agent/rib/ForwardingInformationBaseUpdater.h"
@@ -18,6 +19,7 @@
 #include "fboss/agent/rib/RouteNextHop.h"
 #include "fboss/agent/rib/RouteNextHopEntry.h"
 #include "fboss/agent/rib/RouteTypes.h"
+#include "fboss/agent/rib/RoutingInformationBase.h"
 #include "fboss/agent/state/ForwardingInformationBase.h"
 #include "fboss/agent/state/ForwardingInformationBaseContainer.h"
 #include "fboss/agent/state/ForwardingInformationBaseMap.h"
@@ -34,6 +36,7 @@
 #include <folly/functional/Partial.h>
 #include <gtest/gtest.h>
 #include <optional>
+#include <thread>
 
 using facebook::fboss::AdminDistance;
 using facebook::fboss::InterfaceID;
@@ -46,13 +49,21 @@ void dynamicFibUpdate(
     facebook::fboss::RouterID vrf,
     const facebook::fboss::rib::IPv4NetworkToRouteMap& v4NetworkToRoute,
     const facebook::fboss::rib::IPv6NetworkToRouteMap& v6NetworkToRoute,
+    const facebook::fboss::rib::ResolutionDelta& delta,
     void* cookie) {
   facebook::fboss::rib::ForwardingInformationBaseUpdater fibUpdater(
-      vrf, v4NetworkToRoute, v6NetworkToRoute);
+      vrf, v4NetworkToRoute, v6NetworkToRoute, delta);
 
   auto sw = static_cast<facebook::fboss::SwSwitch*>(cookie);
   sw->updateStateBlocking("", std::move(fibUpdater));
 }
+
+void noopFibUpdate(
+    facebook::fboss::RouterID /* vrf */,
+    const facebook::fboss::rib::IPv4NetworkToRouteMap& /* v4NetworkToRoute */,
+    const facebook::fboss::rib::IPv6NetworkToRouteMap& /* v6NetworkToRoute */,
+    const facebook::fboss::rib::ResolutionDelta& /* delta */,
+    void* /* cookie */) {}
 } // namespace
 
 TEST(RouteNextHopEntry, ConvertRibDropToFibDrop) {
@@ -518,6 +529,248 @@ TEST(Rib, Update) {
   EXPECT_FIB_SIZE(state, vrfZero, 4, 4);
 }
 
+TEST(Rib, ConcurrentUpdatesToDifferentVrfs) {
+  using namespace facebook::fboss;
+
+  constexpr auto kNumVrfs = 4;
+  constexpr auto kNumUpdates = 100;
+  rib::RoutingInformationBase rib;
+  for (auto vrf = 0; vrf < kNumVrfs; ++vrf) {
+    rib.createVrf(RouterID(vrf));
+  }
+
+  std::vector<std::thread> updaters;
+  for (auto vrf = 0; vrf < kNumVrfs; ++vrf) {
+    updaters.emplace_back([&rib, vrf]() {
+      for (auto i = 0; i < kNumUpdates; ++i) {
+        auto prefix = folly::IPAddressV4::fromLongHBO((10 << 24) + (i << 8));
+        rib.update(
+            RouterID(vrf),
+            ClientID(10),
+            AdminDistance::EBGP,
+            {createUnicastRoute(prefix, 24, folly::IPAddressV4("1.1.1.1"))},
+            {},
+            false /* sync */,
+            "rib update unit test",
+            &noopFibUpdate,
+            nullptr);
+        // Readers of one VRF only take shared locks
+        rib.getRouteTableDetails(RouterID((vrf + 1) % kNumVrfs));
+      }
+    });
+  }
+  for (auto& updater : updaters) {
+    updater.join();
+  }
+
+  for (auto vrf = 0; vrf < kNumVrfs; ++vrf) {
+    EXPECT_EQ(kNumUpdates, rib.getRouteTableDetails(RouterID(vrf)).size());
+  }
+}
+
+TEST(Rib, UpdateRibOnly) {
+  using namespace facebook::fboss;
+
+  const RouterID vrfZero{0};
+
+  cfg::SwitchConfig config;
+  config.vlans_ref()->resize(1);
+  *config.vlans_ref()[0].id_ref() = 1;
+  config.interfaces_ref()->resize(1);
+  *config.interfaces_ref()[0].intfID_ref() = 1;
+  *config.interfaces_ref()[0].vlanID_ref() = 1;
+  *config.interfaces_ref()[0].routerID_ref() = vrfZero;
+  config.interfaces_ref()[0].mac_ref() = "00:00:00:00:00:11";
+  config.interfaces_ref()[0].ipAddresses_ref()->resize(1);
+  config.interfaces_ref()[0].ipAddresses_ref()[0] = "10.120.70.44/31";
+
+  auto testHandle =
+      createTestHandle(&config, SwitchFlags::ENABLE_STANDALONE_RIB);
+  auto sw = testHandle->getSw();
+  auto rib = sw->getRib();
+
+  auto updateRibOnly = [&](ClientID client,
+                           const std::vector<UnicastRoute>& toAdd,
+                           const std::vector<IpPrefix>& toDelete) {
+    rib->updateRibOnly(
+        vrfZero,
+        client,
+        AdminDistance::EBGP,
+        toAdd,
+        toDelete,
+        false /* sync */,
+        "rib only unit test");
+  };
+  auto nexthop = folly::IPAddress("10.120.70.45");
+
+  // Updates from two clients are left pending...
+  updateRibOnly(
+      ClientID(10),
+      {createUnicastRoute(folly::IPAddress("20.0.0.0"), 8, nexthop)},
+      {});
+  updateRibOnly(
+      ClientID(20),
+      {createUnicastRoute(folly::IPAddress("30.0.0.0"), 8, nexthop)},
+      {});
+  EXPECT_NO_ROUTE(sw->getState(), vrfZero, folly::IPAddressV4("20.0.0.0"), 8);
+  EXPECT_NO_ROUTE(sw->getState(), vrfZero, folly::IPAddressV4("30.0.0.0"), 8);
+
+  // ...and programmed with a single FIB update
+  auto generation = sw->getState()->getGeneration();
+  EXPECT_TRUE(rib->syncFib(vrfZero, &dynamicFibUpdate, sw));
+  EXPECT_EQ(generation + 1, sw->getState()->getGeneration());
+  EXPECT_ROUTE(sw->getState(), vrfZero, folly::IPAddressV4("20.0.0.0"), 8);
+  EXPECT_ROUTE(sw->getState(), vrfZero, folly::IPAddressV4("30.0.0.0"), 8);
+  EXPECT_FALSE(rib->syncFib(vrfZero, &dynamicFibUpdate, sw));
+
+  // A synchronous update also programs what is pending
+  IpPrefix toDelete;
+  toDelete.ip_ref() =
+      facebook::network::toBinaryAddress(folly::IPAddress("20.0.0.0"));
+  toDelete.prefixLength_ref() = 8;
+  updateRibOnly(ClientID(10), {}, {toDelete});
+  rib->update(
+      vrfZero,
+      ClientID(20),
+      AdminDistance::EBGP,
+      {createUnicastRoute(folly::IPAddress("40.0.0.0"), 8, nexthop)},
+      {},
+      false /* sync */,
+      "rib only unit test",
+      &dynamicFibUpdate,
+      static_cast<void*>(sw));
+  EXPECT_NO_ROUTE(sw->getState(), vrfZero, folly::IPAddressV4("20.0.0.0"), 8);
+  EXPECT_ROUTE(sw->getState(), vrfZero, folly::IPAddressV4("40.0.0.0"), 8);
+  EXPECT_FALSE(rib->syncFib(vrfZero, &dynamicFibUpdate, sw));
+}
+
+TEST(Rib, SyncFibHoldsNoLockDuringFibUpdate) {
+  using namespace facebook::fboss;
+
+  const RouterID vrfZero{0};
+
+  cfg::SwitchConfig config;
+  config.vlans_ref()->resize(1);
+  *config.vlans_ref()[0].id_ref() = 1;
+  config.interfaces_ref()->resize(1);
+  *config.interfaces_ref()[0].intfID_ref() = 1;
+  *config.interfaces_ref()[0].vlanID_ref() = 1;
+  *config.interfaces_ref()[0].routerID_ref() = vrfZero;
+  config.interfaces_ref()[0].mac_ref() = "00:00:00:00:00:11";
+  config.interfaces_ref()[0].ipAddresses_ref()->resize(1);
+  config.interfaces_ref()[0].ipAddresses_ref()[0] = "10.120.70.44/31";
+
+  auto testHandle =
+      createTestHandle(&config, SwitchFlags::ENABLE_STANDALONE_RIB);
+  auto sw = testHandle->getSw();
+  auto rib = sw->getRib();
+  auto nexthop = folly::IPAddress("10.120.70.45");
+
+  auto update = [&](ClientID client,
+                    const std::vector<UnicastRoute>& toAdd,
+                    const std::vector<IpPrefix>& toDelete,
+                    bool ribOnly) {
+    if (ribOnly) {
+      rib->updateRibOnly(
+          vrfZero,
+          client,
+          AdminDistance::EBGP,
+          toAdd,
+          toDelete,
+          false /* sync */,
+          "sync fib unit test");
+    } else {
+      rib->update(
+          vrfZero,
+          client,
+          AdminDistance::EBGP,
+          toAdd,
+          toDelete,
+          false /* sync */,
+          "sync fib unit test",
+          &dynamicFibUpdate,
+          static_cast<void*>(sw));
+    }
+  };
+  IpPrefix prefix20;
+  prefix20.ip_ref() =
+      facebook::network::toBinaryAddress(folly::IPAddress("20.0.0.0"));
+  prefix20.prefixLength_ref() = 8;
+
+  // The RIB can be updated while the FIB update runs...
+  update(
+      ClientID(10),
+      {createUnicastRoute(folly::IPAddress("20.0.0.0"), 8, nexthop)},
+      {},
+      true /* ribOnly */);
+  EXPECT_TRUE(rib->syncFib(
+      vrfZero,
+      [&](RouterID vrf,
+          const rib::IPv4NetworkToRouteMap& v4NetworkToRoute,
+          const rib::IPv6NetworkToRouteMap& v6NetworkToRoute,
+          const rib::ResolutionDelta& delta,
+          void* cookie) {
+        update(
+            ClientID(10),
+            {createUnicastRoute(folly::IPAddress("30.0.0.0"), 8, nexthop)},
+            {},
+            true /* ribOnly */);
+        dynamicFibUpdate(
+            vrf, v4NetworkToRoute, v6NetworkToRoute, delta, cookie);
+      },
+      sw));
+  EXPECT_ROUTE(sw->getState(), vrfZero, folly::IPAddressV4("20.0.0.0"), 8);
+  EXPECT_NO_ROUTE(sw->getState(), vrfZero, folly::IPAddressV4("30.0.0.0"), 8);
+
+  // ...which leaves the new changes pending
+  EXPECT_TRUE(rib->syncFib(vrfZero, &dynamicFibUpdate, sw));
+  EXPECT_ROUTE(sw->getState(), vrfZero, folly::IPAddressV4("30.0.0.0"), 8);
+
+  // A failed FIB update is kept pending
+  update(ClientID(10), {}, {prefix20}, true /* ribOnly */);
+  EXPECT_THROW(
+      rib->syncFib(
+          vrfZero,
+          [](RouterID,
+             const rib::IPv4NetworkToRouteMap&,
+             const rib::IPv6NetworkToRouteMap&,
+             const rib::ResolutionDelta&,
+             void*) { throw FbossError("FIB update failed"); },
+          sw),
+      FbossError);
+  EXPECT_ROUTE(sw->getState(), vrfZero, folly::IPAddressV4("20.0.0.0"), 8);
+  EXPECT_TRUE(rib->syncFib(vrfZero, &dynamicFibUpdate, sw));
+  EXPECT_NO_ROUTE(sw->getState(), vrfZero, folly::IPAddressV4("20.0.0.0"), 8);
+
+  // A FIB update from older routes, which lands after one from newer routes,
+  // is redone from the newer routes
+  update(
+      ClientID(10),
+      {createUnicastRoute(folly::IPAddress("20.0.0.0"), 8, nexthop)},
+      {},
+      true /* ribOnly */);
+  EXPECT_TRUE(rib->syncFib(
+      vrfZero,
+      [&, removed = false](
+          RouterID vrf,
+          const rib::IPv4NetworkToRouteMap& v4NetworkToRoute,
+          const rib::IPv6NetworkToRouteMap& v6NetworkToRoute,
+          const rib::ResolutionDelta& delta,
+          void* cookie) mutable {
+        if (!removed) {
+          removed = true;
+          update(ClientID(10), {}, {prefix20}, false /* ribOnly */);
+          EXPECT_NO_ROUTE(
+              sw->getState(), vrfZero, folly::IPAddressV4("20.0.0.0"), 8);
+        }
+        dynamicFibUpdate(
+            vrf, v4NetworkToRoute, v6NetworkToRoute, delta, cookie);
+      },
+      sw));
+  EXPECT_NO_ROUTE(sw->getState(), vrfZero, folly::IPAddressV4("20.0.0.0"), 8);
+  EXPECT_FALSE(rib->syncFib(vrfZero, &dynamicFibUpdate, sw));
+}
+
 // There are 3 cases that should be exercised:
 // 1) a route has been added whose prefix _doesn't_ exist in the RIB
 // 2) a route has been added whose prefix exists in the RIB BUT whose
@@ -618,3 +871,174 @@ TEST(ForwardingInformationBaseUpdater, Deduplication) {
   ASSERT_TRUE(route3);
   EXPECT_NE(route, route3);
 }
+
+namespace {
+template <typename AddressT>
+void EXPECT_FIBS_MATCH(
+    const std::shared_ptr<facebook::fboss::ForwardingInformationBase<AddressT>>&
+        fibA,
+    const std::shared_ptr<facebook::fboss::ForwardingInformationBase<AddressT>>&
+        fibB) {
+  ASSERT_EQ(fibA->size(), fibB->size());
+  auto itA = fibA->begin();
+  auto itB = fibB->begin();
+  for (; itA != fibA->end(); ++itA, ++itB) {
+    EXPECT_EQ((*itA)->prefix(), (*itB)->prefix());
+    EXPECT_EQ((*itA)->getForwardInfo(), (*itB)->getForwardInfo());
+    EXPECT_EQ((*itA)->isConnected(), (*itB)->isConnected());
+  }
+}
+
+// Applies the delta to the FIB, and checks it yields the same FIB as a full
+// rebuild would have.
+void deltaFibUpdateCheckingFullRebuild(
+    facebook::fboss::RouterID vrf,
+    const facebook::fboss::rib::IPv4NetworkToRouteMap& v4NetworkToRoute,
+    const facebook::fboss::rib::IPv6NetworkToRouteMap& v6NetworkToRoute,
+    const facebook::fboss::rib::ResolutionDelta& delta,
+    void* cookie) {
+  auto sw = static_cast<facebook::fboss::SwSwitch*>(cookie);
+
+  facebook::fboss::rib::ForwardingInformationBaseUpdater fullUpdater(
+      vrf, v4NetworkToRoute, v6NetworkToRoute);
+  auto fullState = fullUpdater(sw->getState());
+
+  facebook::fboss::rib::ForwardingInformationBaseUpdater deltaUpdater(
+      vrf, v4NetworkToRoute, v6NetworkToRoute, delta);
+  sw->updateStateBlocking("", std::move(deltaUpdater));
+
+  auto fibContainer = sw->getState()->getFibs()->getFibContainer(vrf);
+  auto fullFibContainer = fullState->getFibs()->getFibContainer(vrf);
+  EXPECT_FIBS_MATCH(fullFibContainer->getFibV4(), fibContainer->getFibV4());
+  EXPECT_FIBS_MATCH(fullFibContainer->getFibV6(), fibContainer->getFibV6());
+}
+} // namespace
+
+TEST(ForwardingInformationBaseUpdater, DeltaMatchesFullRebuild) {
+  using namespace facebook::fboss;
+
+  const RouterID vrfZero{0};
+
+  cfg::SwitchConfig config;
+  config.vlans_ref()->resize(1);
+  *config.vlans_ref()[0].id_ref() = 1;
+  config.interfaces_ref()->resize(1);
+  *config.interfaces_ref()[0].intfID_ref() = 1;
+  *config.interfaces_ref()[0].vlanID_ref() = 1;
+  *config.interfaces_ref()[0].routerID_ref() = vrfZero;
+  config.interfaces_ref()[0].mac_ref() = "00:00:00:00:00:11";
+  config.interfaces_ref()[0].ipAddresses_ref()->resize(2);
+  config.interfaces_ref()[0].ipAddresses_ref()[0] = "10.120.70.44/31";
+  config.interfaces_ref()[0].ipAddresses_ref()[1] =
+      "2401:db00:e003:9100:1006::2c/127";
+
+  auto testHandle =
+      createTestHandle(&config, SwitchFlags::ENABLE_STANDALONE_RIB);
+  auto sw = testHandle->getSw();
+
+  auto update = [&](const std::vector<UnicastRoute>& toAdd,
+                    const std::vector<IpPrefix>& toDelete) {
+    sw->getRib()->update(
+        vrfZero,
+        ClientID(0),
+        AdminDistance::EBGP,
+        toAdd,
+        toDelete,
+        false /* sync */,
+        "delta unit test",
+        &deltaFibUpdateCheckingFullRebuild,
+        static_cast<void*>(sw));
+  };
+  auto toIpPrefix = [](folly::IPAddress address, uint8_t mask) {
+    IpPrefix prefix;
+    prefix.ip_ref() = facebook::network::toBinaryAddress(address);
+    prefix.prefixLength_ref() = mask;
+    return prefix;
+  };
+
+  // Recursive chain: 20/8 resolves through 10.1/16
+  update(
+      {createUnicastRoute(
+           folly::IPAddress("10.1.0.0"), 16, folly::IPAddress("10.120.70.45")),
+       createUnicastRoute(
+           folly::IPAddress("20.0.0.0"), 8, folly::IPAddress("10.1.1.1")),
+       createUnicastRoute(
+           folly::IPAddress("2401::"),
+           64,
+           folly::IPAddress("2401:db00:e003:9100:1006::2d"))},
+      {});
+  EXPECT_ROUTE(sw->getState(), vrfZero, folly::IPAddressV4("20.0.0.0"), 8);
+
+  // Unrelated update
+  update(
+      {createUnicastRoute(
+          folly::IPAddress("30.0.0.0"), 8, folly::IPAddress("10.120.70.45"))},
+      {});
+
+  // Removing the head of the chain removes both routes from the FIB
+  update({}, {toIpPrefix(folly::IPAddress("10.1.0.0"), 16)});
+  EXPECT_NO_ROUTE(sw->getState(), vrfZero, folly::IPAddressV4("10.1.0.0"), 16);
+  EXPECT_NO_ROUTE(sw->getState(), vrfZero, folly::IPAddressV4("20.0.0.0"), 8);
+  EXPECT_ROUTE(sw->getState(), vrfZero, folly::IPAddressV4("30.0.0.0"), 8);
+
+  // ...and adding it back brings both of them back
+  update(
+      {createUnicastRoute(
+          folly::IPAddress("10.1.0.0"), 16, folly::IPAddress("10.120.70.45"))},
+      {});
+  EXPECT_ROUTE(sw->getState(), vrfZero, folly::IPAddressV4("20.0.0.0"), 8);
+
+  update({}, {toIpPrefix(folly::IPAddress("2401::"), 64)});
+  EXPECT_NO_ROUTE(sw->getState(), vrfZero, folly::IPAddressV6("2401::"), 64);
+}
+
+TEST(Rib, ResyncFibsAfterDiscardedFibUpdate) {
+  using namespace facebook::fboss;
+
+  const RouterID vrfZero{0};
+
+  cfg::SwitchConfig config;
+  config.vlans_ref()->resize(1);
+  *config.vlans_ref()[0].id_ref() = 1;
+  config.interfaces_ref()->resize(1);
+  *config.interfaces_ref()[0].intfID_ref() = 1;
+  *config.interfaces_ref()[0].vlanID_ref() = 1;
+  *config.interfaces_ref()[0].routerID_ref() = vrfZero;
+  config.interfaces_ref()[0].mac_ref() = "00:00:00:00:00:11";
+  config.interfaces_ref()[0].ipAddresses_ref()->resize(1);
+  config.interfaces_ref()[0].ipAddresses_ref()[0] = "10.120.70.44/31";
+
+  auto testHandle =
+      createTestHandle(&config, SwitchFlags::ENABLE_STANDALONE_RIB);
+  auto sw = testHandle->getSw();
+  auto rib = sw->getRib();
+  auto nexthop = folly::IPAddress("10.120.70.45");
+
+  // The FIB update for 20/8 is thrown away, as a failed config application
+  // would, so the FIB no longer reflects the RIB
+  rib->update(
+      vrfZero,
+      ClientID(10),
+      AdminDistance::EBGP,
+      {createUnicastRoute(folly::IPAddress("20.0.0.0"), 8, nexthop)},
+      {},
+      false /* sync */,
+      "resync unit test",
+      &noopFibUpdate,
+      nullptr);
+  rib->resyncFibs();
+
+  // The next update rebuilds the FIB instead of applying its delta only
+  rib->update(
+      vrfZero,
+      ClientID(10),
+      AdminDistance::EBGP,
+      {createUnicastRoute(folly::IPAddress("30.0.0.0"), 8, nexthop)},
+      {},
+      false /* sync */,
+      "resync unit test",
+      &dynamicFibUpdate,
+      static_cast<void*>(sw));
+  EXPECT_ROUTE(sw->getState(), vrfZero, folly::IPAddressV4("20.0.0.0"), 8);
+  EXPECT_ROUTE(sw->getState(), vrfZero, folly::IPAddressV4("30.0.0.0"), 8);
+}
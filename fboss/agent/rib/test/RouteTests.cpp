@@ -21,6 +21,7 @@
 #include <folly/logging/xlog.h>
 
 #include <gtest/gtest.h>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -35,6 +36,7 @@ const ClientID kClientE = ClientID(1005);
 
 using rib::IPv4NetworkToRouteMap;
 using rib::IPv6NetworkToRouteMap;
+using rib::NextHopDependencyIndex;
 using rib::Route;
 using rib::RouteNextHopEntry;
 using rib::RouteNextHopSet;
@@ -1883,4 +1885,155 @@ TEST_F(UcmpTest, Ten) {
   runVaryFromHundredTest(10, {10, 10, 10, 1});
 }
 
+/*
+ * Applies the same sequence of updates to a RIB that resolves incrementally
+ * through a NextHopDependencyIndex and to one that re-resolves every route
+ * on each update, and checks that both end up identical.
+ */
+class IncrementalResolveTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    configRoutes(&v4Routes_, &v6Routes_);
+    configRoutes(&v4RoutesFull_, &v6RoutesFull_);
+  }
+
+  void update(std::function<void(RouteUpdater*)> updateFn) {
+    RouteUpdater incremental(&v4Routes_, &v6Routes_, &nextHopDependencies_);
+    updateFn(&incremental);
+    incremental.updateDone();
+
+    RouteUpdater full(&v4RoutesFull_, &v6RoutesFull_);
+    updateFn(&full);
+    full.updateDone();
+
+    EXPECT_TRUE(nextHopDependencies_.isInitialized());
+    EXPECT_ROUTES_MATCH(&v4RoutesFull_, &v4Routes_);
+    EXPECT_ROUTES_MATCH(&v6RoutesFull_, &v6Routes_);
+  }
+
+  void addRoute(
+      RouteUpdater* updater,
+      const std::string& network,
+      uint8_t mask,
+      std::vector<std::string> nexthops) {
+    updater->addRoute(
+        IPAddress(network),
+        mask,
+        kClientA,
+        RouteNextHopEntry(makeNextHops(std::move(nexthops)), kDistance));
+  }
+
+  IPv4NetworkToRouteMap v4Routes_;
+  IPv6NetworkToRouteMap v6Routes_;
+  NextHopDependencyIndex nextHopDependencies_;
+
+  IPv4NetworkToRouteMap v4RoutesFull_;
+  IPv6NetworkToRouteMap v6RoutesFull_;
+};
+
+TEST_F(IncrementalResolveTest, recursiveChain) {
+  update([this](RouteUpdater* u) {
+    addRoute(u, "10.0.0.0", 24, {"1.1.1.10"});
+    addRoute(u, "20.0.0.0", 24, {"10.0.0.1"});
+    addRoute(u, "30.0.0.0", 24, {"20.0.0.1"});
+  });
+  EXPECT_RESOLVED(getRoute(v4Routes_, "30.0.0.0/24"));
+
+  // Re-pointing the head of the chain must propagate all the way down
+  update([this](RouteUpdater* u) {
+    addRoute(u, "10.0.0.0", 24, {"2.2.2.10"});
+  });
+  RouteNextHopSet expFwd;
+  expFwd.emplace(
+      ResolvedNextHop(IPAddress("2.2.2.10"), InterfaceID(2), ECMP_WEIGHT));
+  EXPECT_EQ(
+      expFwd,
+      getRoute(v4Routes_, "30.0.0.0/24")->getForwardInfo().getNextHopSet());
+
+  // Removing the head of the chain makes the whole chain unresolvable
+  update([](RouteUpdater* u) {
+    u->delRoute(IPAddress("10.0.0.0"), 24, kClientA);
+  });
+  EXPECT_FALSE(getRoute(v4Routes_, "30.0.0.0/24")->isResolved());
+  EXPECT_TRUE(getRoute(v4Routes_, "30.0.0.0/24")->isUnresolvable());
+
+  // ...and adding it back makes it resolvable again
+  update([this](RouteUpdater* u) {
+    addRoute(u, "10.0.0.0", 24, {"3.3.3.10"});
+  });
+  EXPECT_RESOLVED(getRoute(v4Routes_, "30.0.0.0/24"));
+}
+
+TEST_F(IncrementalResolveTest, moreSpecificRouteTakesOverNextHop) {
+  update([this](RouteUpdater* u) {
+    addRoute(u, "10.0.0.0", 8, {"1.1.1.10"});
+    addRoute(u, "20.0.0.0", 24, {"10.1.1.1"});
+    addRoute(u, "30.0.0.0", 24, {"10.2.2.2"});
+  });
+
+  // 10.1.1.1 now resolves through the /24 while 10.2.2.2 stays on the /8
+  update([this](RouteUpdater* u) {
+    addRoute(u, "10.1.1.0", 24, {"4.4.4.10"});
+  });
+  update([](RouteUpdater* u) {
+    u->delRoute(IPAddress("10.1.1.0"), 24, kClientA);
+  });
+  update([](RouteUpdater* u) {
+    u->delRoute(IPAddress("10.0.0.0"), 8, kClientA);
+  });
+}
+
+TEST_F(IncrementalResolveTest, loopBrokenByUpdate) {
+  update([this](RouteUpdater* u) {
+    addRoute(u, "30.0.0.0", 8, {"20.1.1.1"});
+    addRoute(u, "20.0.0.0", 8, {"10.1.1.1"});
+    addRoute(u, "10.0.0.0", 8, {"30.1.1.1"});
+  });
+  EXPECT_TRUE(getRoute(v4Routes_, "10.0.0.0/8")->isUnresolvable());
+
+  update([this](RouteUpdater* u) {
+    addRoute(u, "10.0.0.0", 8, {"1.1.1.10"});
+  });
+  EXPECT_RESOLVED(getRoute(v4Routes_, "30.0.0.0/8"));
+}
+
+TEST_F(IncrementalResolveTest, interfaceRouteChange) {
+  update([this](RouteUpdater* u) {
+    addRoute(u, "50.0.0.0", 16, {"1.1.1.10", "2.2.2.10"});
+    addRoute(u, "2001::", 64, {"1::10"});
+    addRoute(u, "60.0.0.0", 16, {"50.0.0.1"});
+  });
+
+  update([](RouteUpdater* u) {
+    u->removeAllRoutesForClient(ClientID::INTERFACE_ROUTE);
+    u->addInterfaceRoute(
+        folly::IPAddress("1.1.1.1"),
+        24,
+        folly::IPAddress("1.1.1.1"),
+        InterfaceID(5));
+    u->addInterfaceRoute(
+        folly::IPAddress("1::1"), 48, folly::IPAddress("1::1"), InterfaceID(5));
+  });
+  EXPECT_RESOLVED(getRoute(v4Routes_, "60.0.0.0/16"));
+  EXPECT_RESOLVED(getRoute(v6Routes_, "2001::/64"));
+}
+
+TEST_F(IncrementalResolveTest, unrelatedUpdateLeavesIndexUntouched) {
+  update([this](RouteUpdater* u) {
+    addRoute(u, "70.0.0.0", 24, {"1.1.1.10"});
+    addRoute(u, "80.0.0.0", 24, {"2.2.2.10"});
+  });
+  auto numDependents = nextHopDependencies_.numDependents();
+
+  update([this](RouteUpdater* u) {
+    addRoute(u, "90.0.0.0", 24, {"3.3.3.10"});
+  });
+  EXPECT_EQ(numDependents + 1, nextHopDependencies_.numDependents());
+
+  update([](RouteUpdater* u) {
+    u->delRoute(IPAddress("90.0.0.0"), 24, kClientA);
+  });
+  EXPECT_EQ(numDependents, nextHopDependencies_.numDependents());
+}
+
 } // namespace facebook::fboss::rib
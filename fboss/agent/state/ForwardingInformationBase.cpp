@@ -29,33 +29,31 @@ ForwardingInformationBase<AddressT>::exactMatch(
 template <typename AddressT>
 std::shared_ptr<Route<AddressT>>
 ForwardingInformationBase<AddressT>::longestMatch(
-    const AddressT& address) const {
-  std::shared_ptr<Route<AddressT>> longestMatchRoute = nullptr;
-  // longestCommonLength must be wider than int8_t because it needs to hold
-  // values in the range [-1, 128].
-  int16_t longestCommonLength = -1;
-
-  uint8_t currentCommonLength;
-  for (const auto& prefixAndRoute : Base::getAllNodes()) {
-    const auto& currentNetwork = prefixAndRoute.first.network;
-    const auto currentMask = prefixAndRoute.first.mask;
-
-    if (!address.inSubnet(currentNetwork, currentMask)) {
-      continue;
-    }
-
-    auto currentCommonPrefixAndLength = folly::IPAddress::longestCommonPrefix(
-        {address, address.bitCount()},
-        {prefixAndRoute.first.network, prefixAndRoute.first.mask});
-
-    currentCommonLength = currentCommonPrefixAndLength.second;
-    if (currentCommonLength > longestCommonLength) {
-      longestCommonLength = currentCommonLength;
-      longestMatchRoute = prefixAndRoute.second;
+    const AddressT& address,
+    uint8_t maxMask) const {
+  // Routes are ordered by mask first, then by network, so the routes of each
+  // prefix length form a contiguous run of the tree. Starting from the
+  // longest mask, look up the one route of that length which could contain
+  // address, then skip straight to the run of the next shorter mask. This
+  // costs O(log n) per distinct prefix length rather than O(n).
+  const auto& routes = Base::getAllNodes();
+  auto it = routes.end();
+  if (maxMask < AddressT::bitCount()) {
+    // First route longer than maxMask
+    uint8_t nextMask = maxMask + 1;
+    it = routes.lower_bound(RoutePrefix<AddressT>{AddressT(), nextMask});
+  }
+  while (it != routes.begin()) {
+    --it;
+    auto mask = it->first.mask;
+    auto match = routes.find(RoutePrefix<AddressT>{address.mask(mask), mask});
+    if (match != routes.end()) {
+      return match->second;
     }
+    // First route with this mask
+    it = routes.lower_bound(RoutePrefix<AddressT>{AddressT(), mask});
   }
-
-  return longestMatchRoute;
+  return nullptr;
 }
 
 FBOSS_INSTANTIATE_NODE_MAP(
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "fboss/agent/state/NodeMap.h"
+#include "fboss/agent/state/PersistentMap.h"
 #include "fboss/agent/state/Route.h"
 #include "fboss/agent/state/RouteTypes.h"
 
@@ -18,9 +19,14 @@
 
 namespace facebook::fboss {
 
+// The FIB can hold hundreds of thousands of routes and is cloned on every
+// route update, so it is stored in a PersistentMap.
 template <typename AddressT>
-using ForwardingInformationBaseTraits =
-    NodeMapTraits<RoutePrefix<AddressT>, Route<AddressT>>;
+using ForwardingInformationBaseTraits = NodeMapTraits<
+    RoutePrefix<AddressT>,
+    Route<AddressT>,
+    NodeMapNoExtraFields,
+    PersistentMap<RoutePrefix<AddressT>, std::shared_ptr<Route<AddressT>>>>;
 
 template <typename AddressT>
 class ForwardingInformationBase
@@ -38,7 +44,13 @@ class ForwardingInformationBase
   std::shared_ptr<Route<AddressT>> exactMatch(
       const RoutePrefix<AddressT>& prefix) const;
 
-  std::shared_ptr<Route<AddressT>> longestMatch(const AddressT& address) const;
+  /*
+   * Returns the longest route containing address. Routes longer than maxMask
+   * are skipped, so that the best route for a whole prefix can be looked up.
+   */
+  std::shared_ptr<Route<AddressT>> longestMatch(
+      const AddressT& address,
+      uint8_t maxMask = AddressT::bitCount()) const;
 
  private:
   // Inherit the constructors required for clone()
@@ -60,22 +60,22 @@ template <typename MapTypeT, typename TraitsT>
 void NodeMapT<MapTypeT, TraitsT>::updateNode(
     const std::shared_ptr<Node>& node) {
   auto& nodes = writableNodes();
-  auto it = nodes.find(TraitsT::getKey(node));
-  if (it == nodes.end()) {
-    throw FbossError("node ID ", TraitsT::getKey(node), " does not exist");
+  auto key = TraitsT::getKey(node);
+  if (nodes.find(key) == nodes.end()) {
+    throw FbossError("node ID ", key, " does not exist");
   }
-  it->second = node;
+  // Not assigning through the iterator, since not every NodeContainer
+  // provides mutable iterators.
+  nodes.insert_or_assign(key, node);
 }
 
 template <typename MapTypeT, typename TraitsT>
 void NodeMapT<MapTypeT, TraitsT>::removeNode(
     const std::shared_ptr<Node>& node) {
   auto& nodes = writableNodes();
-  auto it = nodes.find(TraitsT::getKey(node));
-  if (it == nodes.end()) {
+  if (nodes.erase(TraitsT::getKey(node)) == 0) {
     throw FbossError("node ID ", TraitsT::getKey(node), " does not exist");
   }
-  nodes.erase(it);
 }
 
 template <typename MapTypeT, typename TraitsT>
@@ -97,7 +97,7 @@ NodeMapT<MapTypeT, TraitsT>::removeNodeIf(const KeyType& key) {
     return nullptr;
   }
   std::shared_ptr<Node> node = it->second;
-  nodes.erase(it);
+  nodes.erase(key);
   return node;
 }
 
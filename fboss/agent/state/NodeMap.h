@@ -14,8 +14,28 @@
 #include "fboss/agent/state/NodeBase.h"
 #include "fboss/agent/state/NodeMapIterator.h"
 
+#include <type_traits>
+
 namespace facebook::fboss {
 
+/*
+ * NodeMaps store their nodes in a flat_map by default. Traits can pick a
+ * different container (e.g. PersistentMap) by defining a NodeContainer type.
+ */
+template <typename TraitsT, typename = void>
+struct NodeMapContainer {
+  using type = boost::container::flat_map<
+      typename TraitsT::KeyType,
+      std::shared_ptr<typename TraitsT::Node>>;
+};
+
+template <typename TraitsT>
+struct NodeMapContainer<
+    TraitsT,
+    std::void_t<typename TraitsT::NodeContainer>> {
+  using type = typename TraitsT::NodeContainer;
+};
+
 /*
  * NodeMapFields defines the fields contained inside a NodeMapT instantiation
  */
@@ -24,8 +44,7 @@ struct NodeMapFields {
   using KeyType = typename TraitsT::KeyType;
   using Node = typename TraitsT::Node;
   using ExtraFields = typename TraitsT::ExtraFields;
-  using NodeContainer =
-      boost::container::flat_map<KeyType, std::shared_ptr<Node>>;
+  using NodeContainer = typename NodeMapContainer<TraitsT>::type;
 
   NodeMapFields() {}
   NodeMapFields(NodeContainer nodes) : nodes(std::move(nodes)) {}
@@ -57,11 +76,17 @@ struct NodeMapNoExtraFields {
   }
 };
 
-template <typename KeyT, typename NodeT, typename ExtraT = NodeMapNoExtraFields>
+template <
+    typename KeyT,
+    typename NodeT,
+    typename ExtraT = NodeMapNoExtraFields,
+    typename NodeContainerT =
+        boost::container::flat_map<KeyT, std::shared_ptr<NodeT>>>
 struct NodeMapTraits {
   using KeyType = KeyT;
   using Node = NodeT;
   using ExtraFields = ExtraT;
+  using NodeContainer = NodeContainerT;
 
   static KeyType getKey(const std::shared_ptr<Node>& node) {
     return node->getID();
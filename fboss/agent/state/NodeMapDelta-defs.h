@@ -38,6 +38,19 @@ NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::Iterator(
   updateValue();
 }
 
+template <typename MAP, typename VALUE, typename MAPPOINTERTRAITS>
+NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::Iterator(
+    const MapType* oldMap,
+    const MapType* newMap)
+    : oldMap_(oldMap), newMap_(newMap), value_(nullNode_, nullNode_) {
+  if constexpr (ContainerDiff::kSupported) {
+    diffIt_ = MapType::NodeContainer::diffBegin(
+        oldMap ? &oldMap->getAllNodes() : nullptr,
+        newMap ? &newMap->getAllNodes() : nullptr);
+    updateValue();
+  }
+}
+
 template <typename MAP, typename VALUE, typename MAPPOINTERTRAITS>
 NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::Iterator()
     : oldIt_(),
@@ -48,6 +61,14 @@ NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::Iterator()
 
 template <typename MAP, typename VALUE, typename MAPPOINTERTRAITS>
 void NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::updateValue() {
+  if constexpr (ContainerDiff::kSupported) {
+    const auto* oldEntry = diffIt_.getOld();
+    const auto* newEntry = diffIt_.getNew();
+    value_.reset(
+        oldEntry ? oldEntry->second : nullNode_,
+        newEntry ? newEntry->second : nullNode_);
+    return;
+  }
   if (oldIt_ == oldMap_->end()) {
     if (newIt_ == newMap_->end()) {
       value_.reset(nullNode_, nullNode_);
@@ -73,6 +94,13 @@ void NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::updateValue() {
 
 template <typename MAP, typename VALUE, typename MAPPOINTERTRAITS>
 void NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::advance() {
+  if constexpr (ContainerDiff::kSupported) {
+    // advance() shouldn't be called if we are already at the end
+    CHECK(diffIt_.getOld() || diffIt_.getNew());
+    ++diffIt_;
+    updateValue();
+    return;
+  }
   // If we have already hit the end of one side, advance the other.
   // We are immediately done after this.
   if (oldIt_ == oldMap_->end()) {
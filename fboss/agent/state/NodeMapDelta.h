@@ -49,12 +49,37 @@ class MapUniquePointerTraits {
     return map.get();
   }
 };
+namespace detail {
+/*
+ * Containers which can enumerate their differences with another instance
+ * more efficiently than by walking both (e.g. PersistentMap, which skips the
+ * subtrees both maps share) provide a DiffIterator.
+ */
+template <typename Container, typename = void>
+struct NodeContainerDiff {
+  static constexpr bool kSupported = false;
+  struct DiffIterator {};
+};
+
+template <typename Container>
+struct NodeContainerDiff<
+    Container,
+    std::void_t<typename Container::DiffIterator>> {
+  static constexpr bool kSupported = true;
+  using DiffIterator = typename Container::DiffIterator;
+};
+} // namespace detail
+
 /*
  * NodeMapDelta contains code for examining the differences between two NodeMap
  * objects.
  *
  * The main function of this class is the Iterator that it provides.  This
  * allows caller to walk over the changed, added, and removed nodes.
+ *
+ * If the NodeMap's container supports it, only the parts of the two maps that
+ * are not shared are visited, so that the cost of walking the delta is
+ * proportional to the number of changes rather than to the size of the maps.
  */
 template <
     typename MAP,
@@ -100,6 +125,8 @@ class NodeMapDelta {
    */
   MapPointerType old_;
   MapPointerType new_;
+
+  using ContainerDiff = detail::NodeContainerDiff<typename MAP::NodeContainer>;
 };
 
 template <typename NODE>
@@ -156,6 +183,8 @@ class NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator {
       typename MapType::Iterator oldIt,
       const MapType* newMap,
       typename MapType::Iterator newIt);
+  // Iterator over the differences between two maps, or end() if both are null
+  Iterator(const MapType* oldMap, const MapType* newMap);
   Iterator();
 
   const value_type& operator*() const {
@@ -176,7 +205,11 @@ class NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator {
   }
 
   bool operator==(const Iterator& other) const {
-    return oldIt_ == other.oldIt_ && newIt_ == other.newIt_;
+    if constexpr (ContainerDiff::kSupported) {
+      return diffIt_ == other.diffIt_;
+    } else {
+      return oldIt_ == other.oldIt_ && newIt_ == other.newIt_;
+    }
   }
   bool operator!=(const Iterator& other) const {
     return !operator==(other);
@@ -189,10 +222,12 @@ class NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator {
   void advance();
   void updateValue();
 
-  InnerIter oldIt_{nullptr};
-  InnerIter newIt_{nullptr};
+  InnerIter oldIt_;
+  InnerIter newIt_;
   const MapType* oldMap_{nullptr};
   const MapType* newMap_{nullptr};
+  // Only used if the container supports diffing
+  typename ContainerDiff::DiffIterator diffIt_;
   VALUE value_;
 
   static std::shared_ptr<Node> nullNode_;
@@ -204,6 +239,9 @@ NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::begin() const {
   if (old_ == new_) {
     return end();
   }
+  if constexpr (ContainerDiff::kSupported) {
+    return Iterator(getOld(), getNew());
+  }
   // To support deltas where the old node is null (to represent newly created
   // nodes), point the old side of the iterator at the new node, but start it
   // at the end of the map.
@@ -220,6 +258,9 @@ NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::begin() const {
 template <typename MAP, typename VALUE, typename MAPPOINTERTRAITS>
 typename NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator
 NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::end() const {
+  if constexpr (ContainerDiff::kSupported) {
+    return Iterator();
+  }
   if (!old_) {
     return Iterator(getNew(), new_->end(), getNew(), new_->end());
   }
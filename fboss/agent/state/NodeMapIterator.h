@@ -12,7 +12,8 @@
 #include <boost/container/flat_map.hpp>
 
 /*
- * NodeMapIterator is a very small wrapper around flat_map::const_iterator.
+ * NodeMapIterator is a very small wrapper around NodeContainer::const_iterator
+ * (a flat_map or PersistentMap const_iterator).
  *
  * The main difference is that dereferencing it returns only the Node,
  * and not a pair of (_Id, _Node)
@@ -58,7 +59,7 @@ class NodeMapIterator
 
 /*
  * ReverseNodeMapIterator is a very small wrapper around
- * flat_map::const_reverse_iterator.
+ * NodeContainer::const_reverse_iterator.
  *
  * The main difference is that dereferencing it returns only the Node,
  * and not a pair of (_Id, _Node)
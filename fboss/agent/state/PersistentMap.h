@@ -0,0 +1,693 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/small_vector.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace facebook::fboss {
+
+/*
+ * PersistentMap is an ordered map implemented as an AVL tree whose tree nodes
+ * are shared between copies of the map.
+ *
+ * Copying a PersistentMap is O(1): only the root pointer is copied. Modifying
+ * a copy copies the tree nodes on the path from the root to the modified
+ * entry (path copying), and leaves every other subtree shared with the
+ * original map. Tree nodes that are not shared with any other map are
+ * modified in place, so a sequence of updates to the same clone only pays for
+ * path copying once per tree node.
+ *
+ * This makes PersistentMap a good NodeContainer for large NodeMaps which are
+ * cloned for every state update, such as the FIB. The interface mirrors the
+ * subset of boost::container::flat_map used by NodeMapT, with the exception
+ * that entries can only be modified through the map itself (iterators are
+ * always const).
+ *
+ * Modifying a map is not thread safe, but modifying one copy while other
+ * copies are being read concurrently is.
+ */
+template <
+    typename KeyT,
+    typename MappedT,
+    typename CompareT = std::less<KeyT>>
+class PersistentMap {
+  struct TreeNode;
+  using TreeNodePtr = std::shared_ptr<TreeNode>;
+
+ public:
+  using key_type = KeyT;
+  using mapped_type = MappedT;
+  using value_type = std::pair<KeyT, MappedT>;
+  using size_type = std::size_t;
+  using key_compare = CompareT;
+  class const_iterator;
+  class DiffIterator;
+  using iterator = const_iterator;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using reverse_iterator = const_reverse_iterator;
+
+  PersistentMap() {}
+
+  size_type size() const {
+    return size_;
+  }
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  const_iterator begin() const {
+    const_iterator it(root_.get());
+    it.descendLeft(root_.get());
+    return it;
+  }
+  const_iterator end() const {
+    return const_iterator(root_.get());
+  }
+  const_iterator cbegin() const {
+    return begin();
+  }
+  const_iterator cend() const {
+    return end();
+  }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  const_iterator find(const KeyT& key) const;
+  const_iterator lower_bound(const KeyT& key) const;
+  size_type count(const KeyT& key) const {
+    return findNode(key) ? 1 : 0;
+  }
+
+  std::pair<iterator, bool> insert(value_type value);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+  // The hint is ignored, inserting is always O(log n)
+  template <typename... Args>
+  iterator emplace_hint(const_iterator /*hint*/, Args&&... args) {
+    return emplace(std::forward<Args>(args)...).first;
+  }
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const KeyT& key, M&& mapped);
+
+  size_type erase(const KeyT& key);
+  iterator erase(const_iterator pos);
+  void clear() {
+    root_.reset();
+    size_ = 0;
+  }
+
+  /*
+   * Returns an iterator over the entries that differ between oldMap and
+   * newMap. Either map may be null, which is treated as an empty map.
+   */
+  static DiffIterator diffBegin(
+      const PersistentMap* oldMap,
+      const PersistentMap* newMap) {
+    return DiffIterator(oldMap, newMap);
+  }
+  static DiffIterator diffEnd() {
+    return DiffIterator();
+  }
+
+  /*
+   * Returns true if both maps share the same tree, in which case they are
+   * guaranteed to hold the same entries.
+   */
+  bool sharesStructureWith(const PersistentMap& other) const {
+    return root_ == other.root_;
+  }
+
+ private:
+  // Enough for ~8M entries before iterators have to allocate
+  static constexpr size_t kInlinePathLength = 32;
+
+  struct TreeNode {
+    explicit TreeNode(value_type v) : value(std::move(v)) {}
+
+    value_type value;
+    TreeNodePtr left;
+    TreeNodePtr right;
+    uint8_t height{1};
+  };
+
+  const TreeNode* findNode(const KeyT& key) const;
+
+  static TreeNode* makeWritable(TreeNodePtr* node);
+  static uint8_t height(const TreeNodePtr& node) {
+    return node ? node->height : 0;
+  }
+  static void updateHeight(TreeNode* node) {
+    node->height = 1 + std::max(height(node->left), height(node->right));
+  }
+  static void rotateLeft(TreeNodePtr* slot);
+  static void rotateRight(TreeNodePtr* slot);
+  static void rebalance(TreeNodePtr* slot);
+
+  void insertImpl(TreeNodePtr* slot, value_type&& value);
+  void eraseImpl(TreeNodePtr* slot, const KeyT& key);
+  static value_type popMin(TreeNodePtr* slot);
+
+  bool less(const KeyT& lhs, const KeyT& rhs) const {
+    return compare_(lhs, rhs);
+  }
+
+  TreeNodePtr root_;
+  size_type size_{0};
+  CompareT compare_;
+};
+
+/*
+ * A bidirectional iterator over a PersistentMap.
+ *
+ * Tree nodes do not point to their parents, since they can have several, so
+ * the iterator keeps the path from the root to the current entry. An empty
+ * path denotes end().
+ */
+template <typename KeyT, typename MappedT, typename CompareT>
+class PersistentMap<KeyT, MappedT, CompareT>::const_iterator {
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = typename PersistentMap::value_type;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const value_type*;
+  using reference = const value_type&;
+
+  const_iterator() {}
+
+  reference operator*() const {
+    return path_.back()->value;
+  }
+  pointer operator->() const {
+    return &path_.back()->value;
+  }
+
+  const_iterator& operator++() {
+    increment();
+    return *this;
+  }
+  const_iterator operator++(int) {
+    const_iterator tmp(*this);
+    increment();
+    return tmp;
+  }
+  const_iterator& operator--() {
+    decrement();
+    return *this;
+  }
+  const_iterator operator--(int) {
+    const_iterator tmp(*this);
+    decrement();
+    return tmp;
+  }
+
+  bool operator==(const const_iterator& other) const {
+    return current() == other.current();
+  }
+  bool operator!=(const const_iterator& other) const {
+    return !operator==(other);
+  }
+
+ private:
+  friend class PersistentMap;
+
+  explicit const_iterator(const TreeNode* root) : root_(root) {}
+
+  const TreeNode* current() const {
+    return path_.empty() ? nullptr : path_.back();
+  }
+
+  void descendLeft(const TreeNode* node) {
+    for (; node; node = node->left.get()) {
+      path_.push_back(node);
+    }
+  }
+  void descendRight(const TreeNode* node) {
+    for (; node; node = node->right.get()) {
+      path_.push_back(node);
+    }
+  }
+
+  void increment() {
+    const TreeNode* node = path_.back();
+    if (node->right) {
+      descendLeft(node->right.get());
+      return;
+    }
+    // Climb until we leave a left subtree
+    path_.pop_back();
+    while (!path_.empty() && path_.back()->right.get() == node) {
+      node = path_.back();
+      path_.pop_back();
+    }
+  }
+
+  void decrement() {
+    if (path_.empty()) {
+      descendRight(root_);
+      return;
+    }
+    const TreeNode* node = path_.back();
+    if (node->left) {
+      descendRight(node->left.get());
+      return;
+    }
+    // Climb until we leave a right subtree
+    path_.pop_back();
+    while (!path_.empty() && path_.back()->left.get() == node) {
+      node = path_.back();
+      path_.pop_back();
+    }
+  }
+
+  const TreeNode* root_{nullptr};
+  folly::small_vector<const TreeNode*, PersistentMap::kInlinePathLength> path_;
+};
+
+/*
+ * DiffIterator walks, in key order, over the entries that were added, removed
+ * or whose mapped value changed (as per operator==) between two maps.
+ *
+ * Both maps are walked in lockstep, but as a frontier of not yet visited
+ * subtrees rather than entry by entry. Whenever both frontiers start with the
+ * same tree node, that whole subtree is shared by the two maps and is skipped
+ * without being visited. For maps derived from one another through path
+ * copying, walking the difference is therefore O(d log n) for d changed
+ * entries, rather than O(n).
+ */
+template <typename KeyT, typename MappedT, typename CompareT>
+class PersistentMap<KeyT, MappedT, CompareT>::DiffIterator {
+ public:
+  DiffIterator() {}
+  DiffIterator(const PersistentMap* oldMap, const PersistentMap* newMap) {
+    if (oldMap) {
+      old_.pushSubtree(oldMap->root_.get());
+    }
+    if (newMap) {
+      new_.pushSubtree(newMap->root_.get());
+    }
+    findNextDifference();
+  }
+
+  /*
+   * The old and new entries for the current difference. Exactly one of them
+   * is null for removed and added entries.
+   */
+  const value_type* getOld() const {
+    return oldEntry_;
+  }
+  const value_type* getNew() const {
+    return newEntry_;
+  }
+
+  DiffIterator& operator++() {
+    if (oldEntry_) {
+      old_.pop();
+    }
+    if (newEntry_) {
+      new_.pop();
+    }
+    findNextDifference();
+    return *this;
+  }
+
+  bool operator==(const DiffIterator& other) const {
+    return oldEntry_ == other.oldEntry_ && newEntry_ == other.newEntry_;
+  }
+  bool operator!=(const DiffIterator& other) const {
+    return !operator==(other);
+  }
+
+ private:
+  /*
+   * The entries of a map not yet visited, in key order, as a stack of
+   * subtrees and single entries (a tree node whose subtrees were already
+   * pushed separately).
+   */
+  class Frontier {
+   public:
+    bool empty() const {
+      return items_.empty();
+    }
+    const TreeNode* top() const {
+      return items_.back().node;
+    }
+    bool topIsEntry() const {
+      return items_.back().entryOnly;
+    }
+    void pop() {
+      items_.pop_back();
+    }
+    void pushSubtree(const TreeNode* node) {
+      if (node) {
+        items_.push_back(Item{node, false});
+      }
+    }
+    // Replace the subtree on top by its left subtree, root and right subtree
+    void expandTop() {
+      const TreeNode* node = top();
+      items_.pop_back();
+      pushSubtree(node->right.get());
+      items_.push_back(Item{node, true});
+      pushSubtree(node->left.get());
+    }
+    // Expand subtrees until the smallest remaining entry is on top
+    void expandToEntry() {
+      while (!topIsEntry()) {
+        expandTop();
+      }
+    }
+    const KeyT& minKey() const {
+      const TreeNode* node = top();
+      if (!topIsEntry()) {
+        while (node->left) {
+          node = node->left.get();
+        }
+      }
+      return node->value.first;
+    }
+
+   private:
+    struct Item {
+      const TreeNode* node;
+      bool entryOnly;
+    };
+    // A frontier holds at most two items per level of the tree
+    folly::small_vector<Item, 2 * PersistentMap::kInlinePathLength> items_;
+  };
+
+  void findNextDifference();
+
+  Frontier old_;
+  Frontier new_;
+  const value_type* oldEntry_{nullptr};
+  const value_type* newEntry_{nullptr};
+  CompareT compare_;
+};
+
+template <typename KeyT, typename MappedT, typename CompareT>
+void PersistentMap<KeyT, MappedT, CompareT>::DiffIterator::
+    findNextDifference() {
+  oldEntry_ = nullptr;
+  newEntry_ = nullptr;
+  while (!old_.empty() && !new_.empty()) {
+    if (old_.top() == new_.top() && old_.topIsEntry() == new_.topIsEntry()) {
+      // Shared by both maps
+      old_.pop();
+      new_.pop();
+      continue;
+    }
+    if (old_.topIsEntry() && new_.topIsEntry()) {
+      const auto& oldValue = old_.top()->value;
+      const auto& newValue = new_.top()->value;
+      if (compare_(oldValue.first, newValue.first)) {
+        oldEntry_ = &oldValue;
+      } else if (compare_(newValue.first, oldValue.first)) {
+        newEntry_ = &newValue;
+      } else if (oldValue.second == newValue.second) {
+        old_.pop();
+        new_.pop();
+        continue;
+      } else {
+        oldEntry_ = &oldValue;
+        newEntry_ = &newValue;
+      }
+      return;
+    }
+    if (old_.topIsEntry() || new_.topIsEntry()) {
+      // An entry before every key of the subtree on the other side differs
+      // without the subtree having to be expanded.
+      bool oldIsEntry = old_.topIsEntry();
+      auto& entrySide = oldIsEntry ? old_ : new_;
+      auto& subtreeSide = oldIsEntry ? new_ : old_;
+      if (compare_(entrySide.top()->value.first, subtreeSide.minKey())) {
+        (oldIsEntry ? oldEntry_ : newEntry_) = &entrySide.top()->value;
+        return;
+      }
+      subtreeSide.expandTop();
+      continue;
+    }
+    // Two different subtrees: expand the taller one, which is the more likely
+    // to contain the other one (or parts of it) further down.
+    auto oldHeight = old_.top()->height;
+    auto newHeight = new_.top()->height;
+    if (oldHeight >= newHeight) {
+      old_.expandTop();
+    }
+    if (newHeight >= oldHeight) {
+      new_.expandTop();
+    }
+  }
+  if (!old_.empty()) {
+    old_.expandToEntry();
+    oldEntry_ = &old_.top()->value;
+  } else if (!new_.empty()) {
+    new_.expandToEntry();
+    newEntry_ = &new_.top()->value;
+  }
+}
+
+template <typename KeyT, typename MappedT, typename CompareT>
+const typename PersistentMap<KeyT, MappedT, CompareT>::TreeNode*
+PersistentMap<KeyT, MappedT, CompareT>::findNode(const KeyT& key) const {
+  const TreeNode* node = root_.get();
+  while (node) {
+    if (less(key, node->value.first)) {
+      node = node->left.get();
+    } else if (less(node->value.first, key)) {
+      node = node->right.get();
+    } else {
+      return node;
+    }
+  }
+  return nullptr;
+}
+
+template <typename KeyT, typename MappedT, typename CompareT>
+typename PersistentMap<KeyT, MappedT, CompareT>::const_iterator
+PersistentMap<KeyT, MappedT, CompareT>::find(const KeyT& key) const {
+  const_iterator it(root_.get());
+  const TreeNode* node = root_.get();
+  while (node) {
+    it.path_.push_back(node);
+    if (less(key, node->value.first)) {
+      node = node->left.get();
+    } else if (less(node->value.first, key)) {
+      node = node->right.get();
+    } else {
+      return it;
+    }
+  }
+  return end();
+}
+
+template <typename KeyT, typename MappedT, typename CompareT>
+typename PersistentMap<KeyT, MappedT, CompareT>::const_iterator
+PersistentMap<KeyT, MappedT, CompareT>::lower_bound(const KeyT& key) const {
+  const_iterator it(root_.get());
+  // Length of the path to the smallest entry not less than key seen so far
+  size_t lowerBoundLength = 0;
+  const TreeNode* node = root_.get();
+  while (node) {
+    it.path_.push_back(node);
+    if (less(node->value.first, key)) {
+      node = node->right.get();
+    } else {
+      lowerBoundLength = it.path_.size();
+      node = node->left.get();
+    }
+  }
+  it.path_.resize(lowerBoundLength);
+  return it;
+}
+
+template <typename KeyT, typename MappedT, typename CompareT>
+std::pair<
+    typename PersistentMap<KeyT, MappedT, CompareT>::iterator,
+    bool>
+PersistentMap<KeyT, MappedT, CompareT>::insert(value_type value) {
+  auto it = find(value.first);
+  if (it != end()) {
+    return std::make_pair(it, false);
+  }
+  KeyT key = value.first;
+  insertImpl(&root_, std::move(value));
+  ++size_;
+  return std::make_pair(find(key), true);
+}
+
+template <typename KeyT, typename MappedT, typename CompareT>
+template <typename M>
+std::pair<
+    typename PersistentMap<KeyT, MappedT, CompareT>::iterator,
+    bool>
+PersistentMap<KeyT, MappedT, CompareT>::insert_or_assign(
+    const KeyT& key,
+    M&& mapped) {
+  bool inserted = !findNode(key);
+  insertImpl(&root_, value_type(key, std::forward<M>(mapped)));
+  if (inserted) {
+    ++size_;
+  }
+  return std::make_pair(find(key), inserted);
+}
+
+template <typename KeyT, typename MappedT, typename CompareT>
+typename PersistentMap<KeyT, MappedT, CompareT>::size_type
+PersistentMap<KeyT, MappedT, CompareT>::erase(const KeyT& key) {
+  // Avoid copying the path to an entry which does not exist
+  if (!findNode(key)) {
+    return 0;
+  }
+  eraseImpl(&root_, key);
+  --size_;
+  return 1;
+}
+
+template <typename KeyT, typename MappedT, typename CompareT>
+typename PersistentMap<KeyT, MappedT, CompareT>::iterator
+PersistentMap<KeyT, MappedT, CompareT>::erase(const_iterator pos) {
+  // Erasing rebalances the tree and invalidates every iterator, so look up
+  // the successor again afterwards.
+  KeyT key = pos->first;
+  eraseImpl(&root_, key);
+  --size_;
+  return lower_bound(key);
+}
+
+template <typename KeyT, typename MappedT, typename CompareT>
+typename PersistentMap<KeyT, MappedT, CompareT>::TreeNode*
+PersistentMap<KeyT, MappedT, CompareT>::makeWritable(TreeNodePtr* node) {
+  // A tree node referenced only by the map being modified cannot be reached
+  // from any other map, so it is safe to modify it in place.
+  if (node->use_count() > 1) {
+    *node = std::make_shared<TreeNode>(**node);
+  }
+  return node->get();
+}
+
+template <typename KeyT, typename MappedT, typename CompareT>
+void PersistentMap<KeyT, MappedT, CompareT>::rotateLeft(TreeNodePtr* slot) {
+  TreeNode* node = slot->get();
+  TreeNodePtr pivot = std::move(node->right);
+  makeWritable(&pivot);
+  node->right = std::move(pivot->left);
+  updateHeight(node);
+  pivot->left = std::move(*slot);
+  updateHeight(pivot.get());
+  *slot = std::move(pivot);
+}
+
+template <typename KeyT, typename MappedT, typename CompareT>
+void PersistentMap<KeyT, MappedT, CompareT>::rotateRight(TreeNodePtr* slot) {
+  TreeNode* node = slot->get();
+  TreeNodePtr pivot = std::move(node->left);
+  makeWritable(&pivot);
+  node->left = std::move(pivot->right);
+  updateHeight(node);
+  pivot->right = std::move(*slot);
+  updateHeight(pivot.get());
+  *slot = std::move(pivot);
+}
+
+/*
+ * Restores the AVL invariant at *slot, which must already be writable, after
+ * the height of one of its subtrees changed by at most one.
+ */
+template <typename KeyT, typename MappedT, typename CompareT>
+void PersistentMap<KeyT, MappedT, CompareT>::rebalance(TreeNodePtr* slot) {
+  TreeNode* node = slot->get();
+  updateHeight(node);
+  int balance = static_cast<int>(height(node->left)) - height(node->right);
+  if (balance > 1) {
+    if (height(node->left->left) < height(node->left->right)) {
+      makeWritable(&node->left);
+      rotateLeft(&node->left);
+    }
+    rotateRight(slot);
+  } else if (balance < -1) {
+    if (height(node->right->right) < height(node->right->left)) {
+      makeWritable(&node->right);
+      rotateRight(&node->right);
+    }
+    rotateLeft(slot);
+  }
+}
+
+template <typename KeyT, typename MappedT, typename CompareT>
+void PersistentMap<KeyT, MappedT, CompareT>::insertImpl(
+    TreeNodePtr* slot,
+    value_type&& value) {
+  if (!*slot) {
+    *slot = std::make_shared<TreeNode>(std::move(value));
+    return;
+  }
+  TreeNode* node = makeWritable(slot);
+  if (less(value.first, node->value.first)) {
+    insertImpl(&node->left, std::move(value));
+  } else if (less(node->value.first, value.first)) {
+    insertImpl(&node->right, std::move(value));
+  } else {
+    node->value.second = std::move(value.second);
+    return;
+  }
+  rebalance(slot);
+}
+
+template <typename KeyT, typename MappedT, typename CompareT>
+void PersistentMap<KeyT, MappedT, CompareT>::eraseImpl(
+    TreeNodePtr* slot,
+    const KeyT& key) {
+  TreeNode* node = makeWritable(slot);
+  if (less(key, node->value.first)) {
+    eraseImpl(&node->left, key);
+  } else if (less(node->value.first, key)) {
+    eraseImpl(&node->right, key);
+  } else if (!node->left || !node->right) {
+    // Releasing *slot destroys node, so detach the child first
+    TreeNodePtr child = node->left ? std::move(node->left)
+                                   : std::move(node->right);
+    *slot = std::move(child);
+    return;
+  } else {
+    node->value = popMin(&node->right);
+  }
+  rebalance(slot);
+}
+
+template <typename KeyT, typename MappedT, typename CompareT>
+typename PersistentMap<KeyT, MappedT, CompareT>::value_type
+PersistentMap<KeyT, MappedT, CompareT>::popMin(TreeNodePtr* slot) {
+  TreeNode* node = makeWritable(slot);
+  if (!node->left) {
+    value_type value = std::move(node->value);
+    TreeNodePtr right = std::move(node->right);
+    *slot = std::move(right);
+    return value;
+  }
+  value_type value = popMin(&node->left);
+  rebalance(slot);
+  return value;
+}
+
+} // namespace facebook::fboss
@@ -178,8 +178,11 @@ class RouteTableRib : public NodeBase {
     return radixTree_;
   }
 
-  std::shared_ptr<Route<AddrT>> longestMatch(const AddrT& nexthop) const {
-    auto citr = radixTree_.longestMatch(nexthop, nexthop.bitCount());
+  // Routes longer than maxMask are skipped
+  std::shared_ptr<Route<AddrT>> longestMatch(
+      const AddrT& nexthop,
+      uint8_t maxMask = AddrT::bitCount()) const {
+    auto citr = radixTree_.longestMatch(nexthop, maxMask);
     return citr != radixTree_.end() ? citr->value() : nullptr;
   }
 
@@ -18,6 +18,7 @@
 #include <gtest/gtest.h>
 #include <array>
 #include <memory>
+#include <random>
 
 namespace {
 
@@ -189,6 +190,41 @@ TEST_F(ForwardingInformationBaseV6Test, DecreasingLPMSequence) {
   }
 }
 
+TEST_F(ForwardingInformationBaseV4Test, LPMMatchesLinearScan) {
+  // Many prefixes of every length, most of which do not contain the
+  // addresses looked up
+  std::mt19937 gen(0);
+  for (int i = 0; i < 2000; ++i) {
+    uint8_t mask = gen() % 33;
+    auto address = folly::IPAddressV4::fromLongHBO(gen()).mask(mask);
+    if (!fib.getNodeIf({address, mask})) {
+      fib.addNode(createRouteFromPrefix(address, mask));
+    }
+  }
+
+  for (int i = 0; i < 2000; ++i) {
+    auto address = folly::IPAddressV4::fromLongHBO(gen());
+    uint8_t maxMask = gen() % 33;
+    std::shared_ptr<facebook::fboss::Route<folly::IPAddressV4>> expected;
+    std::shared_ptr<facebook::fboss::Route<folly::IPAddressV4>> expectedBounded;
+    for (const auto& prefixAndRoute : fib.getAllNodes()) {
+      const auto& prefix = prefixAndRoute.first;
+      if (!address.inSubnet(prefix.network, prefix.mask)) {
+        continue;
+      }
+      if (!expected || prefix.mask > expected->prefix().mask) {
+        expected = prefixAndRoute.second;
+      }
+      if (prefix.mask <= maxMask &&
+          (!expectedBounded || prefix.mask > expectedBounded->prefix().mask)) {
+        expectedBounded = prefixAndRoute.second;
+      }
+    }
+    EXPECT_EQ(expected, fib.longestMatch(address));
+    EXPECT_EQ(expectedBounded, fib.longestMatch(address, maxMask));
+  }
+}
+
 TEST(ForwardingInformationBaseV4, IPv4DefaultPrefixComparesSmallest) {
   ForwardingInformationBaseV4 oldFib;
   ForwardingInformationBaseV4 newFib;
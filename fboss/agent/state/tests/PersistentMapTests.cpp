@@ -0,0 +1,306 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/state/PersistentMap.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+using facebook::fboss::PersistentMap;
+
+namespace {
+
+using TestMap = PersistentMap<int, std::string>;
+
+template <typename MapT>
+std::vector<std::pair<int, std::string>> toVector(const MapT& map) {
+  return std::vector<std::pair<int, std::string>>(map.begin(), map.end());
+}
+
+void EXPECT_SAME_ENTRIES(
+    const std::map<int, std::string>& expected,
+    const TestMap& actual) {
+  EXPECT_EQ(expected.size(), actual.size());
+  EXPECT_EQ(toVector(expected), toVector(actual));
+
+  // Also walk both backwards
+  std::vector<std::pair<int, std::string>> expectedReversed(
+      expected.rbegin(), expected.rend());
+  std::vector<std::pair<int, std::string>> actualReversed(
+      actual.rbegin(), actual.rend());
+  EXPECT_EQ(expectedReversed, actualReversed);
+}
+
+} // namespace
+
+TEST(PersistentMap, Empty) {
+  TestMap map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(0, map.size());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(map.rbegin(), map.rend());
+  EXPECT_EQ(map.end(), map.find(1));
+  EXPECT_EQ(map.end(), map.lower_bound(1));
+  EXPECT_EQ(0, map.erase(1));
+}
+
+TEST(PersistentMap, InsertFindErase) {
+  TestMap map;
+  EXPECT_TRUE(map.insert(std::make_pair(2, "two")).second);
+  EXPECT_TRUE(map.emplace(1, "one").second);
+  map.emplace_hint(map.cend(), 3, "three");
+
+  auto ret = map.insert(std::make_pair(2, "deux"));
+  EXPECT_FALSE(ret.second);
+  EXPECT_EQ("two", ret.first->second);
+
+  ret = map.insert_or_assign(2, "deux");
+  EXPECT_FALSE(ret.second);
+  EXPECT_EQ("deux", ret.first->second);
+  EXPECT_EQ(3, map.size());
+
+  EXPECT_EQ(1, map.count(3));
+  EXPECT_EQ(0, map.count(4));
+  EXPECT_EQ(3, map.lower_bound(3)->first);
+  EXPECT_EQ(1, map.lower_bound(-5)->first);
+  EXPECT_EQ(map.end(), map.lower_bound(4));
+
+  auto it = map.erase(map.find(2));
+  EXPECT_EQ(3, it->first);
+  EXPECT_EQ(1, map.erase(1));
+  EXPECT_EQ(0, map.erase(1));
+  EXPECT_SAME_ENTRIES({{3, "three"}}, map);
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(PersistentMap, IteratorIncrementAndDecrement) {
+  TestMap map;
+  for (int i = 0; i < 100; ++i) {
+    map.emplace(i * 2, std::to_string(i));
+  }
+  auto it = map.find(50);
+  ASSERT_NE(map.end(), it);
+  EXPECT_EQ(52, (++it)->first);
+  EXPECT_EQ(50, (--it)->first);
+  EXPECT_EQ(48, (--it)->first);
+
+  auto last = map.end();
+  --last;
+  EXPECT_EQ(198, last->first);
+  EXPECT_EQ(map.end(), ++last);
+}
+
+TEST(PersistentMap, MatchesStdMap) {
+  std::mt19937 generator(1337);
+  std::uniform_int_distribution<int> keys(0, 500);
+  std::uniform_int_distribution<int> operations(0, 2);
+
+  std::map<int, std::string> expected;
+  TestMap map;
+  for (int i = 0; i < 5000; ++i) {
+    auto key = keys(generator);
+    switch (operations(generator)) {
+      case 0:
+        EXPECT_EQ(
+            expected.emplace(key, std::to_string(i)).second,
+            map.emplace(key, std::to_string(i)).second);
+        break;
+      case 1:
+        expected[key] = std::to_string(i);
+        map.insert_or_assign(key, std::to_string(i));
+        break;
+      case 2:
+        EXPECT_EQ(expected.erase(key), map.erase(key));
+        break;
+    }
+    if (i % 500 == 0) {
+      EXPECT_SAME_ENTRIES(expected, map);
+    }
+  }
+  EXPECT_SAME_ENTRIES(expected, map);
+}
+
+TEST(PersistentMap, CopiesAreIndependent) {
+  std::map<int, std::string> expected;
+  TestMap original;
+  for (int i = 0; i < 1000; ++i) {
+    expected.emplace(i, std::to_string(i));
+    original.emplace(i, std::to_string(i));
+  }
+
+  TestMap copy(original);
+  EXPECT_TRUE(copy.sharesStructureWith(original));
+
+  std::map<int, std::string> expectedCopy(expected);
+  for (int i = 0; i < 1000; i += 3) {
+    expectedCopy.erase(i);
+    copy.erase(i);
+  }
+  for (int i = 1000; i < 1100; ++i) {
+    expectedCopy.emplace(i, std::to_string(i));
+    copy.emplace(i, std::to_string(i));
+  }
+  expectedCopy[1] = "uno";
+  copy.insert_or_assign(1, "uno");
+
+  EXPECT_FALSE(copy.sharesStructureWith(original));
+  EXPECT_SAME_ENTRIES(expected, original);
+  EXPECT_SAME_ENTRIES(expectedCopy, copy);
+
+  // Modifying the original must not leak into the copy either
+  original.clear();
+  EXPECT_SAME_ENTRIES(expectedCopy, copy);
+}
+
+TEST(PersistentMap, CopySharesUnmodifiedEntries) {
+  PersistentMap<int, std::shared_ptr<int>> original;
+  for (int i = 0; i < 1000; ++i) {
+    original.emplace(i, std::make_shared<int>(i));
+  }
+
+  auto copy = original;
+  copy.insert_or_assign(500, std::make_shared<int>(-1));
+
+  // Only the tree nodes on the path to the modified entry were copied, every
+  // other entry is still held by a single tree node shared by both maps.
+  int copiedEntries = 0;
+  auto origIt = original.begin();
+  auto copyIt = copy.begin();
+  for (; origIt != original.end(); ++origIt, ++copyIt) {
+    ASSERT_EQ(origIt->first, copyIt->first);
+    if (origIt->first == 500) {
+      EXPECT_NE(origIt->second, copyIt->second);
+      continue;
+    }
+    EXPECT_EQ(origIt->second, copyIt->second);
+    if (origIt->second.use_count() > 1) {
+      ++copiedEntries;
+    }
+  }
+  EXPECT_GT(copiedEntries, 0);
+  EXPECT_LT(copiedEntries, 20);
+}
+
+namespace {
+
+using Diff = std::vector<std::pair<std::optional<int>, std::optional<int>>>;
+
+// Returns (old key, new key) for every entry that differs between the maps
+Diff diff(const TestMap* oldMap, const TestMap* newMap) {
+  Diff result;
+  for (auto it = TestMap::diffBegin(oldMap, newMap); it != TestMap::diffEnd();
+       ++it) {
+    std::optional<int> oldKey;
+    std::optional<int> newKey;
+    if (it.getOld()) {
+      oldKey = it.getOld()->first;
+    }
+    if (it.getNew()) {
+      newKey = it.getNew()->first;
+    }
+    result.emplace_back(oldKey, newKey);
+  }
+  return result;
+}
+
+Diff expectedDiff(
+    const std::map<int, std::string>& oldMap,
+    const std::map<int, std::string>& newMap) {
+  Diff result;
+  auto oldIt = oldMap.begin();
+  auto newIt = newMap.begin();
+  while (oldIt != oldMap.end() || newIt != newMap.end()) {
+    if (newIt == newMap.end() ||
+        (oldIt != oldMap.end() && oldIt->first < newIt->first)) {
+      result.emplace_back(oldIt->first, std::nullopt);
+      ++oldIt;
+    } else if (
+        oldIt == oldMap.end() || newIt->first < oldIt->first) {
+      result.emplace_back(std::nullopt, newIt->first);
+      ++newIt;
+    } else {
+      if (oldIt->second != newIt->second) {
+        result.emplace_back(oldIt->first, newIt->first);
+      }
+      ++oldIt;
+      ++newIt;
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+TEST(PersistentMap, DiffOfCopies) {
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int> keys(0, 4000);
+  std::uniform_int_distribution<int> operations(0, 2);
+
+  std::map<int, std::string> expected;
+  TestMap map;
+  for (int i = 0; i < 2000; ++i) {
+    auto key = keys(generator);
+    expected.emplace(key, "0");
+    map.emplace(key, "0");
+  }
+
+  for (int numChanges : {0, 1, 10, 100, 1000}) {
+    auto expectedCopy = expected;
+    auto copy = map;
+    for (int i = 0; i < numChanges; ++i) {
+      auto key = keys(generator);
+      switch (operations(generator)) {
+        case 0:
+          expectedCopy.emplace(key, "1");
+          copy.emplace(key, "1");
+          break;
+        case 1:
+          expectedCopy[key] = std::to_string(i);
+          copy.insert_or_assign(key, std::to_string(i));
+          break;
+        case 2:
+          expectedCopy.erase(key);
+          copy.erase(key);
+          break;
+      }
+    }
+    EXPECT_EQ(expectedDiff(expected, expectedCopy), diff(&map, &copy));
+    EXPECT_EQ(expectedDiff(expectedCopy, expected), diff(&copy, &map));
+  }
+}
+
+TEST(PersistentMap, DiffOfUnrelatedMaps) {
+  std::map<int, std::string> expectedA;
+  std::map<int, std::string> expectedB;
+  TestMap a;
+  TestMap b;
+  for (int i = 0; i < 300; ++i) {
+    if (i % 2 == 0) {
+      expectedA.emplace(i, "a");
+      a.emplace(i, "a");
+    }
+    if (i % 3 == 0) {
+      expectedB.emplace(i, i % 4 == 0 ? "a" : "b");
+      b.emplace(i, i % 4 == 0 ? "a" : "b");
+    }
+  }
+  EXPECT_EQ(expectedDiff(expectedA, expectedB), diff(&a, &b));
+  EXPECT_EQ(expectedDiff(expectedA, {}), diff(&a, nullptr));
+  EXPECT_EQ(expectedDiff({}, expectedB), diff(nullptr, &b));
+  EXPECT_TRUE(diff(&a, &a).empty());
+  EXPECT_TRUE(diff(nullptr, nullptr).empty());
+}
@@ -0,0 +1,141 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "common/init/Init.h"
+#include "fboss/agent/state/ForwardingInformationBase.h"
+#include "fboss/agent/state/Route.h"
+#include "fboss/agent/state/RouteNextHopEntry.h"
+
+#include <folly/Benchmark.h>
+#include <folly/IPAddressV4.h>
+#include <folly/IPAddressV6.h>
+
+#include <random>
+#include <vector>
+
+/*
+ * Lookups/sec of ForwardingInformationBase::longestMatch() on a FIB shaped
+ * like an internet table (mostly /24s or /48s, plus covering aggregates),
+ * compared to scanning every route as longestMatch() used to.
+ */
+
+using namespace facebook::fboss;
+
+namespace {
+
+constexpr uint32_t kFibSize = 200000;
+constexpr uint32_t kNumLookups = 1000;
+
+template <typename AddressT>
+std::shared_ptr<Route<AddressT>> makeRoute(
+    const AddressT& network,
+    uint8_t mask) {
+  RoutePrefix<AddressT> prefix{network.mask(mask), mask};
+  RouteNextHopEntry entry(
+      RouteNextHopEntry::Action::DROP, AdminDistance::EBGP);
+  auto route = std::make_shared<Route<AddressT>>(prefix, ClientID(0), entry);
+  route->setResolved(std::move(entry));
+  return route;
+}
+
+folly::IPAddressV4 randomAddress(std::mt19937& gen, folly::IPAddressV4*) {
+  return folly::IPAddressV4::fromLongHBO(gen());
+}
+
+folly::IPAddressV6 randomAddress(std::mt19937& gen, folly::IPAddressV6*) {
+  folly::IPAddressV6::ByteArray16 bytes;
+  // Keep to 2000::/4 so that lookups mostly hit some route
+  bytes[0] = 0x20 | (gen() % 16);
+  for (size_t i = 1; i < bytes.size(); ++i) {
+    bytes[i] = gen();
+  }
+  return folly::IPAddressV6(bytes);
+}
+
+template <typename AddressT>
+std::shared_ptr<ForwardingInformationBase<AddressT>> makeFib(
+    std::mt19937& gen) {
+  auto fib = std::make_shared<ForwardingInformationBase<AddressT>>();
+  auto hostMask = AddressT::bitCount();
+  uint8_t commonMask = hostMask == 32 ? 24 : 48;
+  for (uint32_t i = 0; i < kFibSize; ++i) {
+    uint8_t mask = commonMask;
+    if (i % 8 == 0) {
+      // Aggregates and more specifics
+      mask = 8 + gen() % (hostMask - 7);
+    }
+    auto address = randomAddress(gen, static_cast<AddressT*>(nullptr));
+    auto route = makeRoute(address, mask);
+    if (!fib->getNodeIf(route->prefix())) {
+      fib->addNode(route);
+    }
+  }
+  fib->publish();
+  return fib;
+}
+
+template <typename AddressT>
+std::shared_ptr<Route<AddressT>> linearScanLongestMatch(
+    const ForwardingInformationBase<AddressT>& fib,
+    const AddressT& address) {
+  std::shared_ptr<Route<AddressT>> longestMatchRoute;
+  int16_t longestMask = -1;
+  for (const auto& prefixAndRoute : fib.getAllNodes()) {
+    const auto& prefix = prefixAndRoute.first;
+    if (prefix.mask > longestMask &&
+        address.inSubnet(prefix.network, prefix.mask)) {
+      longestMask = prefix.mask;
+      longestMatchRoute = prefixAndRoute.second;
+    }
+  }
+  return longestMatchRoute;
+}
+
+template <typename AddressT>
+void runLookupBenchmark(size_t iters, bool linearScan) {
+  folly::BenchmarkSuspender suspender;
+  std::mt19937 gen(0);
+  auto fib = makeFib<AddressT>(gen);
+  std::vector<AddressT> addresses;
+  for (uint32_t i = 0; i < kNumLookups; ++i) {
+    addresses.push_back(randomAddress(gen, static_cast<AddressT*>(nullptr)));
+  }
+  suspender.dismiss();
+
+  for (size_t i = 0; i < iters; ++i) {
+    const auto& address = addresses[i % addresses.size()];
+    auto route = linearScan ? linearScanLongestMatch(*fib, address)
+                            : fib->longestMatch(address);
+    folly::doNotOptimizeAway(route);
+  }
+}
+
+} // namespace
+
+BENCHMARK(LinearScanV4, iters) {
+  runLookupBenchmark<folly::IPAddressV4>(iters, true);
+}
+BENCHMARK_RELATIVE(LongestMatchV4, iters) {
+  runLookupBenchmark<folly::IPAddressV4>(iters, false);
+}
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(LinearScanV6, iters) {
+  runLookupBenchmark<folly::IPAddressV6>(iters, true);
+}
+BENCHMARK_RELATIVE(LongestMatchV6, iters) {
+  runLookupBenchmark<folly::IPAddressV6>(iters, false);
+}
+
+int main(int argc, char** argv) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,115 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <folly/Benchmark.h>
+#include <folly/MacAddress.h>
+#include "fboss/agent/L2Entry.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/hw/sim/SimPlatform.h"
+#include "fboss/agent/hw/sim/SimSwitch.h"
+#include "fboss/agent/state/MacTable.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/state/Vlan.h"
+#include "fboss/agent/state/VlanMap.h"
+
+using namespace facebook::fboss;
+using folly::MacAddress;
+using std::make_shared;
+using std::make_unique;
+using std::shared_ptr;
+using std::unique_ptr;
+
+namespace {
+
+// Global state used by the benchmarks
+unique_ptr<SwSwitch> sw;
+
+unique_ptr<SwSwitch> setupSwitch() {
+  MacAddress localMac("02:00:01:00:00:01");
+  auto sw = make_unique<SwSwitch>(make_unique<SimPlatform>(localMac, 10));
+  sw->init(nullptr /* No custom TunManager */);
+
+  auto updateFn = [&](const shared_ptr<SwitchState>& oldState) {
+    auto state = oldState->clone();
+
+    // Add VLAN 1, and ports 1-9 which belong to it.
+    auto vlan1 = make_shared<Vlan>(VlanID(1), "Vlan1");
+    state->addVlan(vlan1);
+    for (int idx = 1; idx < 10; ++idx) {
+      vlan1->addPort(PortID(idx), false);
+    }
+    return state;
+  };
+
+  sw->updateStateBlocking("setup", updateFn);
+  return sw;
+}
+
+MacAddress macAddress(size_t index) {
+  return MacAddress::fromHBO(0x020000000000 + index);
+}
+
+void waitForMacTableUpdates() {
+  // Blocking updates are queued behind the MAC table updates, so once this
+  // returns all learn/age events sent so far have been applied.
+  sw->updateStateBlocking(
+      "wait for MAC table updates",
+      [](const shared_ptr<SwitchState>& /* state */) { return nullptr; });
+}
+
+void sendL2Updates(size_t numIters, L2EntryUpdateType updateType) {
+  for (size_t n = 0; n < numIters; ++n) {
+    // Spread the MACs over the VLAN ports, as on a host facing flap
+    L2Entry l2Entry(
+        macAddress(n),
+        VlanID(1),
+        PortDescriptor(PortID(n % 9 + 1)),
+        L2Entry::L2EntryType::L2_ENTRY_TYPE_PENDING);
+    sw->l2LearningUpdateReceived(l2Entry, updateType);
+  }
+  waitForMacTableUpdates();
+}
+
+} // unnamed namespace
+
+BENCHMARK(MacLearn, numIters) {
+  sendL2Updates(numIters, L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD);
+
+  BENCHMARK_SUSPEND {
+    auto macTable =
+        sw->getState()->getVlans()->getVlan(VlanID(1))->getMacTable();
+    CHECK_GE(macTable->size(), numIters);
+  }
+}
+
+BENCHMARK(MacAge, numIters) {
+  BENCHMARK_SUSPEND {
+    sendL2Updates(numIters, L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD);
+  }
+
+  sendL2Updates(numIters, L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_DELETE);
+
+  BENCHMARK_SUSPEND {
+    auto macTable =
+        sw->getState()->getVlans()->getVlan(VlanID(1))->getMacTable();
+    CHECK(!macTable->getNodeIf(macAddress(0)));
+  }
+}
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  // Setting up the switch is fairly expensive.  Do this once before we run the
+  // benchmark functions so we don't have to do it inside the benchmark
+  // functions.
+  sw = setupSwitch();
+
+  folly::runBenchmarks();
+  return 0;
+}
@@ -77,6 +77,28 @@ class MacTableManagerTest : public ::testing::Test {
     });
   }
 
+  L2Entry makeL2Entry(folly::MacAddress mac) const {
+    return L2Entry(
+        mac,
+        kVlan(),
+        PortDescriptor(kPortID()),
+        L2Entry::L2EntryType::L2_ENTRY_TYPE_PENDING);
+  }
+
+  void triggerMacLearnedBurst(int numMacs) {
+    for (int i = 0; i < numMacs; ++i) {
+      sw_->l2LearningUpdateReceived(
+          makeL2Entry(kMacAddress(i)),
+          L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD);
+    }
+    waitForBackgroundThread(sw_);
+    waitForStateUpdates(sw_);
+  }
+
+  folly::MacAddress kMacAddress(int index) const {
+    return MacAddress::fromHBO(0x020000000000 + index);
+  }
+
   void verifyMacIsDeleted() {
     verifyStateUpdate([=]() {
       auto vlan = sw_->getState()->getVlans()->getVlan(kVlan());
@@ -98,13 +120,8 @@ class MacTableManagerTest : public ::testing::Test {
   }
 
   void triggerMacCbHelper(L2EntryUpdateType l2EntryUpdateType) {
-    auto l2Entry = L2Entry(
-        kMacAddress(),
-        kVlan(),
-        PortDescriptor(kPortID()),
-        L2Entry::L2EntryType::L2_ENTRY_TYPE_PENDING);
-
-    sw_->l2LearningUpdateReceived(l2Entry, l2EntryUpdateType);
+    sw_->l2LearningUpdateReceived(
+        makeL2Entry(kMacAddress()), l2EntryUpdateType);
 
     waitForBackgroundThread(sw_);
     waitForStateUpdates(sw_);
@@ -142,4 +159,30 @@ TEST_F(MacTableManagerTest, SameMacAgedCbTwice) {
   verifyMacIsDeleted();
 }
 
+TEST_F(MacTableManagerTest, MacLearnedBurst) {
+  constexpr auto kNumMacs = 100;
+  triggerMacLearnedBurst(kNumMacs);
+
+  verifyStateUpdate([=]() {
+    auto vlan = sw_->getState()->getVlans()->getVlan(kVlan());
+    auto* macTable = vlan->getMacTable().get();
+    EXPECT_EQ(kNumMacs, static_cast<int>(macTable->size()));
+    for (int i = 0; i < kNumMacs; ++i) {
+      EXPECT_NE(nullptr, macTable->getNodeIf(kMacAddress(i)));
+    }
+  });
+}
+
+TEST_F(MacTableManagerTest, MacLearnedAndAgedBackToBack) {
+  sw_->l2LearningUpdateReceived(
+      makeL2Entry(kMacAddress()), L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD);
+  sw_->l2LearningUpdateReceived(
+      makeL2Entry(kMacAddress()),
+      L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_DELETE);
+  waitForBackgroundThread(sw_);
+  waitForStateUpdates(sw_);
+
+  verifyMacIsDeleted();
+}
+
 } // namespace facebook::fboss
@@ -682,6 +682,91 @@ TYPED_TEST(MirrorManagerTest, UpdateMirrorOnRouteAdd) {
   });
 }
 
+TYPED_TEST(MirrorManagerTest, UpdateMirrorOnlyOnDestinationRouteChange) {
+  const auto params = MirrorManagerTestParams<TypeParam>::getParams();
+  const RoutePrefix<TypeParam> unrelatedPrefix{
+      TypeParam(
+          std::is_same_v<TypeParam, IPAddressV4> ? "20.20.0.0"
+                                                 : "2401:db00:2110:20::"),
+      static_cast<uint8_t>(TypeParam::bitCount() / 2)};
+
+  this->updateState(
+      "UpdateMirrorOnlyOnDestinationRouteChange: addMirror",
+      [=](const std::shared_ptr<SwitchState>& state) {
+        auto updatedState =
+            this->addErspanMirror(state, kMirrorName, params.mirrorDestination);
+        for (auto i = 0; i < 2; ++i) {
+          updatedState = this->addNeighbor(
+              updatedState,
+              params.interfaces[i],
+              params.neighborIPs[i],
+              params.neighborMACs[i],
+              params.neighborPorts[i]);
+        }
+        RouteNextHopSet nextHops = {params.nextHop(0)};
+        return this->addRoute(updatedState, params.longerPrefix, nextHops);
+      });
+
+  std::shared_ptr<Mirror> resolvedMirror;
+  this->verifyStateUpdate([&]() {
+    resolvedMirror =
+        this->sw_->getState()->getMirrors()->getMirrorIf(kMirrorName);
+    ASSERT_NE(resolvedMirror, nullptr);
+    EXPECT_TRUE(resolvedMirror->isResolved());
+  });
+
+  // Interface changes do not trigger mirror resolution, so the mirror keeps
+  // the old source MAC until it is resolved again
+  this->updateState(
+      "UpdateMirrorOnlyOnDestinationRouteChange: changeInterfaceMac",
+      [=](const std::shared_ptr<SwitchState>& state) {
+        auto updatedState = state->clone();
+        auto interface =
+            state->getInterfaces()->getInterface(params.interfaces[0])->clone();
+        interface->setMac(MacAddress("02:00:00:00:00:99"));
+        auto interfaces = state->getInterfaces()->clone();
+        interfaces->updateNode(interface);
+        updatedState->resetIntfs(interfaces);
+        return updatedState;
+      });
+
+  // A route which does not contain the mirror destination
+  this->updateState(
+      "UpdateMirrorOnlyOnDestinationRouteChange: addUnrelatedRoute",
+      [=](const std::shared_ptr<SwitchState>& state) {
+        RouteNextHopSet nextHops = {params.nextHop(1)};
+        return this->addRoute(state, unrelatedPrefix, nextHops);
+      });
+
+  this->verifyStateUpdate([&]() {
+    auto mirror = this->sw_->getState()->getMirrors()->getMirrorIf(kMirrorName);
+    EXPECT_EQ(mirror, resolvedMirror);
+  });
+
+  // The route to the mirror destination now goes through the other neighbor
+  this->updateState(
+      "UpdateMirrorOnlyOnDestinationRouteChange: changeDestinationRoute",
+      [=](const std::shared_ptr<SwitchState>& state) {
+        RouteNextHopSet nextHops = {params.nextHop(1)};
+        return this->addRoute(state, params.longerPrefix, nextHops);
+      });
+
+  this->verifyStateUpdate([=]() {
+    auto state = this->sw_->getState();
+    auto mirror = state->getMirrors()->getMirrorIf(kMirrorName);
+    ASSERT_NE(mirror, nullptr);
+    EXPECT_TRUE(mirror->isResolved());
+    ASSERT_TRUE(mirror->getEgressPort().has_value());
+    EXPECT_EQ(mirror->getEgressPort().value(), params.neighborPorts[1]);
+    ASSERT_TRUE(mirror->getMirrorTunnel().has_value());
+    auto tunnel = mirror->getMirrorTunnel().value();
+    EXPECT_EQ(tunnel.dstMac, params.neighborMACs[1]);
+    const auto& interface1 =
+        state->getInterfaces()->getInterfaceIf(params.interfaces[1]);
+    EXPECT_EQ(tunnel.srcMac, interface1->getMac());
+  });
+}
+
 TYPED_TEST(MirrorManagerTest, UpdateNoMirrorWithEgressPortOnRouteDel) {
   const auto params = MirrorManagerTestParams<TypeParam>::getParams();
 
@@ -0,0 +1,121 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <folly/Benchmark.h>
+#include <folly/IPAddressV4.h>
+#include <folly/MacAddress.h>
+#include "fboss/agent/ArpHandler.h"
+#include "fboss/agent/NeighborUpdater.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/hw/sim/SimPlatform.h"
+#include "fboss/agent/state/ArpTable.h"
+#include "fboss/agent/state/Interface.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/state/Vlan.h"
+#include "fboss/agent/state/VlanMap.h"
+
+using namespace facebook::fboss;
+using folly::IPAddress;
+using folly::IPAddressV4;
+using folly::MacAddress;
+using std::make_shared;
+using std::make_unique;
+using std::shared_ptr;
+using std::unique_ptr;
+
+namespace {
+
+constexpr uint32_t kNumNeighbors = 10000;
+
+// Global state used by the benchmarks
+unique_ptr<SwSwitch> sw;
+
+unique_ptr<SwSwitch> setupSwitch() {
+  MacAddress localMac("02:00:01:00:00:01");
+  auto sw = make_unique<SwSwitch>(make_unique<SimPlatform>(localMac, 10));
+  sw->init(nullptr /* No custom TunManager */);
+
+  auto updateFn = [&](const shared_ptr<SwitchState>& oldState) {
+    auto state = oldState->clone();
+
+    // Add VLAN 1, and ports 1-9 which belong to it.
+    auto vlan1 = make_shared<Vlan>(VlanID(1), "Vlan1");
+    state->addVlan(vlan1);
+    for (int idx = 1; idx < 10; ++idx) {
+      vlan1->addPort(PortID(idx), false);
+    }
+    // Add Interface 1 to VLAN 1, with a subnet large enough to hold all the
+    // neighbors
+    auto intf1 = make_shared<Interface>(
+        InterfaceID(1),
+        RouterID(0),
+        VlanID(1),
+        "interface1",
+        MacAddress("02:00:01:00:00:01"),
+        9000,
+        false, /* is virtual */
+        false /* is state_sync disabled*/);
+    Interface::Addresses addrs1;
+    addrs1.emplace(IPAddress("10.0.0.1"), 16);
+    intf1->setAddresses(addrs1);
+    state->addIntf(intf1);
+    return state;
+  };
+
+  sw->updateStateBlocking("setup", updateFn);
+  return sw;
+}
+
+void waitForNeighborUpdates() {
+  sw->getNeighborUpdater()->waitForPendingUpdates();
+  // Blocking updates are queued behind the neighbor table updates, so once
+  // this returns all resolved neighbors have been programmed.
+  sw->updateStateBlocking(
+      "wait for neighbor updates",
+      [](const shared_ptr<SwitchState>& /* state */) { return nullptr; });
+}
+
+} // unnamed namespace
+
+BENCHMARK(ResolveNeighbors10k) {
+  // Every run moves the neighbors to a new MAC, so that each of them needs
+  // to be reprogrammed.
+  static uint64_t run = 0;
+  auto baseMac = 0x020000000000 + (++run << 16);
+
+  // Resolve every neighbor as if an ARP reply from it had just come in, in
+  // the same way ArpHandler does.
+  for (uint32_t n = 0; n < kNumNeighbors; ++n) {
+    sw->getNeighborUpdater()->receivedArpMine(
+        VlanID(1),
+        IPAddressV4::fromLongHBO(IPAddressV4("10.0.1.0").toLongHBO() + n),
+        MacAddress::fromHBO(baseMac + n),
+        PortDescriptor(PortID(n % 9 + 1)),
+        ARP_OP_REPLY);
+  }
+  waitForNeighborUpdates();
+
+  BENCHMARK_SUSPEND {
+    auto arpTable =
+        sw->getState()->getVlans()->getVlan(VlanID(1))->getArpTable();
+    CHECK_EQ(arpTable->size(), kNumNeighbors);
+  }
+}
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  // Setting up the switch is fairly expensive.  Do this once before we run the
+  // benchmark functions so we don't have to do it inside the benchmark
+  // functions.
+  sw = setupSwitch();
+
+  folly::runBenchmarks();
+  return 0;
+}
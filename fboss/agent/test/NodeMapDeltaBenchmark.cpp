@@ -0,0 +1,97 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "common/init/Init.h"
+#include "fboss/agent/state/DeltaFunctions.h"
+#include "fboss/agent/state/ForwardingInformationBase.h"
+#include "fboss/agent/state/NodeMapDelta.h"
+#include "fboss/agent/state/Route.h"
+#include "fboss/agent/state/RouteNextHopEntry.h"
+
+#include <folly/Benchmark.h>
+#include <folly/IPAddressV4.h>
+#include <glog/logging.h>
+
+using namespace facebook::fboss;
+
+namespace {
+
+constexpr uint32_t kFibSize = 200000;
+
+std::shared_ptr<RouteV4> makeRoute(uint32_t index, AdminDistance distance) {
+  RoutePrefixV4 prefix{folly::IPAddressV4::fromLongHBO(index << 8), 24};
+  RouteNextHopEntry entry(RouteNextHopEntry::Action::DROP, distance);
+  auto route = std::make_shared<RouteV4>(prefix, ClientID(0), entry);
+  route->setResolved(std::move(entry));
+  return route;
+}
+
+/*
+ * Builds a FIB of kFibSize routes, and a clone of it in which numChanges
+ * routes (spread evenly over the FIB) were replaced.
+ */
+std::pair<
+    std::shared_ptr<ForwardingInformationBaseV4>,
+    std::shared_ptr<ForwardingInformationBaseV4>>
+makeFibs(uint32_t numChanges) {
+  auto oldFib = std::make_shared<ForwardingInformationBaseV4>();
+  for (uint32_t i = 0; i < kFibSize; ++i) {
+    oldFib->addNode(makeRoute(i, AdminDistance::EBGP));
+  }
+  oldFib->publish();
+
+  auto newFib = oldFib->clone();
+  auto stride = kFibSize / numChanges;
+  for (uint32_t i = 0; i < numChanges; ++i) {
+    newFib->updateNode(makeRoute(i * stride, AdminDistance::STATIC_ROUTE));
+  }
+  newFib->publish();
+  return std::make_pair(oldFib, newFib);
+}
+
+void runDeltaBenchmark(uint32_t numChanges) {
+  folly::BenchmarkSuspender suspender;
+  auto fibs = makeFibs(numChanges);
+  suspender.dismiss();
+
+  NodeMapDelta<ForwardingInformationBaseV4> delta(
+      fibs.first.get(), fibs.second.get());
+  uint32_t changed = 0;
+  DeltaFunctions::forEachChanged(
+      delta,
+      [&](const std::shared_ptr<RouteV4>& /* oldRoute */,
+          const std::shared_ptr<RouteV4>& /* newRoute */) { ++changed; },
+      [&](const std::shared_ptr<RouteV4>& /* added */) { ++changed; },
+      [&](const std::shared_ptr<RouteV4>& /* removed */) { ++changed; });
+  folly::doNotOptimizeAway(changed);
+
+  suspender.rehire();
+  CHECK_EQ(changed, numChanges);
+}
+
+} // namespace
+
+BENCHMARK(FibDelta200kRoutes1Change) {
+  runDeltaBenchmark(1);
+}
+
+BENCHMARK(FibDelta200kRoutes100Changes) {
+  runDeltaBenchmark(100);
+}
+
+BENCHMARK(FibDelta200kRoutes10kChanges) {
+  runDeltaBenchmark(10000);
+}
+
+int main(int argc, char** argv) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,248 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/PrefixWatcher.h"
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/state/ForwardingInformationBase.h"
+#include "fboss/agent/state/ForwardingInformationBaseContainer.h"
+#include "fboss/agent/state/ForwardingInformationBaseMap.h"
+#include "fboss/agent/state/RouteUpdater.h"
+#include "fboss/agent/state/StateDelta.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/HwTestHandle.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <folly/IPAddress.h>
+#include <gtest/gtest.h>
+
+#include <optional>
+
+using folly::CIDRNetwork;
+using folly::IPAddress;
+
+namespace facebook::fboss {
+
+namespace {
+const RouterID kVrf{0};
+const ClientID kClient{1000};
+const InterfaceID kInterface{1};
+
+template <typename AddrT>
+std::shared_ptr<ForwardingInformationBase<AddrT>> updateFib(
+    const std::shared_ptr<ForwardingInformationBase<AddrT>>& fib,
+    const RoutePrefix<AddrT>& prefix,
+    const std::optional<std::string>& nexthop) {
+  auto newFib = fib->clone();
+  newFib->removeNodeIf(prefix);
+  if (nexthop) {
+    auto route = std::make_shared<Route<AddrT>>(prefix);
+    route->setResolved(RouteNextHopEntry(
+        RouteNextHopEntry::NextHopSet{
+            ResolvedNextHop(IPAddress(*nexthop), kInterface, ECMP_WEIGHT)},
+        AdminDistance::STATIC_ROUTE));
+    newFib->addNode(route);
+  }
+  return newFib;
+}
+} // namespace
+
+/*
+ * Runs each test against the legacy route tables (false) and against the
+ * FIBs programmed from the standalone RIB (true).
+ */
+class PrefixWatcherTest : public ::testing::TestWithParam<bool> {
+ public:
+  void SetUp() override {
+    auto flags = GetParam() ? SwitchFlags::ENABLE_STANDALONE_RIB
+                            : SwitchFlags::DEFAULT;
+    handle_ = createTestHandle(testStateA(), std::nullopt, flags);
+    state_ = testStateA();
+    if (GetParam()) {
+      auto fibContainer =
+          std::make_shared<ForwardingInformationBaseContainer>(kVrf);
+      fibContainer->writableFields()->fibV4 =
+          std::make_shared<ForwardingInformationBaseV4>();
+      fibContainer->writableFields()->fibV6 =
+          std::make_shared<ForwardingInformationBaseV6>();
+      auto fibs = std::make_shared<ForwardingInformationBaseMap>();
+      fibs->addNode(fibContainer);
+      state_->resetForwardingInformationBases(fibs);
+    }
+    state_->publish();
+    watcher_ = std::make_unique<PrefixWatcher>(handle_->getSw());
+  }
+
+  /*
+   * Moves to newState and returns the watched prefixes which changed
+   */
+  std::vector<PrefixWatcher::WatchedPrefix> update(
+      const std::shared_ptr<SwitchState>& newState) {
+    StateDelta delta(state_, newState);
+    state_ = newState;
+    return watcher_->updateWatches(delta);
+  }
+
+  std::shared_ptr<SwitchState> addRoute(
+      const std::shared_ptr<SwitchState>& state,
+      const CIDRNetwork& prefix,
+      const std::string& nexthop) {
+    if (GetParam()) {
+      return setFibRoute(state, prefix, nexthop);
+    }
+    RouteUpdater updater(state->getRouteTables());
+    updater.addRoute(
+        kVrf,
+        prefix.first,
+        prefix.second,
+        kClient,
+        RouteNextHopEntry(
+            makeNextHops({nexthop}), AdminDistance::STATIC_ROUTE));
+    auto newState = state->clone();
+    newState->resetRouteTables(updater.updateDone());
+    newState->publish();
+    return newState;
+  }
+
+  std::shared_ptr<SwitchState> delRoute(
+      const std::shared_ptr<SwitchState>& state,
+      const CIDRNetwork& prefix) {
+    if (GetParam()) {
+      return setFibRoute(state, prefix, std::nullopt);
+    }
+    RouteUpdater updater(state->getRouteTables());
+    updater.delRoute(kVrf, prefix.first, prefix.second, kClient);
+    auto newState = state->clone();
+    newState->resetRouteTables(updater.updateDone());
+    newState->publish();
+    return newState;
+  }
+
+ protected:
+  std::unique_ptr<HwTestHandle> handle_;
+  std::shared_ptr<SwitchState> state_;
+  std::unique_ptr<PrefixWatcher> watcher_;
+
+ private:
+  /*
+   * Programs the route for prefix straight into the FIB, as the standalone
+   * RIB would, or removes it if nexthop is not set.
+   */
+  std::shared_ptr<SwitchState> setFibRoute(
+      const std::shared_ptr<SwitchState>& state,
+      const CIDRNetwork& prefix,
+      const std::optional<std::string>& nexthop) {
+    auto newState = state->clone();
+    auto fibContainer =
+        newState->getFibs()->getFibContainer(kVrf)->modify(&newState);
+    if (prefix.first.isV4()) {
+      fibContainer->writableFields()->fibV4 = updateFib(
+          fibContainer->getFibV4(),
+          RoutePrefixV4{prefix.first.asV4(), prefix.second},
+          nexthop);
+    } else {
+      fibContainer->writableFields()->fibV6 = updateFib(
+          fibContainer->getFibV6(),
+          RoutePrefixV6{prefix.first.asV6(), prefix.second},
+          nexthop);
+    }
+    newState->publish();
+    return newState;
+  }
+};
+
+TEST_P(PrefixWatcherTest, AddressBestRouteChanges) {
+  CIDRNetwork destination{IPAddress("10.0.10.101"), 32};
+  std::vector<PrefixWatcher::WatchedPrefix> expected{{kVrf, destination}};
+  watcher_->watch(kVrf, destination, state_);
+
+  // Routes not containing the address
+  EXPECT_TRUE(
+      update(addRoute(state_, {IPAddress("20.0.0.0"), 8}, "10.0.0.111"))
+          .empty());
+  EXPECT_TRUE(
+      update(addRoute(state_, {IPAddress("10.0.11.0"), 24}, "10.0.0.111"))
+          .empty());
+
+  EXPECT_EQ(
+      expected,
+      update(addRoute(state_, {IPAddress("10.0.0.0"), 16}, "10.0.0.111")));
+  EXPECT_EQ(
+      expected,
+      update(addRoute(state_, {IPAddress("10.0.10.100"), 31}, "10.0.55.111")));
+  // Shorter than the current best route
+  EXPECT_TRUE(
+      update(addRoute(state_, {IPAddress("10.0.10.0"), 24}, "10.0.0.111"))
+          .empty());
+  // New next hops for the best route
+  EXPECT_EQ(
+      expected,
+      update(addRoute(state_, {IPAddress("10.0.10.100"), 31}, "10.0.0.111")));
+  // Back to the /24
+  EXPECT_EQ(
+      expected, update(delRoute(state_, {IPAddress("10.0.10.100"), 31})));
+
+  watcher_->unwatch(kVrf, destination);
+  EXPECT_TRUE(update(delRoute(state_, {IPAddress("10.0.10.0"), 24})).empty());
+}
+
+TEST_P(PrefixWatcherTest, PrefixBestRouteChanges) {
+  CIDRNetwork prefix{IPAddress("10.0.10.0"), 24};
+  watcher_->watch(kVrf, prefix, state_);
+
+  // More specific than the watched prefix
+  EXPECT_TRUE(
+      update(addRoute(state_, {IPAddress("10.0.10.100"), 31}, "10.0.0.111"))
+          .empty());
+  std::vector<PrefixWatcher::WatchedPrefix> expected{{kVrf, prefix}};
+  EXPECT_EQ(
+      expected,
+      update(addRoute(state_, {IPAddress("10.0.0.0"), 16}, "10.0.0.111")));
+  EXPECT_EQ(
+      expected,
+      update(addRoute(state_, {IPAddress("10.0.10.0"), 24}, "10.0.0.111")));
+}
+
+TEST_P(PrefixWatcherTest, V6AddressBestRouteChanges) {
+  CIDRNetwork destination{IPAddress("2401:db00:2110:10::1001"), 128};
+  watcher_->watch(kVrf, destination, state_);
+
+  EXPECT_TRUE(update(addRoute(
+                         state_,
+                         {IPAddress("2401:db00:2110:11::"), 64},
+                         "2401:db00:2110:3001::111"))
+                  .empty());
+  std::vector<PrefixWatcher::WatchedPrefix> expected{{kVrf, destination}};
+  EXPECT_EQ(
+      expected,
+      update(addRoute(
+          state_,
+          {IPAddress("2401:db00:2110:10::"), 64},
+          "2401:db00:2110:3001::111")));
+}
+
+TEST_P(PrefixWatcherTest, WatchesAreRefCounted) {
+  CIDRNetwork destination{IPAddress("10.0.10.101"), 32};
+  watcher_->watch(kVrf, destination, state_);
+  watcher_->watch(kVrf, destination, state_);
+  EXPECT_EQ(1, watcher_->size());
+
+  watcher_->unwatch(kVrf, destination);
+  EXPECT_TRUE(watcher_->isWatched(kVrf, destination));
+  watcher_->unwatch(kVrf, destination);
+  EXPECT_FALSE(watcher_->isWatched(kVrf, destination));
+  EXPECT_EQ(0, watcher_->size());
+  EXPECT_THROW(watcher_->unwatch(kVrf, destination), FbossError);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    PrefixWatcherTest,
+    PrefixWatcherTest,
+    ::testing::Bool());
+
+} // namespace facebook::fboss
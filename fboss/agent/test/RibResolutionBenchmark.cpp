@@ -0,0 +1,185 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "common/init/Init.h"
+#include "fboss/agent/AddressUtil.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/hw/sim/SimPlatform.h"
+#include "fboss/agent/hw/test/ConfigFactory.h"
+#include "fboss/agent/rib/NetworkToRouteMap.h"
+#include "fboss/agent/rib/RoutingInformationBase.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/HwTestHandle.h"
+#include "fboss/agent/test/RouteScaleGenerators.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <folly/Benchmark.h>
+#include <folly/MacAddress.h>
+
+using namespace facebook::fboss;
+
+namespace {
+
+auto constexpr kEcmpWidth = 4;
+const RouterID kVrfZero{0};
+const ClientID kBgpClient{10};
+
+std::vector<UnicastRoute> toUnicastRoutes(
+    const utility::RouteDistributionGenerator::RouteChunk& chunk) {
+  std::vector<UnicastRoute> routes;
+  for (const auto& route : chunk) {
+    UnicastRoute unicastRoute;
+    IpPrefix prefix;
+    prefix.ip = facebook::network::toBinaryAddress(route.prefix.first);
+    prefix.prefixLength = route.prefix.second;
+    unicastRoute.dest_ref() = prefix;
+    for (const auto& nhop : route.nhops) {
+      NextHopThrift nexthop;
+      *nexthop.address_ref() = facebook::network::toBinaryAddress(nhop);
+      *nexthop.weight_ref() = static_cast<int32_t>(ECMP_WEIGHT);
+      unicastRoute.nextHops_ref()->push_back(std::move(nexthop));
+    }
+    routes.push_back(std::move(unicastRoute));
+  }
+  return routes;
+}
+
+void noopFibUpdate(
+    RouterID /* vrf */,
+    const rib::IPv4NetworkToRouteMap& /* v4NetworkToRoute */,
+    const rib::IPv6NetworkToRouteMap& /* v6NetworkToRoute */,
+    const rib::ResolutionDelta& /* delta */,
+    void* /* cookie */) {}
+
+} // namespace
+
+/*
+ * Programs a full route scale distribution into the standalone RIB and then
+ * measures how long it takes the RIB (without the FIB) to absorb the removal
+ * and re-addition of churnSize routes.
+ */
+template <typename Generator>
+static void runChurnBenchmark(unsigned int churnSize) {
+  folly::BenchmarkSuspender suspender;
+
+  SimPlatform plat(folly::MacAddress(), 128);
+  std::vector<PortID> ports;
+  for (int i = 0; i < 128; ++i) {
+    ports.push_back(PortID(i));
+  }
+  cfg::SwitchConfig config =
+      utility::onePortPerVlanConfig(plat.getHwSwitch(), ports);
+  auto testHandle =
+      createTestHandle(&config, SwitchFlags::ENABLE_STANDALONE_RIB);
+  auto sw = testHandle->getSw();
+
+  // RouteDistributionGenerator expects `RouteTables` to have an entry for
+  // VRF 0 even though the standalone RIB does not use it.
+  sw->updateStateBlocking(
+      "add VRF0", [=](const std::shared_ptr<SwitchState>& state) {
+        std::shared_ptr<SwitchState> newState{state};
+        auto newRouteTables = newState->getRouteTables()->modify(&newState);
+        newRouteTables->addRouteTable(
+            std::make_shared<RouteTable>(RouterID(0)));
+        return newState;
+      });
+
+  const auto& routeChunks =
+      Generator(sw->getAppliedState(), 1337, kEcmpWidth, kVrfZero).get();
+
+  auto rib = sw->getRib();
+  utility::RouteDistributionGenerator::RouteChunk churnRoutes;
+  for (const auto& chunk : routeChunks) {
+    rib->update(
+        kVrfZero,
+        kBgpClient,
+        AdminDistance::EBGP,
+        toUnicastRoutes(chunk),
+        {} /* toDelete */,
+        false /* resetClientsRoutes */,
+        "RIB churn benchmark setup",
+        noopFibUpdate,
+        nullptr);
+    for (const auto& route : chunk) {
+      if (churnRoutes.size() < churnSize) {
+        churnRoutes.push_back(route);
+      }
+    }
+  }
+
+  auto toAdd = toUnicastRoutes(churnRoutes);
+  std::vector<IpPrefix> toDelete;
+  for (const auto& route : toAdd) {
+    toDelete.push_back(*route.dest_ref());
+  }
+
+  suspender.dismiss();
+
+  rib->update(
+      kVrfZero,
+      kBgpClient,
+      AdminDistance::EBGP,
+      {} /* toAdd */,
+      toDelete,
+      false /* resetClientsRoutes */,
+      "RIB churn benchmark withdraw",
+      noopFibUpdate,
+      nullptr);
+  rib->update(
+      kVrfZero,
+      kBgpClient,
+      AdminDistance::EBGP,
+      toAdd,
+      {} /* toDelete */,
+      false /* resetClientsRoutes */,
+      "RIB churn benchmark announce",
+      noopFibUpdate,
+      nullptr);
+
+  suspender.rehire();
+}
+
+BENCHMARK(RibChurnSingleRouteFSW) {
+  runChurnBenchmark<utility::FSWRouteScaleGenerator>(1);
+}
+
+BENCHMARK(RibChurn1kRoutesFSW) {
+  runChurnBenchmark<utility::FSWRouteScaleGenerator>(1000);
+}
+
+BENCHMARK(RibChurnSingleRouteTHAlpm) {
+  runChurnBenchmark<utility::THAlpmRouteScaleGenerator>(1);
+}
+
+BENCHMARK(RibChurn1kRoutesTHAlpm) {
+  runChurnBenchmark<utility::THAlpmRouteScaleGenerator>(1000);
+}
+
+BENCHMARK(RibChurnSingleRouteHgridDu) {
+  runChurnBenchmark<utility::HgridDuRouteScaleGenerator>(1);
+}
+
+BENCHMARK(RibChurn1kRoutesHgridDu) {
+  runChurnBenchmark<utility::HgridDuRouteScaleGenerator>(1000);
+}
+
+BENCHMARK(RibChurnSingleRouteHgridUu) {
+  runChurnBenchmark<utility::HgridUuRouteScaleGenerator>(1);
+}
+
+BENCHMARK(RibChurn1kRoutesHgridUu) {
+  runChurnBenchmark<utility::HgridUuRouteScaleGenerator>(1000);
+}
+
+int main(int argc, char** argv) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,172 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/RxPacketPipeline.h"
+
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/hw/mock/MockRxPacket.h"
+#include "fboss/agent/test/HwTestHandle.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <folly/Conv.h>
+#include <folly/Synchronized.h>
+#include <folly/synchronization/Baton.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+using namespace facebook::fboss;
+using std::unique_ptr;
+
+namespace {
+
+constexpr auto kEthHdr =
+    // dst mac, src mac
+    "01 80 c2 00 00 0e  00 02 00 01 02 03";
+
+unique_ptr<MockRxPacket> makePacket(folly::StringPiece hex) {
+  auto pkt = MockRxPacket::fromHex(folly::to<std::string>(kEthHdr, hex));
+  pkt->padToLength(68);
+  pkt->setSrcPort(PortID(1));
+  pkt->setSrcVlan(VlanID(1));
+  return pkt;
+}
+
+unique_ptr<MockRxPacket> makeIPv6Packet(
+    folly::StringPiece nextHeader,
+    folly::StringPiece payload) {
+  return makePacket(folly::to<std::string>(
+      // 802.1q, VLAN 1, IPv6
+      "81 00 00 01  86 dd"
+      // Version, traffic class, flow label, payload length
+      "60 00 00 00  00 20",
+      nextHeader,
+      // Hop limit
+      "ff"
+      // Source and destination IPs
+      "fe 80 00 00 00 00 00 00 02 02 00 ff fe 01 02 03"
+      "ff 02 00 00 00 00 00 00 00 00 00 01 ff 00 00 01",
+      payload));
+}
+
+RxPacketPipeline::Queue classify(const unique_ptr<MockRxPacket>& pkt) {
+  return RxPacketPipeline::classify(
+      pkt.get(), PktHeaderView::parse(pkt->buf()));
+}
+
+} // namespace
+
+TEST(RxPacketPipelineTest, ClassifyControlPackets) {
+  // LACP
+  EXPECT_EQ(
+      RxPacketPipeline::Queue::CONTROL,
+      classify(makePacket("88 09  01 01")));
+  // LLDP
+  EXPECT_EQ(
+      RxPacketPipeline::Queue::CONTROL,
+      classify(makePacket("88 cc  02 07")));
+  // LLDP, VLAN tagged
+  EXPECT_EQ(
+      RxPacketPipeline::Queue::CONTROL,
+      classify(makePacket("81 00 00 01  88 cc")));
+}
+
+TEST(RxPacketPipelineTest, ClassifyNeighborPackets) {
+  // ARP
+  EXPECT_EQ(
+      RxPacketPipeline::Queue::NEIGHBOR,
+      classify(makePacket("81 00 00 01  08 06  00 01  08 00  06  04")));
+  // NDP neighbor solicitation
+  EXPECT_EQ(
+      RxPacketPipeline::Queue::NEIGHBOR,
+      classify(makeIPv6Packet("3a", "87 00")));
+}
+
+TEST(RxPacketPipelineTest, ClassifyDataPackets) {
+  // ICMPv6 echo request
+  EXPECT_EQ(
+      RxPacketPipeline::Queue::DATA,
+      classify(makeIPv6Packet("3a", "80 00")));
+  // UDP over IPv6, e.g. DHCPv6
+  EXPECT_EQ(
+      RxPacketPipeline::Queue::DATA,
+      classify(makeIPv6Packet("11", "02 22 02 23")));
+  // IPv4
+  EXPECT_EQ(
+      RxPacketPipeline::Queue::DATA,
+      classify(makePacket("08 00  45 00")));
+  // Runt frame
+  auto runt = MockRxPacket::fromHex(folly::to<std::string>(kEthHdr, "88 cc"));
+  EXPECT_EQ(RxPacketPipeline::Queue::DATA, classify(runt));
+}
+
+TEST(RxPacketPipelineTest, HandlesPacketsInOrderPerQueue) {
+  auto handle = createTestHandle(testStateA());
+  constexpr size_t kNumPackets = 1000;
+
+  folly::Synchronized<std::vector<uint32_t>> handled;
+  folly::Baton<> done;
+  RxPacketPipeline pipeline(
+      handle->getSw(),
+      [&](unique_ptr<RxPacket> pkt,
+          std::optional<PktHeaderView> /*headers*/) {
+        auto locked = handled.wlock();
+        locked->push_back(pkt->getLength());
+        if (locked->size() == kNumPackets) {
+          done.post();
+        }
+      },
+      kNumPackets,
+      16 /* batchSize */);
+
+  // Tell the packets apart by their length
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    auto pkt = makePacket(i % 2 ? "08 00  45 00" : "88 cc  02 07");
+    pkt->padToLength(68 + i);
+    EXPECT_TRUE(pipeline.enqueue(std::move(pkt)));
+  }
+  done.wait();
+  pipeline.stop();
+
+  auto locked = handled.rlock();
+  ASSERT_EQ(kNumPackets, locked->size());
+  uint32_t lastControl = 0;
+  uint32_t lastData = 0;
+  for (auto length : *locked) {
+    auto& last = (length - 68) % 2 ? lastData : lastControl;
+    EXPECT_LT(last, length);
+    last = length;
+  }
+}
+
+TEST(RxPacketPipelineTest, DropsWhenQueueFull) {
+  auto handle = createTestHandle(testStateA());
+  folly::Baton<> unblock;
+  RxPacketPipeline pipeline(
+      handle->getSw(),
+      [&](unique_ptr<RxPacket> /*pkt*/,
+          std::optional<PktHeaderView> /*headers*/) { unblock.wait(); },
+      1 /* queueSize */,
+      1 /* batchSize */);
+
+  // The worker takes the first packet and blocks, the second one fills up
+  // the queue, any further one has to be dropped.
+  EXPECT_TRUE(pipeline.enqueue(makePacket("08 00  45 00")));
+  while (pipeline.getQueueDepth(RxPacketPipeline::Queue::DATA) != 0) {
+    std::this_thread::yield();
+  }
+  EXPECT_TRUE(pipeline.enqueue(makePacket("08 00  45 00")));
+  EXPECT_FALSE(pipeline.enqueue(makePacket("08 00  45 00")));
+  // Packets of other queues are unaffected
+  EXPECT_TRUE(pipeline.enqueue(makePacket("88 cc  02 07")));
+
+  unblock.post();
+  pipeline.stop();
+}
@@ -0,0 +1,195 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <boost/cast.hpp>
+
+#include <folly/Benchmark.h>
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/hw/mock/MockRxPacket.h"
+#include "fboss/agent/hw/sim/SimPlatform.h"
+#include "fboss/agent/hw/sim/SimSwitch.h"
+#include "fboss/agent/state/ArpResponseTable.h"
+#include "fboss/agent/state/Interface.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/state/Vlan.h"
+#include "fboss/agent/state/VlanMap.h"
+
+#include <algorithm>
+#include <thread>
+
+DECLARE_bool(rx_pipeline);
+
+using namespace facebook::fboss;
+using folly::IPAddress;
+using folly::IPAddressV4;
+using folly::MacAddress;
+using std::make_shared;
+using std::make_unique;
+using std::shared_ptr;
+using std::unique_ptr;
+
+namespace {
+
+// Global state used by the benchmarks
+unique_ptr<SwSwitch> inlineSw;
+unique_ptr<SwSwitch> pipelineSw;
+unique_ptr<MockRxPacket> arpRequest;
+
+unique_ptr<SwSwitch> setupSwitch(bool rxPipeline) {
+  FLAGS_rx_pipeline = rxPipeline;
+  MacAddress localMac("02:00:01:00:00:01");
+  auto sw = make_unique<SwSwitch>(make_unique<SimPlatform>(localMac, 10));
+  sw->init(nullptr /* No custom TunManager */);
+
+  auto updateFn = [&](const shared_ptr<SwitchState>& oldState) {
+    auto state = oldState->clone();
+
+    // Add VLAN 1, and ports 1-9 which belong to it.
+    auto vlan1 = make_shared<Vlan>(VlanID(1), "Vlan1");
+    state->addVlan(vlan1);
+    for (int idx = 1; idx < 10; ++idx) {
+      vlan1->addPort(PortID(idx), false);
+    }
+    // Add Interface 1 to VLAN 1
+    auto intf1 = make_shared<Interface>(
+        InterfaceID(1),
+        RouterID(0),
+        VlanID(1),
+        "interface1",
+        MacAddress("02:00:01:00:00:01"),
+        9000,
+        false, /* is virtual */
+        false /* is state_sync disabled*/);
+    Interface::Addresses addrs1;
+    addrs1.emplace(IPAddress("10.0.0.1"), 24);
+    intf1->setAddresses(addrs1);
+    state->addIntf(intf1);
+
+    auto respTable1 = make_shared<ArpResponseTable>();
+    respTable1->setEntry(
+        IPAddressV4("10.0.0.1"),
+        MacAddress("00:02:00:00:00:01"),
+        InterfaceID(1));
+    state->getVlans()->getVlan(VlanID(1))->setArpResponseTable(respTable1);
+    return state;
+  };
+
+  sw->updateStateBlocking("setup", updateFn);
+  return sw;
+}
+
+void init() {
+  inlineSw = setupSwitch(false);
+  pipelineSw = setupSwitch(true);
+
+  // Create an ARP request for 10.0.0.1, which the switch answers
+  arpRequest = MockRxPacket::fromHex(
+      // dst mac, src mac
+      "ff ff ff ff ff ff  00 02 00 01 02 03"
+      // 802.1q, VLAN 1
+      "81 00  00 01"
+      // ARP, htype: ethernet, ptype: IPv4, hlen: 6, plen: 4
+      "08 06  00 01  08 00  06  04"
+      // ARP Request
+      "00 01"
+      // Sender MAC
+      "00 02 00 01 02 03"
+      // Sender IP: 10.0.0.15
+      "0a 00 00 0f"
+      // Target MAC
+      "00 00 00 00 00 00"
+      // Target IP: 10.0.0.1
+      "0a 00 00 01");
+  arpRequest->padToLength(68);
+  arpRequest->setSrcPort(PortID(1));
+  arpRequest->setSrcVlan(VlanID(1));
+}
+
+SimSwitch* getSim(SwSwitch* sw) {
+  return boost::polymorphic_downcast<SimSwitch*>(sw->getHw());
+}
+
+void waitForReplies(SwSwitch* sw, size_t numReplies) {
+  while (getSim(sw)->getTxCount() < numReplies) {
+    std::this_thread::yield();
+  }
+}
+
+/*
+ * Packets are sent in bursts, each one waited on before sending the next, so
+ * that the RX pipeline queues never overflow and drop packets.
+ */
+constexpr size_t kBurstSize = 1000;
+
+/*
+ * Time it takes the RX callback thread to hand off numIters packets, i.e.
+ * how long a burst keeps it from picking up further packets.
+ */
+void runRxCallback(SwSwitch* sw, size_t numIters) {
+  BENCHMARK_SUSPEND {
+    getSim(sw)->resetTxCount();
+  }
+  for (size_t n = 0; n < numIters;) {
+    for (auto burstEnd = std::min(n + kBurstSize, numIters); n < burstEnd;
+         ++n) {
+      sw->packetReceived(arpRequest->clone());
+    }
+    BENCHMARK_SUSPEND {
+      waitForReplies(sw, n);
+    }
+  }
+}
+
+/*
+ * Time it takes to receive numIters packets and send a reply to each.
+ */
+void runRxToTx(SwSwitch* sw, size_t numIters) {
+  BENCHMARK_SUSPEND {
+    getSim(sw)->resetTxCount();
+  }
+  for (size_t n = 0; n < numIters;) {
+    for (auto burstEnd = std::min(n + kBurstSize, numIters); n < burstEnd;
+         ++n) {
+      sw->packetReceived(arpRequest->clone());
+    }
+    waitForReplies(sw, n);
+  }
+}
+
+} // unnamed namespace
+
+BENCHMARK(RxCallbackInline, numIters) {
+  runRxCallback(inlineSw.get(), numIters);
+}
+
+BENCHMARK_RELATIVE(RxCallbackPipeline, numIters) {
+  runRxCallback(pipelineSw.get(), numIters);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(RxToTxInline, numIters) {
+  runRxToTx(inlineSw.get(), numIters);
+}
+
+BENCHMARK_RELATIVE(RxToTxPipeline, numIters) {
+  runRxToTx(pipelineSw.get(), numIters);
+}
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  // Setting up the switches is fairly expensive.  Do this once before we run
+  // the benchmark functions so we don't have to do it inside the benchmark
+  // functions.
+  init();
+
+  folly::runBenchmarks();
+  return 0;
+}
@@ -14,6 +14,7 @@
 #include "fboss/agent/Main.h"
 #include "fboss/agent/NeighborUpdater.h"
 #include "fboss/agent/PortStats.h"
+#include "fboss/agent/StateObserver.h"
 #include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/state/ArpTable.h"
 #include "fboss/agent/state/Interface.h"
@@ -27,6 +28,7 @@
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
 #include <folly/MacAddress.h>
+#include <folly/Synchronized.h>
 
 #include <algorithm>
 
@@ -38,6 +40,39 @@ using std::string;
 using ::testing::_;
 using ::testing::Return;
 
+namespace {
+class AsyncStateObserver : public AutoRegisterStateObserver {
+ public:
+  explicit AsyncStateObserver(SwSwitch* sw)
+      : AutoRegisterStateObserver(
+            sw,
+            "AsyncStateObserver",
+            StateObserverDispatch::ASYNC),
+        sw_(sw) {}
+  ~AsyncStateObserver() override {
+    unregisterStateObserver();
+  }
+  using AutoRegisterStateObserver::unregisterStateObserver;
+
+  void stateUpdated(const StateDelta& delta) override {
+    EXPECT_FALSE(sw_->getUpdateEvb()->isInEventBaseThread());
+    deltas_.wlock()->emplace_back(delta.oldState(), delta.newState());
+  }
+
+  std::vector<
+      std::pair<std::shared_ptr<SwitchState>, std::shared_ptr<SwitchState>>>
+  getDeltas() const {
+    return deltas_.copy();
+  }
+
+ private:
+  SwSwitch* sw_;
+  folly::Synchronized<std::vector<
+      std::pair<std::shared_ptr<SwitchState>, std::shared_ptr<SwitchState>>>>
+      deltas_;
+};
+} // namespace
+
 class SwSwitchTest : public ::testing::Test {
  public:
   void SetUp() override {
@@ -216,3 +251,33 @@ TEST_F(SwSwitchTest, VerifyIsValidStateUpdate) {
 
   EXPECT_FALSE(sw->isValidStateUpdate(StateDelta(stateV0, stateV2)));
 }
+
+TEST_F(SwSwitchTest, AsyncStateObserverSeesUpdatesInOrder) {
+  auto observer = std::make_unique<AsyncStateObserver>(sw);
+  auto origState = sw->getState();
+  for (auto i = 0; i < 3; ++i) {
+    sw->updateStateBlocking(
+        "Toggle port 1 admin state",
+        [](const std::shared_ptr<SwitchState>& state) {
+          auto newState = state->clone();
+          auto port = newState->getPorts()->getPort(PortID(1))->modify(
+              &newState);
+          port->setAdminState(
+              port->getAdminState() == cfg::PortState::ENABLED
+                  ? cfg::PortState::DISABLED
+                  : cfg::PortState::ENABLED);
+          return newState;
+        });
+  }
+  auto finalState = sw->getState();
+  // Unregistering waits for the observer to see every delta handed to it
+  observer->unregisterStateObserver();
+
+  auto deltas = observer->getDeltas();
+  ASSERT_EQ(3, deltas.size());
+  EXPECT_EQ(origState, deltas.front().first);
+  for (size_t i = 1; i < deltas.size(); ++i) {
+    EXPECT_EQ(deltas[i - 1].second, deltas[i].first);
+  }
+  EXPECT_EQ(finalState, deltas.back().second);
+}
@@ -12,6 +12,8 @@
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/ThriftHandler.h"
 #include "fboss/agent/hw/mock/MockPlatform.h"
+#include "fboss/agent/state/ForwardingInformationBaseContainer.h"
+#include "fboss/agent/state/ForwardingInformationBaseMap.h"
 #include "fboss/agent/state/Route.h"
 #include "fboss/agent/state/RouteUpdater.h"
 #include "fboss/agent/state/SwitchState.h"
@@ -26,6 +28,7 @@ using namespace facebook::fboss;
 using apache::thrift::TEnumTraits;
 using cfg::PortSpeed;
 using facebook::network::toBinaryAddress;
+using facebook::network::toIPAddress;
 using folly::IPAddress;
 using folly::IPAddressV4;
 using folly::IPAddressV6;
@@ -357,3 +360,212 @@ TEST(ThriftTest, syncFib) {
   EXPECT_EQ(4 + 1, tables3->getRouteTable(rid)->getRibV4()->size());
   EXPECT_EQ(4 + 1, tables3->getRouteTable(rid)->getRibV6()->size());
 }
+
+TEST(ThriftTest, getRouteTablePage) {
+  cfg::SwitchConfig config;
+  config.vlans_ref()->resize(1);
+  *config.vlans_ref()[0].id_ref() = 1;
+  config.interfaces_ref()->resize(1);
+  *config.interfaces_ref()[0].intfID_ref() = 1;
+  *config.interfaces_ref()[0].vlanID_ref() = 1;
+  *config.interfaces_ref()[0].routerID_ref() = 0;
+  config.interfaces_ref()[0].mac_ref() = "00:02:00:00:00:01";
+  config.interfaces_ref()[0].ipAddresses_ref()->resize(2);
+  config.interfaces_ref()[0].ipAddresses_ref()[0] = "10.0.0.1/24";
+  config.interfaces_ref()[0].ipAddresses_ref()[1] =
+      "2401:db00:2110:3001::0001/64";
+
+  auto handle = createTestHandle(&config);
+  auto sw = handle->getSw();
+  sw->initialConfigApplied(std::chrono::steady_clock::now());
+  sw->fibSynced();
+  ThriftHandler handler(sw);
+
+  handler.addUnicastRoute(10, makeUnicastRoute("7.1.0.0/16", "10.0.0.2"));
+  handler.addUnicastRoute(10, makeUnicastRoute("7.2.0.0/16", "10.0.0.2"));
+  handler.addUnicastRoute(20, makeUnicastRoute("7.2.0.0/16", "10.0.0.3"));
+  handler.addUnicastRoute(10, makeUnicastRoute("8.1.0.0/16", "10.0.0.2"));
+  handler.addUnicastRoute(
+      20, makeUnicastRoute("aaaa:1::0/64", "2401:db00:2110:3001::2"));
+
+  auto prefixStr = [](const IpPrefix& prefix) {
+    return folly::to<std::string>(
+        toIPAddress(prefix.ip).str(), "/", prefix.prefixLength);
+  };
+  // Walk the route table a page of maxRoutes routes at a time
+  auto walkRoutes = [&](const RouteTableFilter& filter, int32_t maxRoutes) {
+    std::vector<std::string> prefixes;
+    int64_t cursor = 0;
+    do {
+      RouteTablePage page;
+      handler.getRouteTablePage(
+          page, cursor, maxRoutes, std::make_unique<RouteTableFilter>(filter));
+      EXPECT_LE(page.routes_ref()->size(), static_cast<size_t>(maxRoutes));
+      for (const auto& route : *page.routes_ref()) {
+        prefixes.push_back(prefixStr(route.dest));
+      }
+      cursor = *page.cursor_ref();
+    } while (cursor != 0);
+    return prefixes;
+  };
+
+  // Walking by page returns the same routes as getting them all at once
+  std::vector<UnicastRoute> allRoutes;
+  handler.getRouteTable(allRoutes);
+  std::vector<std::string> allPrefixes;
+  for (const auto& route : allRoutes) {
+    allPrefixes.push_back(prefixStr(route.dest));
+  }
+  EXPECT_EQ(allPrefixes, walkRoutes(RouteTableFilter(), 2));
+  EXPECT_EQ(allPrefixes, walkRoutes(RouteTableFilter(), 1000));
+
+  std::vector<RouteDetails> allDetails;
+  handler.getRouteTableDetails(allDetails);
+  std::vector<RouteDetails> pagedDetails;
+  int64_t cursor = 0;
+  do {
+    RouteDetailsPage page;
+    handler.getRouteTableDetailsPage(
+        page, cursor, 3, std::make_unique<RouteTableFilter>());
+    pagedDetails.insert(
+        pagedDetails.end(),
+        page.routes_ref()->begin(),
+        page.routes_ref()->end());
+    cursor = *page.cursor_ref();
+  } while (cursor != 0);
+  EXPECT_EQ(allDetails, pagedDetails);
+
+  // Filter by client
+  RouteTableFilter clientFilter;
+  clientFilter.clientId_ref() = 20;
+  EXPECT_EQ(
+      std::vector<std::string>({"7.2.0.0/16", "aaaa:1::/64"}),
+      walkRoutes(clientFilter, 1));
+
+  // Filter by prefix
+  RouteTableFilter prefixFilter;
+  prefixFilter.prefix_ref() = ipPrefix("7.0.0.0", 8);
+  EXPECT_EQ(
+      std::vector<std::string>({"7.1.0.0/16", "7.2.0.0/16"}),
+      walkRoutes(prefixFilter, 1));
+
+  // Host bits of the prefix filter are ignored
+  RouteTableFilter hostFilter;
+  hostFilter.prefix_ref() = ipPrefix("7.1.2.3", 8);
+  EXPECT_EQ(
+      std::vector<std::string>({"7.1.0.0/16", "7.2.0.0/16"}),
+      walkRoutes(hostFilter, 1));
+
+  // A walk sees the routes of the snapshot it started on
+  RouteTablePage page1;
+  handler.getRouteTablePage(
+      page1, 0, 1, std::make_unique<RouteTableFilter>(prefixFilter));
+  EXPECT_EQ(1, page1.routes_ref()->size());
+  ASSERT_NE(0, *page1.cursor_ref());
+  handler.addUnicastRoute(10, makeUnicastRoute("7.3.0.0/16", "10.0.0.2"));
+  RouteTablePage page2;
+  handler.getRouteTablePage(
+      page2, *page1.cursor_ref(), 10, std::make_unique<RouteTableFilter>());
+  ASSERT_EQ(1, page2.routes_ref()->size());
+  EXPECT_EQ("7.2.0.0/16", prefixStr(page2.routes_ref()[0].dest));
+  EXPECT_EQ(0, *page2.cursor_ref());
+
+  // The cursor is gone once the walk is done
+  RouteTablePage page3;
+  EXPECT_THROW(
+      handler.getRouteTablePage(
+          page3,
+          *page1.cursor_ref(),
+          10,
+          std::make_unique<RouteTableFilter>()),
+      FbossError);
+}
+
+TEST(ThriftTest, updateUnicastRoutesAsync) {
+  RouterID rid = RouterID(0);
+
+  cfg::SwitchConfig config;
+  config.vlans_ref()->resize(1);
+  *config.vlans_ref()[0].id_ref() = 1;
+  config.interfaces_ref()->resize(1);
+  *config.interfaces_ref()[0].intfID_ref() = 1;
+  *config.interfaces_ref()[0].vlanID_ref() = 1;
+  *config.interfaces_ref()[0].routerID_ref() = 0;
+  config.interfaces_ref()[0].mac_ref() = "00:02:00:00:00:01";
+  config.interfaces_ref()[0].ipAddresses_ref()->resize(2);
+  config.interfaces_ref()[0].ipAddresses_ref()[0] = "10.0.0.1/24";
+  config.interfaces_ref()[0].ipAddresses_ref()[1] =
+      "2401:db00:2110:3001::0001/64";
+
+  auto handle = createTestHandle(&config, SwitchFlags::ENABLE_STANDALONE_RIB);
+  auto sw = handle->getSw();
+  sw->initialConfigApplied(std::chrono::steady_clock::now());
+  sw->fibSynced();
+  ThriftHandler handler(sw);
+
+  auto routes = [](std::string prefix, std::string nexthop) {
+    auto toAdd = std::make_unique<std::vector<UnicastRoute>>();
+    toAdd->push_back(*makeUnicastRoute(prefix, nexthop));
+    return toAdd;
+  };
+  auto noRoutes = []() {
+    return std::make_unique<std::vector<UnicastRoute>>();
+  };
+  auto noPrefixes = []() { return std::make_unique<std::vector<IpPrefix>>(); };
+  auto fibRouteV4 = [&](StringPiece ip, uint8_t mask) {
+    return sw->getState()
+        ->getFibs()
+        ->getFibContainer(rid)
+        ->getFibV4()
+        ->exactMatch(RoutePrefixV4{IPAddressV4(ip), mask});
+  };
+  auto fibRouteV6 = [&](StringPiece ip, uint8_t mask) {
+    return sw->getState()
+        ->getFibs()
+        ->getFibContainer(rid)
+        ->getFibV6()
+        ->exactMatch(RoutePrefixV6{IPAddressV6(ip), mask});
+  };
+
+  // Updates from several clients get increasing generations
+  auto gen1 = handler.updateUnicastRoutesAsync(
+      10, routes("7.1.0.0/16", "10.0.0.2"), noPrefixes(), 0, false);
+  auto gen2 = handler.updateUnicastRoutesAsync(
+      20,
+      routes("aaaa:1::0/64", "2401:db00:2110:3001::2"),
+      noPrefixes(),
+      0,
+      false);
+  EXPECT_LT(gen1, gen2);
+
+  EXPECT_TRUE(handler.waitForRouteGeneration(gen2, 5000));
+  EXPECT_GE(handler.getProgrammedRouteGeneration(), gen2);
+  EXPECT_NE(nullptr, fibRouteV4("7.1.0.0", 16));
+  EXPECT_NE(nullptr, fibRouteV6("aaaa:1::", 64));
+
+  // Delete one route and re-sync the routes of the other client
+  auto toDelete = noPrefixes();
+  toDelete->push_back(ipPrefix("7.1.0.0", 16));
+  auto gen3 = handler.updateUnicastRoutesAsync(
+      10, noRoutes(), std::move(toDelete), 0, false);
+  auto gen4 = handler.updateUnicastRoutesAsync(
+      20, routes("8.1.0.0/16", "10.0.0.3"), noPrefixes(), 0, true);
+  EXPECT_LT(gen3, gen4);
+
+  EXPECT_TRUE(handler.waitForRouteGeneration(gen4, 5000));
+  EXPECT_EQ(nullptr, fibRouteV4("7.1.0.0", 16));
+  EXPECT_EQ(nullptr, fibRouteV6("aaaa:1::", 64));
+  EXPECT_NE(nullptr, fibRouteV4("8.1.0.0", 16));
+
+  // Generations that were never handed out are not programmed
+  EXPECT_FALSE(handler.waitForRouteGeneration(gen4 + 1, 10));
+
+  // The async API needs the standalone RIB
+  auto legacyHandle = setupTestHandle();
+  legacyHandle->getSw()->fibSynced();
+  ThriftHandler legacyHandler(legacyHandle->getSw());
+  EXPECT_THROW(
+      legacyHandler.updateUnicastRoutesAsync(
+          10, routes("7.1.0.0/16", "10.0.0.2"), noPrefixes(), 0, false),
+      FbossError);
+}
@@ -0,0 +1,99 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/Utils.h"
+
+#include <folly/Conv.h>
+#include <folly/FileUtil.h>
+#include <folly/experimental/TestUtil.h>
+#include <folly/json.h>
+#include <folly/lang/Bits.h>
+#include <gtest/gtest.h>
+
+#include <array>
+
+using namespace facebook::fboss;
+
+namespace {
+
+folly::dynamic makeState() {
+  folly::dynamic routes = folly::dynamic::array;
+  for (auto i = 0; i < 100; ++i) {
+    folly::dynamic route = folly::dynamic::object;
+    route["prefix"] = folly::to<std::string>("10.0.", i, ".0/24");
+    route["nexthops"] = folly::dynamic::array("10.0.0.1", "10.0.0.2");
+    route["weight"] = i;
+    route["resolved"] = i % 2 == 0;
+    routes.push_back(std::move(route));
+  }
+  folly::dynamic state = folly::dynamic::object;
+  state["swSwitch"] = folly::dynamic::object;
+  state["swSwitch"]["routes"] = std::move(routes);
+  state["swSwitch"]["generation"] = 12345;
+  state["hwSwitch"] = folly::dynamic::object;
+  state["hwSwitch"]["warmBootCache"] = nullptr;
+  return state;
+}
+
+class WarmBootStateFileTest : public ::testing::Test {
+ protected:
+  std::string stateFile() const {
+    return tmpDir_.path().string() + "/switch_state";
+  }
+
+ private:
+  folly::test::TemporaryDirectory tmpDir_;
+};
+
+} // namespace
+
+TEST_F(WarmBootStateFileTest, BinaryRoundTrip) {
+  auto state = makeState();
+  ASSERT_TRUE(dumpBinaryStateToFile(stateFile(), state));
+  EXPECT_EQ(state, readStateFromFile(stateFile()));
+}
+
+TEST_F(WarmBootStateFileTest, ReadJson) {
+  // State files written by agents that only dump JSON are still read
+  auto state = makeState();
+  ASSERT_TRUE(dumpStateToFile(stateFile(), state));
+  EXPECT_EQ(state, readStateFromFile(stateFile()));
+}
+
+TEST_F(WarmBootStateFileTest, UnsupportedVersion) {
+  ASSERT_TRUE(dumpBinaryStateToFile(stateFile(), makeState()));
+  std::string contents;
+  ASSERT_TRUE(folly::readFile(stateFile().c_str(), contents));
+
+  // Bump the version, which follows the magic number
+  auto version = folly::Endian::big(uint32_t(2));
+  contents.replace(
+      sizeof(uint32_t),
+      sizeof(version),
+      reinterpret_cast<const char*>(&version),
+      sizeof(version));
+  ASSERT_TRUE(folly::writeFile(contents, stateFile().c_str()));
+  EXPECT_THROW(readStateFromFile(stateFile()), FbossError);
+}
+
+TEST_F(WarmBootStateFileTest, Truncated) {
+  ASSERT_TRUE(dumpBinaryStateToFile(stateFile(), makeState()));
+  std::string contents;
+  ASSERT_TRUE(folly::readFile(stateFile().c_str(), contents));
+  ASSERT_GT(contents.size(), 2 * sizeof(uint32_t));
+
+  // Cut off within the encoded state, and within the header
+  for (auto size : std::array<size_t, 2>{contents.size() / 2, 6}) {
+    ASSERT_TRUE(
+        folly::writeFile(contents.substr(0, size), stateFile().c_str()));
+    EXPECT_ANY_THROW(readStateFromFile(stateFile()));
+  }
+}
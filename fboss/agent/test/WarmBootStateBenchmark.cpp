@@ -0,0 +1,106 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "common/init/Init.h"
+#include "fboss/agent/Constants.h"
+#include "fboss/agent/Utils.h"
+#include "fboss/agent/hw/sim/SimPlatform.h"
+#include "fboss/agent/hw/sim/SimSwitch.h"
+#include "fboss/agent/state/ForwardingInformationBase.h"
+#include "fboss/agent/state/Route.h"
+#include "fboss/agent/state/RouteNextHopEntry.h"
+
+#include <folly/Benchmark.h>
+#include <folly/IPAddressV4.h>
+#include <folly/MacAddress.h>
+#include <folly/experimental/TestUtil.h>
+#include <glog/logging.h>
+
+using namespace facebook::fboss;
+
+namespace {
+
+constexpr uint32_t kFibSize = 200000;
+
+/*
+ * Builds the same shape of state the SimSwitch warm boot exit path dumps:
+ * a switch state holding a large FIB alongside the SimSwitch's own state.
+ */
+folly::dynamic makeWarmBootState() {
+  auto fib = std::make_shared<ForwardingInformationBaseV4>();
+  for (uint32_t i = 0; i < kFibSize; ++i) {
+    RoutePrefixV4 prefix{folly::IPAddressV4::fromLongHBO(i << 8), 24};
+    RouteNextHopEntry entry(
+        RouteNextHopEntry::Action::DROP, AdminDistance::EBGP);
+    auto route = std::make_shared<RouteV4>(prefix, ClientID(0), entry);
+    route->setResolved(std::move(entry));
+    fib->addNode(route);
+  }
+  SimPlatform platform(folly::MacAddress("02:00:00:00:00:01"), 10);
+  folly::dynamic state = folly::dynamic::object;
+  state[kSwSwitch] = fib->toFollyDynamic();
+  state[kHwSwitch] = platform.getHwSwitch()->toFollyDynamic();
+  return state;
+}
+
+void runDumpBenchmark(bool binary) {
+  folly::BenchmarkSuspender suspender;
+  auto state = makeWarmBootState();
+  folly::test::TemporaryDirectory tmpDir;
+  auto file = tmpDir.path().string() + "/switch_state";
+  suspender.dismiss();
+
+  auto written = binary ? dumpBinaryStateToFile(file, state)
+                        : dumpStateToFile(file, state);
+
+  suspender.rehire();
+  CHECK(written);
+}
+
+void runReadBenchmark(bool binary) {
+  folly::BenchmarkSuspender suspender;
+  auto state = makeWarmBootState();
+  folly::test::TemporaryDirectory tmpDir;
+  auto file = tmpDir.path().string() + "/switch_state";
+  CHECK(
+      binary ? dumpBinaryStateToFile(file, state)
+             : dumpStateToFile(file, state));
+  suspender.dismiss();
+
+  auto readState = readStateFromFile(file);
+  folly::doNotOptimizeAway(readState);
+
+  suspender.rehire();
+  CHECK_EQ(readState[kSwSwitch].size(), state[kSwSwitch].size());
+}
+
+} // namespace
+
+BENCHMARK(WarmBootStateDumpJson) {
+  runDumpBenchmark(false);
+}
+
+BENCHMARK(WarmBootStateDumpBinary) {
+  runDumpBenchmark(true);
+}
+
+BENCHMARK(WarmBootStateReadJson) {
+  runReadBenchmark(false);
+}
+
+BENCHMARK(WarmBootStateReadBinary) {
+  runReadBenchmark(true);
+}
+
+int main(int argc, char** argv) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return EXIT_SUCCESS;
+}
@@ -8,7 +8,9 @@
 #include <exception>
 #include <functional>
 #include <memory>
+#include <new>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -22,12 +24,18 @@
 #include <optional>
 
 namespace facebook::network {
+
+template <typename NODE>
+class RadixTreeNodePool;
+
 /*
  * Node in RadixTree, holds IP, mask. Will hold  value for nodes
  * created as a result of user inserts. Other type of nodes are
  * ones created by the radix tree implementation, which will
  * hold no values. All non value nodes will have 2 children,
  * this invariant must be maintained at all times.
+ * Nodes are allocated from, and returned to, the RadixTreeNodePool
+ * of the tree they belong to.
  */
 template <typename IPADDRTYPE, typename T>
 class RadixTreeNode {
@@ -35,27 +43,34 @@ class RadixTreeNode {
   // Optional function parameter to call from destructor
   typedef std::function<void(const RadixTreeNode<IPADDRTYPE, T>&)>
       NodeDeleteCallback;
+  typedef RadixTreeNodePool<RadixTreeNode> NodePool;
 
-  RadixTreeNode(
-      const IPADDRTYPE& ipAddr,
-      uint8_t mlen,
-      NodeDeleteCallback deleteCallback)
-      : ipAddress_(ipAddr), masklen_(mlen), deleteCallback_(deleteCallback) {}
+  // Returns nodes to the pool they were allocated from
+  struct NodeDeleter {
+    void operator()(RadixTreeNode* node) const {
+      node->pool_->destroy(node);
+    }
+  };
+  typedef std::unique_ptr<RadixTreeNode, NodeDeleter> NodePtr;
+
+  RadixTreeNode(const IPADDRTYPE& ipAddr, uint8_t mlen, NodePool* pool)
+      : pool_(pool), ipAddress_(ipAddr), masklen_(mlen) {}
 
   template <typename VALUE>
   RadixTreeNode(
       const IPADDRTYPE& ipAddr,
       uint8_t mlen,
       VALUE&& val,
-      NodeDeleteCallback deleteCallback)
-      : ipAddress_(ipAddr),
+      NodePool* pool)
+      : pool_(pool),
+        ipAddress_(ipAddr),
         masklen_(mlen),
-        value_(std::forward<VALUE>(val)),
-        deleteCallback_(deleteCallback) {}
+        value_(std::forward<VALUE>(val)) {}
 
   ~RadixTreeNode() {
-    if (deleteCallback_) {
-      deleteCallback_(*this);
+    const auto& deleteCallback = pool_->deleteCallback();
+    if (deleteCallback) {
+      deleteCallback(*this);
     }
   }
 
@@ -101,10 +116,10 @@ class RadixTreeNode {
     return value_.value();
   }
   NodeDeleteCallback nodeDeleteCallback() const {
-    return deleteCallback_;
+    return pool_->deleteCallback();
   }
   std::string str(bool printValue = true) const {
-    auto nodeStr = folly::to<std::string>(ipAddress_.str(), "/", masklen_);
+    auto nodeStr = folly::to<std::string>(ipAddress_.str(), "/", masklen());
     if (printValue) {
       nodeStr += isNonValueNode()
           ? "(*)"
@@ -129,8 +144,7 @@ class RadixTreeNode {
         (!isValueNode() || this->value() == r.value());
   }
 
-  std::unique_ptr<RadixTreeNode> resetLeft(
-      std::unique_ptr<RadixTreeNode> newLeft) {
+  NodePtr resetLeft(NodePtr newLeft) {
     auto old = std::move(left_);
     left_ = std::move(newLeft);
     if (left_) {
@@ -139,8 +153,7 @@ class RadixTreeNode {
     return old;
   }
 
-  std::unique_ptr<RadixTreeNode> resetRight(
-      std::unique_ptr<RadixTreeNode> newRight) {
+  NodePtr resetRight(NodePtr newRight) {
     auto old = std::move(right_);
     right_ = std::move(newRight);
     if (right_) {
@@ -163,13 +176,123 @@ class RadixTreeNode {
   }
 
  protected:
+  // Links first, so that a lookup stepping through the node touches as
+  // few cache lines as possible.
+  NodePtr left_{nullptr};
+  NodePtr right_{nullptr};
+  RadixTreeNode* parent_{nullptr};
+  NodePool* pool_;
   IPADDRTYPE ipAddress_;
-  uint32_t masklen_{0}; // Number of bits to match.
+  uint8_t masklen_{0}; // Number of bits to match.
   std::optional<T> value_;
-  std::unique_ptr<RadixTreeNode> left_{nullptr};
-  std::unique_ptr<RadixTreeNode> right_{nullptr};
-  RadixTreeNode* parent_{nullptr};
+};
+
+/*
+ * Allocates the nodes of a RadixTree in slabs, rather than one heap
+ * allocation per node. Destroyed nodes go on a free list, and their memory
+ * is reused by the next nodes created. Memory is returned to the heap only
+ * once the tree is cleared or destroyed.
+ *
+ * The pool also holds the delete callback of the nodes it allocates, so that
+ * nodes carry a pointer to the pool rather than a copy of the callback.
+ */
+template <typename NODE>
+class RadixTreeNodePool {
+ public:
+  typedef typename NODE::NodeDeleteCallback NodeDeleteCallback;
+  typedef typename NODE::NodePtr NodePtr;
+
+  explicit RadixTreeNodePool(NodeDeleteCallback deleteCallback)
+      : deleteCallback_(std::move(deleteCallback)) {}
+
+  RadixTreeNodePool(const RadixTreeNodePool& r) = delete;
+  RadixTreeNodePool& operator=(const RadixTreeNodePool& r) = delete;
+
+  ~RadixTreeNodePool() {
+    DCHECK_EQ(numNodes_, 0);
+  }
+
+  const NodeDeleteCallback& deleteCallback() const {
+    return deleteCallback_;
+  }
+
+  size_t numNodes() const {
+    return numNodes_;
+  }
+
+  template <typename... Args>
+  NodePtr create(Args&&... args) {
+    Slot* slot = freeList_;
+    if (slot) {
+      freeList_ = slot->next;
+    } else {
+      if (nextUnused_ == slabEnd_) {
+        addSlab(std::min(std::max(kMinSlabSize, numNodes_), kMaxSlabSize));
+      }
+      slot = nextUnused_++;
+    }
+    NODE* node;
+    try {
+      node = new (&slot->storage) NODE(std::forward<Args>(args)..., this);
+    } catch (...) {
+      slot->next = freeList_;
+      freeList_ = slot;
+      throw;
+    }
+    ++numNodes_;
+    return NodePtr(node);
+  }
+
+  void destroy(NODE* node) {
+    node->~NODE();
+    auto slot = reinterpret_cast<Slot*>(node);
+    slot->next = freeList_;
+    freeList_ = slot;
+    --numNodes_;
+  }
+
+  // Make room for numNodes more nodes in one contiguous slab
+  void reserve(size_t numNodes) {
+    if (static_cast<size_t>(slabEnd_ - nextUnused_) < numNodes) {
+      addSlab(numNodes);
+    }
+  }
+
+  // Free all memory. All nodes must have been destroyed already.
+  void release() {
+    CHECK_EQ(numNodes_, 0);
+    slabs_.clear();
+    freeList_ = nextUnused_ = slabEnd_ = nullptr;
+  }
+
+ private:
+  union Slot {
+    Slot* next;
+    typename std::aligned_storage<sizeof(NODE), alignof(NODE)>::type storage;
+  };
+
+  static constexpr size_t kMinSlabSize = 16;
+  static constexpr size_t kMaxSlabSize = 4096;
+
+  void addSlab(size_t numSlots) {
+    // The unused rest of the current slab is still usable via the free list
+    while (nextUnused_ != slabEnd_) {
+      auto slot = nextUnused_++;
+      slot->next = freeList_;
+      freeList_ = slot;
+    }
+    slabs_.emplace_back(new Slot[numSlots]);
+    nextUnused_ = slabs_.back().get();
+    slabEnd_ = nextUnused_ + numSlots;
+  }
+
   NodeDeleteCallback deleteCallback_;
+  std::vector<std::unique_ptr<Slot[]>> slabs_;
+  Slot* freeList_{nullptr};
+  // Slots of the last slab that were never used
+  Slot* nextUnused_{nullptr};
+  Slot* slabEnd_{nullptr};
+  size_t numNodes_{0};
 };
 
 /*
@@ -378,6 +501,8 @@ class RadixTree {
   typedef RadixTreeNode<IPADDRTYPE, T> TreeNode;
   typedef typename TreeNode::TreeDirection TreeDirection;
   typedef typename TreeNode::NodeDeleteCallback NodeDeleteCallback;
+  typedef typename TreeNode::NodePool NodePool;
+  typedef typename TreeNode::NodePtr NodePtr;
   typedef typename TreeTraits::Iterator Iterator;
   typedef typename TreeTraits::ConstIterator ConstIterator;
   typedef typename std::vector<ConstIterator> VecConstIterators;
@@ -385,7 +510,8 @@ class RadixTree {
   explicit RadixTree(
       NodeDeleteCallback nodeDelCallback = NodeDeleteCallback(),
       const TreeTraits& treeTraits = TreeTraits())
-      : nodeDeleteCallback_(nodeDelCallback), traits_(treeTraits) {}
+      : pool_(std::make_unique<NodePool>(std::move(nodeDelCallback))),
+        traits_(treeTraits) {}
 
   RadixTree(const RadixTree& r) = delete;
   RadixTree& operator=(const RadixTree& r) = delete;
@@ -407,15 +533,21 @@ class RadixTree {
   void clear() {
     root_.reset(nullptr);
     size_ = 0;
+    pool_->release();
   }
   RadixTree(RadixTree&& r) noexcept
-      : nodeDeleteCallback_(r.nodeDeleteCallback_), traits_(r.traits_) {
+      : pool_(std::make_unique<NodePool>(r.nodeDeleteCallback())),
+        traits_(r.traits_) {
     *this = std::move(r);
   }
   // Move radix tree onto this
   RadixTree& operator=(RadixTree&& r) noexcept {
-    // Don't copy the traits and delete callback, use
-    // ones with which this Radix tree was created
+    // Don't copy the traits, use ones with which this Radix tree was
+    // created. Nodes must go back to the pool they were allocated from, so
+    // the pools are swapped, and this tree takes on the delete callback of
+    // r along with its nodes.
+    clear();
+    std::swap(pool_, r.pool_);
     size_ = r.size_;
     makeRoot(std::move(r.root_));
     r.size_ = 0;
@@ -428,9 +560,10 @@ class RadixTree {
     static_assert(
         std::is_same<T, U>::value,
         "clone template type must be the same as Radix tree value type");
-    RadixTree copy(nodeDeleteCallback_, traits_);
+    RadixTree copy(nodeDeleteCallback(), traits_);
     copy.size_ = size_;
-    copy.root_ = cloneSubTree(root_.get());
+    copy.pool_->reserve(pool_->numNodes());
+    copy.root_ = copy.cloneSubTree(root_.get());
     return copy;
   }
   /*
@@ -583,14 +716,14 @@ class RadixTree {
     return root_.get();
   }
   NodeDeleteCallback nodeDeleteCallback() const {
-    return nodeDeleteCallback_;
+    return pool_->deleteCallback();
   }
   const TreeTraits& traits() const {
     return traits_;
   }
 
  private:
-  static std::unique_ptr<TreeNode> cloneSubTree(const TreeNode* node);
+  NodePtr cloneSubTree(const TreeNode* node);
   // Worker function to do the actual longest match lookup.
   const TreeNode* longestMatchImpl(
       const IPADDRTYPE& ipaddr,
@@ -611,18 +744,16 @@ class RadixTree {
             ipaddr, masklen, foundExact, includeNonValueNodes, trail));
   }
 
-  std::unique_ptr<TreeNode> makeNode(const IPADDRTYPE& ip, uint8_t masklen) {
-    return std::make_unique<TreeNode>(ip, masklen, nodeDeleteCallback_);
+  NodePtr makeNode(const IPADDRTYPE& ip, uint8_t masklen) {
+    return pool_->create(ip, masklen);
   }
 
   template <typename VALUE>
-  std::unique_ptr<TreeNode>
-  makeNode(const IPADDRTYPE& ip, uint8_t masklen, VALUE&& value) {
-    return std::make_unique<TreeNode>(
-        ip, masklen, std::forward<VALUE>(value), nodeDeleteCallback_);
+  NodePtr makeNode(const IPADDRTYPE& ip, uint8_t masklen, VALUE&& value) {
+    return pool_->create(ip, masklen, std::forward<VALUE>(value));
   }
 
-  void makeRoot(std::unique_ptr<TreeNode> newRoot) {
+  void makeRoot(NodePtr newRoot) {
     CHECK(root_ != newRoot || root_ == nullptr);
     if (newRoot) {
       newRoot->setParent(nullptr);
@@ -635,9 +766,10 @@ class RadixTree {
       bool includeNonValueNodes,
       const TreeNode* node) const;
 
-  std::unique_ptr<TreeNode> root_{nullptr};
+  // Declared ahead of root_, so that the nodes are destroyed first
+  std::unique_ptr<NodePool> pool_;
+  NodePtr root_{nullptr};
   size_t size_{0};
-  NodeDeleteCallback nodeDeleteCallback_;
   TreeTraits traits_;
 };
 
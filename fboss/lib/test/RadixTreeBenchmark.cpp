@@ -117,6 +117,29 @@ BENCHMARK_RELATIVE(RadixTreeLongestMatch4) {
   }
 }
 
+BENCHMARK(RadixTreeClone4) {
+  RadixTree<IPAddressV4, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupTree4(rtree);
+  }
+  auto copy = rtree.clone();
+  folly::doNotOptimizeAway(copy.size());
+}
+
+BENCHMARK(RadixTreeEraseInsert4) {
+  RadixTree<IPAddressV4, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupTree4(rtree);
+  }
+  // Nodes freed by erase are reused by the inserts that follow
+  for (auto pfx : eraseSet4) {
+    rtree.erase(pfx.ip, pfx.mask);
+  }
+  for (auto pfx : eraseSet4) {
+    rtree.insert(pfx.ip, pfx.mask, 0);
+  }
+}
+
 // V6 benchmarks
 
 template <typename TREE>
@@ -197,6 +220,29 @@ BENCHMARK_RELATIVE(RadixTreeLongestMatch6) {
   }
 }
 
+BENCHMARK(RadixTreeClone6) {
+  RadixTree<IPAddressV6, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupTree6(rtree);
+  }
+  auto copy = rtree.clone();
+  folly::doNotOptimizeAway(copy.size());
+}
+
+BENCHMARK(RadixTreeEraseInsert6) {
+  RadixTree<IPAddressV6, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupTree6(rtree);
+  }
+  // Nodes freed by erase are reused by the inserts that follow
+  for (auto pfx : eraseSet6) {
+    rtree.erase(pfx.ip, pfx.mask);
+  }
+  for (auto pfx : eraseSet6) {
+    rtree.insert(pfx.ip, pfx.mask, 0);
+  }
+}
+
 } // namespace
 
 int main(int /*argc*/, char* /*argv*/ []) {
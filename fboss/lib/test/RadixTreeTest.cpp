@@ -1379,6 +1379,40 @@ TEST(RadixTree, Clone) {
   EXPECT_TRUE(v6Tree == v6TreeCopy);
   EXPECT_TRUE(ipTree == ipTreeCopy);
 }
+
+TEST(RadixTree, NodeDeleteCallbackAcrossMoves) {
+  auto deleteCount = 0;
+  auto deleteCallback = [&](const RadixTreeNode<IPAddressV4, int>& /*node*/) {
+    ++deleteCount;
+  };
+  RadixTree<IPAddressV4, int> rtree(deleteCallback);
+  setupTestTree4(rtree);
+  auto numNodes = 0;
+  for (auto itr = RadixTree<IPAddressV4, int>::Iterator(rtree.root(), true);
+       !itr.atEnd();
+       ++itr) {
+    ++numNodes;
+  }
+
+  // Clones use the delete callback of the tree cloned
+  auto copy = rtree.clone();
+  EXPECT_TRUE(copy == rtree);
+  copy.clear();
+  EXPECT_EQ(numNodes, deleteCount);
+
+  // Nodes moved to another tree keep their delete callback, and memory
+  // freed by erase is reused by later inserts
+  deleteCount = 0;
+  RadixTree<IPAddressV4, int> moved;
+  moved = std::move(rtree);
+  EXPECT_EQ(0, rtree.size());
+  EXPECT_TRUE(moved.erase(ip128_0_0_0, 2));
+  EXPECT_TRUE(moved.insert(ip128_0_0_0, 2, 1).second);
+  auto expectedDeleteCount = deleteCount + numNodes;
+  moved.clear();
+  EXPECT_EQ(expectedDeleteCount, deleteCount);
+  EXPECT_EQ(nullptr, moved.root());
+}
 /*
  * Compare with py-radix
  * Insert a set of random prefixes on both py-radix and our radix tree
@@ -142,6 +142,15 @@ folly::EventBase* Minipack16QI2CBus::getEventBase(unsigned int module) {
                             ->getEventBase();
 }
 
+uint32_t Minipack16QI2CBus::getI2cControllerId(unsigned int module) {
+  return (getPim(module) - 1) * i2cControllers_[0].size() +
+      getI2cControllerIdx(getQsfpPimPort(module));
+}
+
+uint64_t Minipack16QI2CBus::getMuxPathKey(unsigned int module) {
+  return getI2cControllerChannel(getQsfpPimPort(module));
+}
+
 FbFpgaI2cController* Minipack16QI2CBus::getI2cController(
     uint8_t pim,
     uint8_t idx) const {
@@ -55,6 +55,10 @@ class Minipack16QI2CBus : public TransceiverI2CApi {
 
   folly::EventBase* getEventBase(unsigned int module) override;
 
+  // Each pim has four I2C controllers, each with four modules on its channels
+  uint32_t getI2cControllerId(unsigned int module) override;
+  uint64_t getMuxPathKey(unsigned int module) override;
+
  private:
   FbFpgaI2cController* getI2cController(uint8_t pim, uint8_t idx) const;
 
@@ -101,6 +101,19 @@ class PCA9548MuxedBus : public BaseWedgeI2CBus {
     return NUM_PORTS;
   }
 
+  /*
+   * Each mux on the path to the port contributes its address and the
+   * selected channel, root first, so ports sharing muxes share the high
+   * bits of their keys. Only valid once the bus is open.
+   */
+  uint64_t getMuxPathKey(unsigned int port) override {
+    uint64_t key = 0;
+    for (const auto* hop : calculatePath(port)) {
+      key = (key << 11) | (hop->mux->mux()->address() << 3) | hop->channel;
+    }
+    return key;
+  }
+
   void verifyBus(bool /* autoReset */) override {
     // Hacky bus verification for now that removes any assumptions
     // about what the currently selected path is. We should probably
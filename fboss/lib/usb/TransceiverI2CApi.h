@@ -95,6 +95,25 @@ class TransceiverI2CApi {
     return nullptr;
   };
 
+  /*
+   * Topology of the I2C bus, used to schedule accesses to many modules.
+   *
+   * getI2cControllerId() identifies the I2C controller (CP2112, FPGA I2C
+   * controller...) the module sits behind. Modules behind different
+   * controllers can be accessed in parallel, those behind the same one can
+   * not. Models with a single I2C bus have a single controller.
+   *
+   * getMuxPathKey() orders the modules behind one controller. Modules that
+   * sit behind the same muxes get close keys, so that accessing them in key
+   * order switches muxes as little as possible.
+   */
+  virtual uint32_t getI2cControllerId(unsigned int /* module */) {
+    return 0;
+  }
+  virtual uint64_t getMuxPathKey(unsigned int module) {
+    return module;
+  }
+
   /* Virtual function to count the i2c transactions in a platform. This
    * will be overridden by derived classes which are platform specific
    * and has the platform specific implementation for this counter
@@ -99,4 +99,14 @@ WedgeI2CBusLock::getI2cControllerStats() {
 folly::EventBase* WedgeI2CBusLock::getEventBase(unsigned int module) {
   return wedgeI2CBus_->getEventBase(module);
 }
+
+uint32_t WedgeI2CBusLock::getI2cControllerId(unsigned int module) {
+  return wedgeI2CBus_->getI2cControllerId(module);
+}
+
+uint64_t WedgeI2CBusLock::getMuxPathKey(unsigned int module) {
+  // The mux tree is only built when the bus is opened
+  BusGuard g(this);
+  return wedgeI2CBus_->getMuxPathKey(module);
+}
 }} // facebook::fboss
@@ -45,6 +45,8 @@ class WedgeI2CBusLock : public TransceiverI2CApi {
   getI2cControllerStats() override;
 
   folly::EventBase* getEventBase(unsigned int module) override;
+  uint32_t getI2cControllerId(unsigned int module) override;
+  uint64_t getMuxPathKey(unsigned int module) override;
 
  private:
   // Forbidden copy constructor and assignment operator
@@ -11,6 +11,9 @@
 #include <folly/gen/Base.h>
 #include <folly/logging/xlog.h>
 
+#include <algorithm>
+#include <chrono>
+
 namespace {
 
 constexpr int kSecAfterModuleOutOfReset = 2;
@@ -87,6 +90,7 @@ void WedgeManager::initTransceiverMap() {
     XLOG(ERR) << "failed to initialize I2C interface: " << ex.what();
     return;
   }
+  loadI2cTopology();
 
   // Initialize port status map for transceivers.
   for (int idx = 0; idx < getNumQsfpModules(); idx++) {
@@ -273,18 +277,130 @@ void WedgeManager::refreshTransceivers() {
   // transceiver mapping and type here.
   updateTransceiverMap();
 
-  std::vector<folly::Future<folly::Unit>> futs;
   XLOG(INFO) << "Start refreshing all transceivers...";
+  auto passStart = std::chrono::steady_clock::now();
 
   auto lockedTransceivers = transceivers_.rlock();
 
+  std::vector<TransceiverID> ids;
   for (const auto& transceiver : *lockedTransceivers) {
-    XLOG(DBG3) << "Fired to refresh transceiver " << transceiver.second->getID();
-    futs.push_back(transceiver.second->futureRefresh());
+    ids.push_back(transceiver.first);
   }
+  auto groups = getRefreshGroups(ids);
+
+  // What each group spent refreshing, filled in by whichever thread
+  // refreshes the group
+  struct GroupRefreshStats {
+    std::chrono::microseconds busy{0};
+    std::vector<std::pair<TransceiverID, std::chrono::microseconds>>
+        latencies;
+  };
+  std::vector<GroupRefreshStats> groupStats(groups.size());
+  auto refreshGroup = [&lockedTransceivers, &groups, &groupStats](size_t i) {
+    for (auto id : groups[i]) {
+      auto start = std::chrono::steady_clock::now();
+      auto& transceiver = lockedTransceivers->at(id);
+      XLOG(DBG3) << "Refreshing transceiver " << transceiver->getID();
+      try {
+        transceiver->refresh();
+      } catch (const std::exception& ex) {
+        XLOG(DBG2) << "Transceiver " << static_cast<int>(id)
+                   << ": Error calling refresh(): " << ex.what();
+      }
+      auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start);
+      groupStats[i].busy += latency;
+      groupStats[i].latencies.emplace_back(id, latency);
+    }
+  };
 
+  // Groups behind a controller with its own event base run there, in
+  // parallel with the others. The remaining groups share the calling thread,
+  // so they are refreshed once the others are under way.
+  std::vector<folly::Future<folly::Unit>> futs;
+  std::vector<size_t> inlineGroups;
+  for (size_t i = 0; i < groups.size(); ++i) {
+    auto evb =
+        wedgeI2cBus_->getEventBase(static_cast<int>(groups[i].front()) + 1);
+    if (!evb) {
+      inlineGroups.push_back(i);
+      continue;
+    }
+    futs.push_back(folly::via(evb).thenValue(
+        [&refreshGroup, i](auto&&) { refreshGroup(i); }));
+  }
+  for (auto i : inlineGroups) {
+    refreshGroup(i);
+  }
   folly::collectAll(futs.begin(), futs.end()).wait();
-  XLOG(INFO) << "Finished refreshing all transceivers";
+
+  auto passDuration = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - passStart);
+  for (size_t i = 0; i < groups.size(); ++i) {
+    auto controllerId = i2cTopology_.count(groups[i].front())
+        ? i2cTopology_.at(groups[i].front()).controllerId
+        : 0;
+    tcData().setCounter(
+        folly::to<std::string>(
+            "qsfp.i2c_controller", controllerId, ".refreshBusyPct"),
+        passDuration.count()
+            ? 100 * groupStats[i].busy.count() / passDuration.count()
+            : 0);
+    for (const auto& [id, latency] : groupStats[i].latencies) {
+      tcData().setCounter(
+          folly::to<std::string>(
+              "qsfp.transceiver", static_cast<int>(id), ".refreshLatencyUs"),
+          latency.count());
+    }
+  }
+  tcData().setCounter("qsfp.refreshDurationUs", passDuration.count());
+  XLOG(INFO) << "Finished refreshing all transceivers in "
+             << passDuration.count() << "us";
+}
+
+void WedgeManager::loadI2cTopology() {
+  i2cTopology_.clear();
+  for (int idx = 0; idx < getNumQsfpModules(); idx++) {
+    ModuleI2cTopology topology;
+    try {
+      topology.controllerId = wedgeI2cBus_->getI2cControllerId(idx + 1);
+      topology.muxPathKey = wedgeI2cBus_->getMuxPathKey(idx + 1);
+    } catch (const std::exception& ex) {
+      XLOG(ERR) << "Transceiver " << idx
+                << ": Error getting I2C topology: " << ex.what();
+      topology.muxPathKey = idx;
+    }
+    i2cTopology_.emplace(TransceiverID(idx), topology);
+  }
+}
+
+std::vector<std::vector<TransceiverID>> WedgeManager::getRefreshGroups(
+    const std::vector<TransceiverID>& ids) const {
+  // Modules with unknown topology are ordered by id behind controller 0
+  auto topologyOf = [this](TransceiverID id) {
+    if (auto it = i2cTopology_.find(id); it != i2cTopology_.end()) {
+      return it->second;
+    }
+    return ModuleI2cTopology{0, static_cast<uint64_t>(id)};
+  };
+
+  std::map<uint32_t, std::vector<std::pair<uint64_t, TransceiverID>>>
+      controllerToModules;
+  for (auto id : ids) {
+    auto topology = topologyOf(id);
+    controllerToModules[topology.controllerId].emplace_back(
+        topology.muxPathKey, id);
+  }
+
+  std::vector<std::vector<TransceiverID>> groups;
+  for (auto& [controllerId, modules] : controllerToModules) {
+    std::sort(modules.begin(), modules.end());
+    groups.emplace_back();
+    for (const auto& module : modules) {
+      groups.back().push_back(module.second);
+    }
+  }
+  return groups;
 }
 
 int WedgeManager::scanTransceiverPresence(
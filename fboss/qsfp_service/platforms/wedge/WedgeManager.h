@@ -77,6 +77,20 @@ class WedgeManager : public TransceiverManager {
  protected:
   virtual std::unique_ptr<TransceiverI2CApi> getI2CBus();
   void updateTransceiverMap();
+
+  /*
+   * Read the I2C topology of all modules from wedgeI2cBus_, so that
+   * getRefreshGroups() does not need to access the bus.
+   */
+  void loadI2cTopology();
+
+  /*
+   * Split the transceivers into one group per I2C controller, each sorted in
+   * mux path order. Groups can be refreshed in parallel, the transceivers of
+   * a group have to be refreshed one after the other.
+   */
+  std::vector<std::vector<TransceiverID>> getRefreshGroups(
+      const std::vector<TransceiverID>& ids) const;
   std::unique_ptr<TransceiverI2CApi>
       wedgeI2cBus_; /* thread safe handle to access bus */
 
@@ -90,6 +104,12 @@ class WedgeManager : public TransceiverManager {
 
   PlatformMode platformMode_;
 
+  struct ModuleI2cTopology {
+    uint32_t controllerId{0};
+    uint64_t muxPathKey{0};
+  };
+  std::map<TransceiverID, ModuleI2cTopology> i2cTopology_;
+
  private:
   void loadConfig() override;
   // Forbidden copy constructor and assignment operator
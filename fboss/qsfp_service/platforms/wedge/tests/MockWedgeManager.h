@@ -21,6 +21,13 @@ class MockWedgeManager : public WedgeManager {
     }
   }
 
+  void setI2cBus(std::unique_ptr<TransceiverI2CApi> bus) {
+    wedgeI2cBus_ = std::move(bus);
+    loadI2cTopology();
+  }
+
+  using WedgeManager::getRefreshGroups;
+
   PlatformMode getPlatformMode() override {
       return PlatformMode::WEDGE;
   }
@@ -51,4 +51,53 @@ TEST_F(WedgeManagerTest, getTransceiverInfo) {
       std::make_unique<std::vector<int32_t>>(data));
 }
 
+/*
+ * A bus with four modules per I2C controller, wired to the mux channels of
+ * each controller in reverse order.
+ */
+class FakeI2cBus : public TransceiverI2CApi {
+ public:
+  void open() override {}
+  void close() override {}
+  void moduleRead(unsigned int, uint8_t, int, int, uint8_t*) override {}
+  void moduleWrite(unsigned int, uint8_t, int, int, const uint8_t*) override {}
+  void verifyBus(bool) override {}
+  bool isPresent(unsigned int) override {
+    return true;
+  }
+  void scanPresence(std::map<int32_t, ModulePresence>&) override {}
+
+  uint32_t getI2cControllerId(unsigned int module) override {
+    return (module - 1) / 4;
+  }
+  uint64_t getMuxPathKey(unsigned int module) override {
+    return 3 - (module - 1) % 4;
+  }
+};
+
+TEST_F(WedgeManagerTest, getRefreshGroups) {
+  wedgeManager_->setI2cBus(std::make_unique<FakeI2cBus>());
+
+  std::vector<TransceiverID> ids;
+  for (int i = 0; i < wedgeManager_->getNumQsfpModules(); ++i) {
+    ids.push_back(TransceiverID(i));
+  }
+  auto groups = wedgeManager_->getRefreshGroups(ids);
+  ASSERT_EQ(4, groups.size());
+  for (int controller = 0; controller < groups.size(); ++controller) {
+    std::vector<TransceiverID> expected;
+    for (int i = 3; i >= 0; --i) {
+      expected.push_back(TransceiverID(controller * 4 + i));
+    }
+    EXPECT_EQ(expected, groups[controller]);
+  }
+
+  // Only the requested transceivers are scheduled
+  groups =
+      wedgeManager_->getRefreshGroups({TransceiverID(1), TransceiverID(9)});
+  ASSERT_EQ(2, groups.size());
+  EXPECT_EQ(std::vector<TransceiverID>{TransceiverID(1)}, groups[0]);
+  EXPECT_EQ(std::vector<TransceiverID>{TransceiverID(9)}, groups[1]);
+}
+
 }